@@ -0,0 +1,62 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bench/Bench.hpp>
+#include <IO/Fmt.hpp>
+#include <algorithm>
+BEGIN_NAMESPACE(n19::bench);
+
+auto registered() -> std::vector<Benchmark>& {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+auto add(const Function fn, const sys::StringView& group, const sys::StringView& name) -> bool {
+  registered().emplace_back(Benchmark{fn, sys::String(group), sys::String(name)});
+  return true;
+}
+
+static auto report_(OStream& stream, const Benchmark& bench, const State& state) -> void {
+  constexpr size_t name_width = 40;
+  const size_t name_size = bench.group_.size() + 1 + bench.name_.size();
+  stream << bench.group_ << "/" << bench.name_;
+  stream << std::string(name_size < name_width ? name_width - name_size : 1, ' ');
+  stream << fmt("{:>12.1f} ns", state.ns_per_call_);
+
+  const double seconds = state.ns_per_call_ / 1e9;
+  if(state.bytes_ != 0 && seconds > 0) {
+    stream << fmt("{:>12.1f} MB/s", static_cast<double>(state.bytes_) / seconds / 1e6);
+  } if(state.items_ != 0 && seconds > 0) {
+    stream << fmt("{:>12.2f} M items/s", static_cast<double>(state.items_) / seconds / 1e6);
+  }
+
+  for(const auto& [name, value] : state.counters_) {
+    stream << fmt("  {}={:.2f}", name, value);
+  }
+
+  stream << Endl;
+}
+
+auto run_all(
+  OStream& stream,
+  const std::vector<sys::String>& groups,
+  const std::chrono::nanoseconds min_time ) -> void
+{
+  auto benchmarks = registered();
+  std::ranges::stable_sort(benchmarks, {}, &Benchmark::group_);
+
+  for(const auto& bench : benchmarks) {
+    if(!groups.empty() && std::ranges::find(groups, bench.group_) == groups.end()) {
+      continue;
+    }
+
+    State state;
+    state.min_time_ = min_time;
+    bench.fn_(state);
+    report_(stream, bench, state);
+  }
+}
+
+END_NAMESPACE(n19::bench);
@@ -0,0 +1,123 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_BENCH_HPP
+#define N19_BENCH_HPP
+#include <Misc/Macros.hpp>
+#include <Core/Platform.hpp>
+#include <IO/Stream.hpp>
+#include <Sys/String.hpp>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Micro benchmarks, run by the n19-bench executable. Each one is a
+// function registered under a group, which does its setup and then
+// hands the code to be timed to state.measure():
+//
+//   BENCHMARK(Lexer, Identifiers) {
+//     auto lxr = ...;
+//     state.set_bytes(source.size());
+//     state.measure([&] { ... });
+//   }
+//
+// Results go to stdout as one line per benchmark. Nothing here
+// is a pass or fail: regressions are for people to look at.
+
+#define BENCHMARK_FUNC_(GROUP, NAME) n19_bench_##GROUP##_##NAME##_
+
+#define BENCHMARK(GROUP, NAME)                                                              \
+  static auto BENCHMARK_FUNC_(GROUP, NAME)(::n19::bench::State& state) -> void;             \
+  static const bool N19_UNIQUE_NAME(n19_bench_registered_) = ::n19::bench::add(             \
+    BENCHMARK_FUNC_(GROUP, NAME), _nstr(#GROUP), _nstr(#NAME));                             \
+  static auto BENCHMARK_FUNC_(GROUP, NAME)([[maybe_unused]] ::n19::bench::State& state) -> void
+
+BEGIN_NAMESPACE(n19::bench);
+
+class State {
+public:
+  ///
+  /// Calls body() in batches, doubling the batch until one takes
+  /// at least min_time_, then keeps the fastest of a few batches
+  /// of that size. Call it once per benchmark.
+  template<typename F>
+  auto measure(F&& body) -> void;
+
+  /// Per call of the body. Turned into MB/s and items/s.
+  auto set_bytes(const uint64_t bytes) -> void { bytes_ = bytes; }
+  auto set_items(const uint64_t items) -> void { items_ = items; }
+
+  /// Anything else worth reporting, per call of the body.
+  auto counter(std::string name, const double value) -> void {
+    counters_.emplace_back(std::move(name), value);
+  }
+
+  std::chrono::nanoseconds min_time_{std::chrono::milliseconds(200)};
+  double ns_per_call_ = 0.0;
+  uint64_t calls_ = 0;
+  uint64_t bytes_ = 0;
+  uint64_t items_ = 0;
+  std::vector<std::pair<std::string, double>> counters_;
+};
+
+using Function = void(*)(State&);
+
+struct Benchmark {
+  Function fn_;
+  sys::String group_;
+  sys::String name_;
+};
+
+auto add(Function fn, const sys::StringView& group, const sys::StringView& name) -> bool;
+auto registered() -> std::vector<Benchmark>&;
+
+/// Runs every benchmark whose group is in "groups", or all of them.
+auto run_all(OStream& stream, const std::vector<sys::String>& groups, std::chrono::nanoseconds min_time) -> void;
+
+///
+/// Makes the optimizer assume the value is used, so
+/// that the work producing it isn't thrown away.
+template<typename T>
+FORCEINLINE_ auto keep(T&& value) -> void {
+#if defined(_MSC_VER) && !defined(__clang__)
+  static const void* volatile sink;
+  sink = &value;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename F>
+auto State::measure(F&& body) -> void {
+  using Clock = std::chrono::steady_clock;
+  const auto time_batch = [&](const uint64_t count) {
+    const auto begin = Clock::now();
+    for(uint64_t i = 0; i < count; i++) body();
+    return Clock::now() - begin;
+  };
+
+  uint64_t batch = 1;
+  auto elapsed = time_batch(batch);
+  while(elapsed < min_time_ && batch < (uint64_t{1} << 40)) {
+    batch *= 2;
+    elapsed = time_batch(batch);
+  }
+
+  for(int i = 0; i < 2; i++) {
+    elapsed = std::min(elapsed, time_batch(batch));
+  }
+
+  calls_ = batch;
+  ns_per_call_ = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(batch);
+}
+
+END_NAMESPACE(n19::bench);
+#endif //N19_BENCH_HPP
@@ -0,0 +1,107 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bench/Bench.hpp>
+#include <Frontend/AstVisitor.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <string>
+using namespace n19;
+
+static auto make_ref(const std::string& name) -> AstNode::Ptr<> {
+  auto ref   = AstNode::create<AstEntityRefThunk>(0, 1);
+  ref->name_ = name;
+  return ref;
+}
+
+/// a + (a + (a + ...)), "depth" additions deep.
+static auto make_sum(const size_t depth) -> AstNode::Ptr<> {
+  if(depth == 0) return make_ref("a");
+  auto bin      = AstNode::create<AstBinExpr>(0, 1);
+  bin->op_type_ = TokenType::Plus;
+  bin->left_    = make_ref("a");
+  bin->right_   = make_sum(depth - 1);
+  return bin;
+}
+
+/// A namespace of procedures, each returning
+/// a sum and making a call: ~40k nodes in all.
+static auto make_tree() -> AstNode::Ptr<> {
+  auto root = AstNode::create<AstNamespace>(0, 1);
+  for(size_t i = 0; i < 1000; i++) {
+    auto proc   = AstNode::create<AstProcDecl>(0, 1);
+    proc->name_ = make_ref("f" + std::to_string(i));
+
+    auto ret    = AstNode::create<AstReturn>(0, 1);
+    ret->value_ = make_sum(16);
+    proc->body_.emplace_back(std::move(ret));
+
+    auto call     = AstNode::create<AstCall>(0, 1);
+    call->target_ = make_ref("g");
+    call->arguments_.emplace_back(make_sum(2));
+    proc->body_.emplace_back(std::move(call));
+    root->body_.emplace_back(std::move(proc));
+  }
+
+  return root;
+}
+
+struct CrtpCounter : AstVisitor<CrtpCounter> {
+  auto enter(AstBinExpr&) -> void { ++exprs_; }
+  auto enter(AstCall&) -> void { ++calls_; }
+  auto enter(AstNode&) -> void { ++others_; }
+  size_t exprs_ = 0, calls_ = 0, others_ = 0;
+};
+
+///
+/// What a pass looks like without AstVisitor: a base
+/// class with a virtual hook per node type, and one
+/// walker calling through it for every node.
+class VirtualVisitor {
+public:
+  #define ASTNODE_X(NAME) virtual auto visit(Ast##NAME&) -> void {}
+  N19_ASTNODE_TYPE_LIST
+  #undef ASTNODE_X
+
+  auto walk(AstNode& node) -> void {
+    switch(node.type_) {
+    #define ASTNODE_X(NAME) case AstNode::Type::NAME: visit(static_cast<Ast##NAME&>(node)); break;
+    N19_ASTNODE_TYPE_LIST
+    #undef ASTNODE_X
+    default: break;
+    }
+
+    ast_for_each_child(node, [this](AstNode* child, AstNode::Ptr<>*) { walk(*child); });
+  }
+
+  virtual ~VirtualVisitor() = default;
+};
+
+class VirtualCounter final : public VirtualVisitor {
+public:
+  using VirtualVisitor::visit;
+  auto visit(AstBinExpr&) -> void override { ++exprs_; }
+  auto visit(AstCall&) -> void override { ++calls_; }
+  size_t exprs_ = 0, calls_ = 0;
+};
+
+BENCHMARK(AstVisitor, Crtp) {
+  auto tree = make_tree();
+  state.set_items(ast_size(*tree));
+  state.measure([&] {
+    CrtpCounter counter;
+    counter.traverse(*tree);
+    bench::keep(counter.exprs_ + counter.calls_ + counter.others_);
+  });
+}
+
+BENCHMARK(AstVisitor, Virtual) {
+  auto tree = make_tree();
+  state.set_items(ast_size(*tree));
+  state.measure([&] {
+    VirtualCounter counter;
+    counter.walk(*tree);
+    bench::keep(counter.exprs_ + counter.calls_);
+  });
+}
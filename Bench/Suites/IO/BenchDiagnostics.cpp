@@ -0,0 +1,65 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bench/Bench.hpp>
+#include <Bench/Suites/IO/Targets.hpp>
+#include <Frontend/ErrorCollector.hpp>
+#include <IO/Stream.hpp>
+#include <string>
+#include <vector>
+using namespace n19;
+using bench::io::Target;
+
+/// A few hundred lines of source, with
+/// the error pointed at somewhere in the middle.
+static auto make_source_() -> std::vector<char8_t> {
+  std::vector<char8_t> out;
+  for(size_t i = 0; i < 400; i++) {
+    const std::string line = "let value_" + std::to_string(i) + " : i32 = other + 17;\n";
+    out.insert(out.end(), line.begin(), line.end());
+  }
+
+  return out;
+}
+
+static auto display_bench_(bench::State& state, const Target target) -> void {
+  const auto source = make_source_();
+  const size_t line = 200;
+  size_t pos = 0;
+  for(size_t seen = 1; seen < line; pos++) {
+    if(source[pos] == u8'\n') ++seen;
+  }
+
+  const auto render = [&](OStream& stream) {
+    ErrorCollector::display_error(
+      "expected a type here.",
+      _nstr("bench.n19"),
+      source,
+      stream,
+      pos + 11,
+      line);
+  };
+
+  StringOStream probe;
+  render(probe);
+  const uint64_t bytes = probe.str_.size();
+
+  bench::io::Sink sink(target);
+  auto stream = BufferedOStream<>::from(sink.device());
+  const auto body = [&] {
+    render(stream);
+    stream.flush();
+    sink.rewind();
+  };
+
+  state.set_bytes(bytes);
+  state.set_items(1);
+  state.measure(body);
+  bench::io::count_syscalls(state, bytes, body);
+}
+
+BENCHMARK(Diagnostics, DisplayError_Pipe)     { display_bench_(state, Target::Pipe); }
+BENCHMARK(Diagnostics, DisplayError_Null)     { display_bench_(state, Target::Null); }
+BENCHMARK(Diagnostics, DisplayError_TempFile) { display_bench_(state, Target::TempFile); }
@@ -0,0 +1,61 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bench/Bench.hpp>
+#include <Bench/Suites/IO/Targets.hpp>
+#include <Sys/File.hpp>
+#include <vector>
+using namespace n19;
+using bench::io::Target;
+
+/// Bytes moved per call, whatever the buffer size.
+static constexpr size_t total_bytes_ = 4 * 1024 * 1024;
+
+static auto write_bench_(bench::State& state, const Target target, const size_t buffer_size) -> void {
+  const std::vector<Byte> buffer(buffer_size, Byte{'x'});
+  bench::io::Sink sink(target);
+
+  const auto body = [&] {
+    for(size_t done = 0; done < total_bytes_; done += buffer_size) {
+      bench::keep(sink.device().write(buffer).has_value());
+    }
+
+    sink.rewind();
+  };
+
+  state.set_bytes(total_bytes_);
+  state.measure(body);
+  bench::io::count_syscalls(state, total_bytes_, body);
+}
+
+static auto read_bench_(bench::State& state, const size_t buffer_size) -> void {
+  const bench::io::Source source(total_bytes_);
+  std::vector<Byte> buffer(buffer_size);
+  auto file = source.open();
+
+  const auto body = [&] {
+    file.seek(0, sys::FSeek::Beg);
+    for(size_t done = 0; done < source.size_; done += buffer_size) {
+      auto view = WritableBytes{buffer};
+      bench::keep(file.read_into(view).has_value());
+    }
+  };
+
+  state.set_bytes(source.size_);
+  state.measure(body);
+  bench::io::count_syscalls(state, source.size_, body);
+  file.close();
+}
+
+#define FILE_BENCHMARKS_(SIZE, BYTES)                                                       \
+  BENCHMARK(File, Write_##SIZE##_Pipe)     { write_bench_(state, Target::Pipe, BYTES); }      \
+  BENCHMARK(File, Write_##SIZE##_Null)     { write_bench_(state, Target::Null, BYTES); }      \
+  BENCHMARK(File, Write_##SIZE##_TempFile) { write_bench_(state, Target::TempFile, BYTES); }  \
+  BENCHMARK(File, Read_##SIZE)             { read_bench_(state, BYTES); }
+
+FILE_BENCHMARKS_(512, 512)
+FILE_BENCHMARKS_(4K,  4 * 1024)
+FILE_BENCHMARKS_(64K, 64 * 1024)
+FILE_BENCHMARKS_(1M,  1024 * 1024)
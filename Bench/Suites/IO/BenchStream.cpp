@@ -0,0 +1,142 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bench/Bench.hpp>
+#include <Bench/Suites/IO/Targets.hpp>
+#include <IO/Stream.hpp>
+#include <IO/Console.hpp>
+#include <string>
+#include <vector>
+
+#if defined(N19_POSIX)
+#include <unistd.h>
+#endif
+
+using namespace n19;
+using bench::io::Target;
+
+/// Each workload writes roughly 64 KB per call.
+static auto small_writes_(OStream& stream) -> void {
+  for(size_t i = 0; i < 8192; i++) stream << "abcdefg\n";
+}
+
+static auto integers_(OStream& stream) -> void {
+  for(int64_t i = 0; i < 8192; i++) stream << i * 7919 << ' ';
+}
+
+static auto colours_(OStream& stream) -> void {
+  for(size_t i = 0; i < 2048; i++) {
+    stream << Con::RedFG << Con::Bold << "error" << Con::Reset << ": x\n";
+  }
+}
+
+static auto large_spans_(OStream& stream) -> void {
+  static const std::vector<Byte> span(16 * 1024, Byte{'x'});
+  for(size_t i = 0; i < 4; i++) stream.write(span);
+}
+
+///
+/// Runs one workload against one target, through an unbuffered
+/// OStream or a BufferedOStream, and flushes after every call
+/// the way a dump or a diagnostic would.
+template<typename Workload>
+static auto write_bench_(
+  bench::State& state,
+  const Target target,
+  const bool buffered,
+  Workload&& workload ) -> void
+{
+  StringOStream probe;
+  workload(probe);
+  const uint64_t bytes = probe.str_.size();
+
+  bench::io::Sink sink(target);
+  auto unbuffered = OStream::from(sink.device());
+  auto buffer     = BufferedOStream<>::from(sink.device());
+  OStream& stream = buffered ? static_cast<OStream&>(buffer) : unbuffered;
+
+  const auto body = [&] {
+    workload(stream);
+    stream.flush();
+    sink.rewind();
+  };
+
+  state.set_bytes(bytes);
+  state.measure(body);
+  bench::io::count_syscalls(state, bytes, body);
+}
+
+#define WRITE_BENCHMARKS_(NAME, BUFFERED, WORKLOAD)                                                   \
+  BENCHMARK(OStream, NAME##_Pipe)     { write_bench_(state, Target::Pipe, BUFFERED, WORKLOAD); }      \
+  BENCHMARK(OStream, NAME##_Null)     { write_bench_(state, Target::Null, BUFFERED, WORKLOAD); }      \
+  BENCHMARK(OStream, NAME##_TempFile) { write_bench_(state, Target::TempFile, BUFFERED, WORKLOAD); }
+
+WRITE_BENCHMARKS_(SmallWrites,         false, small_writes_)
+WRITE_BENCHMARKS_(BufferedSmallWrites, true,  small_writes_)
+WRITE_BENCHMARKS_(BufferedIntegers,    true,  integers_)
+WRITE_BENCHMARKS_(BufferedColours,     true,  colours_)
+WRITE_BENCHMARKS_(BufferedLargeSpans,  true,  large_spans_)
+
+#if defined(N19_POSIX)
+
+///
+/// The ceiling: the same 64 KB as one write(2),
+/// with nothing in between.
+static auto raw_write_(bench::State& state, const Target target) -> void {
+  static const std::vector<Byte> span(64 * 1024, Byte{'x'});
+  bench::io::Sink sink(target);
+  const int fd = sink.device().value();
+
+  const auto body = [&] {
+    bench::keep(::write(fd, span.data(), span.size()));
+    sink.rewind();
+  };
+
+  state.set_bytes(span.size());
+  state.measure(body);
+  bench::io::count_syscalls(state, span.size(), body);
+}
+
+BENCHMARK(OStream, RawWrite_Pipe)     { raw_write_(state, Target::Pipe); }
+BENCHMARK(OStream, RawWrite_Null)     { raw_write_(state, Target::Null); }
+BENCHMARK(OStream, RawWrite_TempFile) { raw_write_(state, Target::TempFile); }
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///
+/// IStream reads a byte per system call, so these run
+/// over a small file: the point is the per-byte cost.
+template<typename Read>
+static auto read_bench_(bench::State& state, Read&& read) -> void {
+  const bench::io::Source source(64 * 1024);
+  auto file = source.open();
+
+  const auto body = [&] {
+    file.seek(0, sys::FSeek::Beg);
+    auto stream = IStream::from(file);
+    std::string out;
+    size_t consumed = 0;
+    while(consumed < source.size_) {
+      consumed += read(stream, out) + 1;
+    }
+
+    bench::keep(consumed);
+  };
+
+  state.set_bytes(source.size_);
+  state.measure(body);
+  bench::io::count_syscalls(state, source.size_, body);
+  file.close();
+}
+
+BENCHMARK(IStream, Words) {
+  read_bench_(state, [](IStream& stream, std::string& out) { return stream.readword(out); });
+}
+
+BENCHMARK(IStream, Lines) {
+  read_bench_(state, [](IStream& stream, std::string& out) { return stream.readln(out); });
+}
@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bench/Suites/IO/Targets.hpp>
+#include <Core/Panic.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+BEGIN_NAMESPACE(n19::bench::io);
+
+static auto temp_path_() -> std::filesystem::path {
+  static std::atomic<uint32_t> counter = 0;
+  const auto name = "n19-bench-" + std::to_string(counter.fetch_add(1)) + ".tmp";
+  return std::filesystem::temp_directory_path() / name;
+}
+
+#if defined(N19_WIN32)
+#define N19_NULL_DEVICE_ L"NUL"
+#else
+#define N19_NULL_DEVICE_ "/dev/null"
+#endif
+
+Sink::Sink(const Target target) : target_(target) {
+  write_.invalidate();
+  read_.invalidate();
+  file_.invalidate();
+
+  switch(target_) {
+  case Target::Pipe: {
+    auto pipe = sys::IODevice::create_pipe();
+    if(!pipe) PANIC("Sink: could not create a pipe.");
+    read_  = (*pipe)[0];
+    write_ = (*pipe)[1];
+    drain_ = std::thread([this] {
+      std::vector<Byte> buffer(64 * 1024);
+      while(!done_.load(std::memory_order_acquire)) {
+        auto view = WritableBytes{buffer.data(), buffer.size()};
+        if(!read_.read_into(view)) break;
+      }
+    });
+    break;
+  }
+  case Target::Null: {
+    auto file = sys::File::open(N19_NULL_DEVICE_, false, sys::IODevice::Write);
+    if(!file) PANIC("Sink: could not open the null device.");
+    file_  = *file;
+    write_ = file_;
+    break;
+  }
+  case Target::TempFile: {
+    path_ = temp_path_();
+    auto file = sys::File::create_trunc(path_.native());
+    if(!file) PANIC("Sink: could not create a temp file.");
+    file_  = *file;
+    write_ = file_;
+    break;
+  }
+  default: UNREACHABLE_ASSERTION;
+  }
+}
+
+Sink::~Sink() {
+  /// Closing the write end wakes the drain thread
+  /// with EOF, after it has seen done_.
+  done_.store(true, std::memory_order_release);
+  if(target_ == Target::Pipe) {
+    write_.close();
+    drain_.join();
+    read_.close();
+  } else {
+    file_.close();
+  }
+
+  if(!path_.empty()) {
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+  }
+}
+
+auto Sink::rewind() -> void {
+  if(target_ == Target::TempFile) {
+    file_.seek(0, sys::FSeek::Beg);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Source::Source(const size_t size) : size_(size), path_(temp_path_()) {
+  std::ofstream out(path_, std::ios::binary);
+  std::string line;
+  size_t written = 0;
+  for(size_t i = 0; written < size_; i++) {
+    line = "let value_" + std::to_string(i) + " : i32 = other_" + std::to_string(i % 97) + " + 17;\n";
+    out << line;
+    written += line.size();
+  }
+
+  size_ = written;
+}
+
+Source::~Source() {
+  std::error_code ec;
+  std::filesystem::remove(path_, ec);
+}
+
+auto Source::open() const -> sys::File {
+  auto file = sys::File::open(path_.native(), false, sys::IODevice::Read);
+  if(!file) PANIC("Source: could not open the temp file.");
+  return *file;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(N19_LINUX)
+
+auto thread_syscalls() -> Maybe<uint64_t> {
+  std::ifstream in("/proc/thread-self/io");
+  std::string key;
+  uint64_t value = 0, total = 0;
+  bool found = false;
+
+  while(in >> key >> value) {
+    if(key == "syscr:" || key == "syscw:") {
+      total += value;
+      found  = true;
+    }
+  }
+
+  if(!found) return Nothing;
+  return total;
+}
+
+#else
+
+auto thread_syscalls() -> Maybe<uint64_t> {
+  return Nothing;
+}
+
+#endif
+
+END_NAMESPACE(n19::bench::io);
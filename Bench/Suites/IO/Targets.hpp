@@ -0,0 +1,100 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_BENCH_IO_TARGETS_HPP
+#define N19_BENCH_IO_TARGETS_HPP
+#include <Bench/Bench.hpp>
+#include <Sys/IODevice.hpp>
+#include <Sys/File.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Maybe.hpp>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Shared by the I/O benchmarks: somewhere to write to, and a
+// way of counting what it cost in system calls.
+//
+// Every write benchmark runs once per Target. Pipes are drained
+// by a thread so the writer never blocks on a full pipe, and temp
+// files are rewound each call so they don't grow without bound.
+
+BEGIN_NAMESPACE(n19::bench::io);
+
+enum class Target : uint8_t {
+  Pipe,
+  Null,
+  TempFile,
+};
+
+class Sink {
+  N19_MAKE_NONCOPYABLE(Sink);
+  N19_MAKE_NONMOVABLE(Sink);
+public:
+  /// The device to write to.
+  auto device() -> sys::IODevice& { return write_; }
+
+  /// Call once per benchmark call, after flushing.
+  auto rewind() -> void;
+
+  explicit Sink(Target target);
+ ~Sink();
+private:
+  Target target_;
+  sys::IODevice write_;
+  sys::IODevice read_;
+  sys::File file_;
+  std::thread drain_;
+  std::atomic<bool> done_ = false;
+  std::filesystem::path path_;
+};
+
+///
+/// A temp file filled with "size" bytes of source-like text,
+/// lines of words, for the read benchmarks. Removed on exit.
+class Source {
+  N19_MAKE_NONCOPYABLE(Source);
+  N19_MAKE_NONMOVABLE(Source);
+public:
+  /// Opens a fresh read handle at the start of the file.
+  auto open() const -> sys::File;
+
+  explicit Source(size_t size);
+ ~Source();
+
+  size_t size_ = 0;
+  std::filesystem::path path_;
+};
+
+/// read(2) plus write(2)-style calls made by this thread so far.
+/// Linux only, through /proc/thread-self/io; Nothing elsewhere.
+auto thread_syscalls() -> Maybe<uint64_t>;
+
+///
+/// Runs body() until at least 16 MB have gone through it, and
+/// reports how many system calls that took per MB. Call it after
+/// state.measure(), with the bytes each call of body() moves.
+template<typename F>
+auto count_syscalls(State& state, const uint64_t bytes_per_call, F&& body) -> void {
+  constexpr uint64_t total = uint64_t{16} << 20;
+  const auto before = thread_syscalls();
+  if(!before.has_value() || bytes_per_call == 0) return;
+
+  uint64_t moved = 0;
+  while(moved < total) {
+    body();
+    moved += bytes_per_call;
+  }
+
+  const auto after = thread_syscalls();
+  if(!after.has_value()) return;
+  const double mb = static_cast<double>(moved) / 1e6;
+  state.counter("syscalls/MB", static_cast<double>(*after - *before) / mb);
+}
+
+END_NAMESPACE(n19::bench::io);
+#endif //N19_BENCH_IO_TARGETS_HPP
@@ -8,7 +8,10 @@
 #include <Sys/String.hpp>
 #include <Core/Platform.hpp>
 #include <Core/ArgParse.hpp>
+#include <Bulwark/ReportWriter.hpp>
 #include <vector>
+#include <memory>
+#include <chrono>
 #include <cstdint>
 #include <algorithm>
 #include <type_traits>
@@ -43,9 +46,16 @@ public:
     return ctx_;          /// maybe just make this a static global?
   }
 
+  FORCEINLINE_ auto for_each_writer(auto&& cb) -> void {
+    for(auto& writer : writers_) cb(*writer);
+  }
+
   std::underlying_type_t<Flags> flags_ = None;
   argp::PackType suites_to_run_;
   argp::PackType suites_to_skip_;
+  std::vector<std::unique_ptr<ReportWriter>> writers_;
+  std::chrono::milliseconds timeout_{0};  /// Per-case timeout, zero if disabled.
+  size_t report_slowest_ = 0;             /// How many of the slowest cases to list.
 private:
   Context() = default;
 };
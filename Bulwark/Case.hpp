@@ -10,6 +10,7 @@
 #include <string_view>
 #include <string>
 #include <functional>
+#include <chrono>
 #include <cstdint>
 BEGIN_NAMESPACE(n19::test);
 
@@ -52,7 +53,10 @@ public:
   }
                          ///
   FuncType_ fn_;         /// Don't call this invocable object directly. Use operator().
-  NameType_ name_;
+  NameType_ name_;       ///
+  Result result_;        /// Result of the last run, filled in by Suite::run_all().
+  bool timed_out_{};     /// Whether the last run went over the per-case timeout.
+  std::chrono::nanoseconds elapsed_{};
 
  ~Case() = default;
   Case(const FuncType_& fn, const NameType_ &name) : fn_(fn), name_(name) {}
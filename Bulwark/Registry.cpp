@@ -7,7 +7,9 @@
 #include <Bulwark/Reporting.hpp>
 #include <Bulwark/BulwarkContext.hpp>
 #include <Core/Panic.hpp>
+#include <IO/Fmt.hpp>
 #include <algorithm>
+#include <vector>
 BEGIN_NAMESPACE(n19::test);
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +75,34 @@ auto Registry::run_all(OStream &stream) -> void {
   stream << "  "  << g_total_failed  << " failed,\n";
   stream << "  "  << g_total_exc     << " interrupted by exceptions,\n";
   stream << "  "  << g_total_skipped << " skipped.\n";
+
+  if(Context::the().report_slowest_ > 0) {
+    report_slowest_(stream, Context::the().report_slowest_);
+  }
+
+  Context::the().for_each_writer([](ReportWriter& w) {
+    w.finish();
+  });
+}
+
+auto Registry::report_slowest_(OStream& stream, const size_t count) -> void {
+  std::vector<const Case*> ran;
+  for(const Suite& suite : *suites_) {
+    for(const Case& c : suite.cases_) {
+      if(c.elapsed_.count() > 0) ran.emplace_back(&c);
+    }
+  }
+
+  const size_t amnt = std::min(count, ran.size());
+  std::ranges::partial_sort(ran, ran.begin() + amnt, [](const Case* a, const Case* b) {
+    return a->elapsed_ > b->elapsed_;
+  });
+
+  stream << "\nSlowest " << amnt << " cases:\n";
+  for(size_t i = 0; i < amnt; i++) {
+    const auto ms = std::chrono::duration<double, std::milli>(ran[i]->elapsed_).count();
+    stream << "  " << fmt("{:>10.3f}ms  ", ms) << *ran[i] << "\n";
+  }
 }
 
 auto Registry::find(const sys::StringView& sv) -> Suite* {
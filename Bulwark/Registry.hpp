@@ -38,6 +38,8 @@ public:
 
   constexpr Registry() = default;
   ~Registry() = default;
+private:
+  auto report_slowest_(OStream& stream, size_t count) -> void;
 };
 
 constinit extern Registry g_registry;
@@ -0,0 +1,140 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/ReportWriter.hpp>
+#include <Core/Try.hpp>
+#include <IO/Fmt.hpp>
+#include <chrono>
+#include <utility>
+BEGIN_NAMESPACE(n19::test);
+
+///
+/// Suite and case names are produced by stringizing C++ identifiers
+/// inside of TEST_CASE(), so they never need to be escaped for XML or JSON.
+static auto as_seconds_(const std::chrono::nanoseconds ns) -> double {
+  return std::chrono::duration<double>(ns).count();
+}
+
+static auto as_millis_(const std::chrono::nanoseconds ns) -> double {
+  return std::chrono::duration<double, std::milli>(ns).count();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto JUnitWriter::create(const sys::String& path) -> n19::Result<std::unique_ptr<ReportWriter>> {
+  auto writer     = std::make_unique<JUnitWriter>();
+  writer->file_   = TRY(sys::File::create_trunc(path, sys::File::Write));
+  writer->stream_ = BufferedOStream<>::from(writer->file_);
+  writer->stream_
+    << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    << "<testsuites name=\"bulwark\">\n"
+    << Flush;
+
+  return n19::Result<std::unique_ptr<ReportWriter>>{ std::move(writer) };
+}
+
+auto JUnitWriter::begin_suite(const Suite&) -> void {
+  cases_.clear();
+  tests_ = failures_ = errors_ = skipped_ = 0;
+}
+
+auto JUnitWriter::add_case(const Suite& suite, const Case& c) -> void {
+  StringOStream element;
+  element
+    << "    <testcase classname=\"" << suite.name_
+    << "\" name=\"" << c.name_
+    << "\" time=\"" << fmt("{:.6f}", as_seconds_(c.elapsed_))
+    << "\"";
+
+  switch(c.result_.val_) {
+  case Result::Passed:
+    element << "/>\n";
+    break;
+  case Result::Skipped:
+    element << ">\n      <skipped/>\n    </testcase>\n";
+    ++skipped_;
+    break;
+  case Result::Exception:
+    element << ">\n      <error message=\"uncaught exception\"/>\n    </testcase>\n";
+    ++errors_;
+    break;
+  case Result::Failed:
+    element
+      << ">\n      <failure message=\""
+      << (c.timed_out_ ? "timed out" : "failed")
+      << "\"/>\n    </testcase>\n";
+    ++failures_;
+    break;
+  default: UNREACHABLE_ASSERTION;
+  }
+
+  cases_ += element.str_;
+  ++tests_;
+}
+
+auto JUnitWriter::end_suite(const Suite& suite) -> void {
+  stream_
+    << "  <testsuite name=\"" << suite.name_
+    << "\" tests=\""    << tests_
+    << "\" failures=\"" << failures_
+    << "\" errors=\""   << errors_
+    << "\" skipped=\""  << skipped_
+    << "\">\n"
+    << cases_
+    << "  </testsuite>\n"
+    << Flush;
+
+  cases_.clear();
+}
+
+auto JUnitWriter::finish() -> void {
+  if(finished_) return;
+  finished_ = true;
+  stream_ << "</testsuites>\n" << Flush;
+  file_.close();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto JsonWriter::create(const sys::String& path) -> n19::Result<std::unique_ptr<ReportWriter>> {
+  auto writer     = std::make_unique<JsonWriter>();
+  writer->file_   = TRY(sys::File::create_trunc(path, sys::File::Write));
+  writer->stream_ = BufferedOStream<>::from(writer->file_);
+  writer->stream_ << "{\n  \"cases\": [" << Flush;
+
+  return n19::Result<std::unique_ptr<ReportWriter>>{ std::move(writer) };
+}
+
+auto JsonWriter::begin_suite(const Suite&) -> void {
+  /// Nothing to do: each case object carries its suite name,
+  /// which keeps the file a flat list that's trivial to stream.
+}
+
+auto JsonWriter::add_case(const Suite& suite, const Case& c) -> void {
+  stream_
+    << (first_case_ ? "\n" : ",\n")
+    << "    { \"suite\": \"" << suite.name_
+    << "\", \"case\": \""    << c.name_
+    << "\", \"result\": \""  << c.result_.to_string()
+    << "\", \"timed_out\": " << (c.timed_out_ ? "true" : "false")
+    << ", \"ms\": "          << fmt("{:.3f}", as_millis_(c.elapsed_))
+    << " }";
+
+  first_case_ = false;
+  stream_.flush();
+}
+
+auto JsonWriter::end_suite(const Suite&) -> void {
+  stream_.flush();
+}
+
+auto JsonWriter::finish() -> void {
+  if(finished_) return;
+  finished_ = true;
+  stream_ << "\n  ]\n}\n" << Flush;
+  file_.close();
+}
+
+END_NAMESPACE(n19::test);
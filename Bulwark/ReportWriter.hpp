@@ -0,0 +1,80 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_TEST_REPORTWRITER_HPP
+#define N19_TEST_REPORTWRITER_HPP
+#include <Bulwark/Case.hpp>
+#include <Bulwark/Suite.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Result.hpp>
+#include <Sys/File.hpp>
+#include <Sys/String.hpp>
+#include <IO/Stream.hpp>
+#include <memory>
+#include <string>
+BEGIN_NAMESPACE(n19::test);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Machine readable report writers (--junit, --json).
+// The JSON report is streamed: every case is written and flushed as
+// soon as it finishes, so a crash still leaves a usable (if
+// unterminated) report behind. JUnit wants each suite's counts up
+// front, so its cases are held until the suite ends and only the ones
+// that actually ran are counted. A hung case still ends its suite.
+
+class ReportWriter {
+  N19_MAKE_NONCOPYABLE(ReportWriter);
+  N19_MAKE_NONMOVABLE(ReportWriter);
+public:
+  virtual auto begin_suite(const Suite& suite) -> void = 0;
+  virtual auto end_suite(const Suite& suite)   -> void = 0;
+  virtual auto add_case(const Suite& suite, const Case& c) -> void = 0;
+  virtual auto finish() -> void = 0;
+
+  virtual ~ReportWriter() = default;
+  ReportWriter() = default;
+protected:
+  sys::File file_;
+  BufferedOStream<> stream_;
+};
+
+class JUnitWriter final : public ReportWriter {
+public:
+  static auto create(const sys::String& path) -> n19::Result<std::unique_ptr<ReportWriter>>;
+
+  auto begin_suite(const Suite& suite) -> void override;
+  auto end_suite(const Suite& suite)   -> void override;
+  auto add_case(const Suite& suite, const Case& c) -> void override;
+  auto finish() -> void override;
+
+ ~JUnitWriter() override = default;
+  JUnitWriter() = default;
+private:
+  std::string cases_;         /// The current suite's <testcase> elements.
+  size_t tests_    = 0;
+  size_t failures_ = 0;
+  size_t errors_   = 0;
+  size_t skipped_  = 0;
+  bool finished_   = false;
+};
+
+class JsonWriter final : public ReportWriter {
+public:
+  static auto create(const sys::String& path) -> n19::Result<std::unique_ptr<ReportWriter>>;
+
+  auto begin_suite(const Suite& suite) -> void override;
+  auto end_suite(const Suite& suite)   -> void override;
+  auto add_case(const Suite& suite, const Case& c) -> void override;
+  auto finish() -> void override;
+
+ ~JsonWriter() override = default;
+  JsonWriter() = default;
+private:
+  bool first_case_ = true;
+  bool finished_   = false;
+};
+
+END_NAMESPACE(n19::test);
+#endif //N19_TEST_REPORTWRITER_HPP
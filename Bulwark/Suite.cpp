@@ -6,20 +6,126 @@
 #include <Bulwark/Suite.hpp>
 #include <Bulwark/Reporting.hpp>
 #include <Bulwark/BulwarkContext.hpp>
+#include <Sys/Time.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
 BEGIN_NAMESPACE(n19::test);
 
+///
+/// A case that finishes after the timeout is simply marked as failed.
+/// A case that never finishes can't be interrupted safely, so the
+/// watchdog reports it, terminates the report writers and exits.
+class Watchdog_ {
+  N19_MAKE_NONCOPYABLE(Watchdog_);
+  N19_MAKE_NONMOVABLE(Watchdog_);
+public:
+  using Clock_ = std::chrono::steady_clock;
+
+  auto arm(const Suite& suite, Case& c, OStream& s) -> void {
+    std::lock_guard lock(mtx_);
+    suite_    = &suite;
+    case_     = &c;
+    stream_   = &s;
+    deadline_ = Clock_::now() + Context::the().timeout_;
+    armed_    = true;
+    cv_.notify_one();
+  }
+
+  auto disarm() -> void {
+    std::lock_guard lock(mtx_);
+    armed_ = false;
+    cv_.notify_one();
+  }
+
+  auto run_() -> void {
+    std::unique_lock lock(mtx_);
+    while(!quit_) {
+      cv_.wait(lock, [this]{ return armed_ || quit_; });
+      if(quit_) break;
+      if(cv_.wait_until(lock, deadline_, [this]{ return !armed_ || quit_; })) {
+        continue;                  /// Case finished in time.
+      }
+
+      case_->result_    = Result::Failed;
+      case_->timed_out_ = true;    /// The case is hung. Report it and
+      case_->elapsed_   = Context::the().timeout_;
+      report(*case_, case_->result_, *stream_);
+      diagnostic("Case exceeded the timeout, aborting.", Diagnostic::Fatal, *stream_);
+      *stream_ << Flush;           /// bail out, there's no safe way
+                                   /// to stop the thread running it.
+      Context::the().for_each_writer([this](ReportWriter& w) {
+        w.add_case(*suite_, *case_);
+        w.end_suite(*suite_);
+        w.finish();
+      });
+
+      std::_Exit(EXIT_FAILURE);
+    }
+  }
+
+  Watchdog_() : thread_([this]{ run_(); }) {}
+ ~Watchdog_() {
+    {
+      std::lock_guard lock(mtx_);
+      quit_ = true;
+      cv_.notify_one();
+    }
+    thread_.join();
+  }
+private:
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  Clock_::time_point deadline_{};
+  const Suite* suite_ = nullptr;
+  Case* case_         = nullptr;
+  OStream* stream_    = nullptr;
+  bool armed_         = false;
+  bool quit_          = false;
+  std::thread thread_;
+};
+
 auto Suite::run_all(OStream& s) -> void {
   const auto verbose  = Context::the().flags_ & Context::Verbose;
   const auto stopfail = Context::the().flags_ & Context::StopFail;
+  const auto timeout  = Context::the().timeout_;
+
+  std::unique_ptr<Watchdog_> watchdog;
+  if(timeout.count() > 0) {
+    watchdog = std::make_unique<Watchdog_>();
+  }
+
+  Context::the().for_each_writer([this](ReportWriter& w) {
+    w.begin_suite(*this);
+  });
 
   for(Case& case_ : cases_) { /// Iterate through all cases.
     ExecutionContext ctx{s};  /// Create execution context.
     if(verbose) {
       outs() << "Begin Case " << case_.name_ << ":\n";
     }
+
+    if(watchdog) watchdog->arm(*this, case_, s);
+    sys::Stopwatch watch;     /// Time the case with a monotonic clock.
+    case_(ctx);               ///
+    case_.elapsed_ = watch.elapsed();
+    if(watchdog) watchdog->disarm();
+
+    case_.timed_out_ = timeout.count() > 0 && case_.elapsed_ > timeout;
+    if(case_.timed_out_ && ctx.result == Result::Passed) {
+      ctx.result = Result::Failed;
+    }
                               ///
-    case_(ctx);               /// Report the test case result.
+    case_.result_ = ctx.result;
     report(case_, ctx.result, s);
+    if(case_.timed_out_) {    /// Report the test case result.
+      diagnostic("Case exceeded the timeout.", Diagnostic::Fatal, s);
+    }
+
+    Context::the().for_each_writer([&](ReportWriter& w) {
+      w.add_case(*this, case_);
+    });
 
     switch(ctx.result.val_) {
     case Result::Failed:    ++g_total_failed;  break;
@@ -33,6 +139,10 @@ auto Suite::run_all(OStream& s) -> void {
       break;
   }
 
+  Context::the().for_each_writer([this](ReportWriter& w) {
+    w.end_suite(*this);
+  });
+
   s << Flush;
 }
 
@@ -0,0 +1,64 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Bulwark/ReportWriter.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+using namespace n19;
+
+static auto read_report_(const std::filesystem::path& path) -> std::string {
+  std::ifstream in(path, std::ios::binary);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+TEST_CASE(ReportWriter, JUnit) {
+  const auto path = std::filesystem::temp_directory_path() / "n19_suite_report.xml";
+  const auto noop = [](test::ExecutionContext&) {};
+
+  test::Suite suite;
+  suite.name_ = _nstr("Reports");
+  suite.cases_.emplace_back(noop, "Passes");
+  suite.cases_.emplace_back(noop, "Fails");
+  suite.cases_.emplace_back(noop, "NeverRan");
+  suite.cases_[0].result_ = test::Result::Passed;
+  suite.cases_[1].result_ = test::Result::Failed;
+
+  {
+    auto created = test::JUnitWriter::create(path.native());
+    REQUIRE(created.has_value());
+    auto& writer = created.value();
+
+    /// As if --stopfail ended the suite at the failure.
+    writer->begin_suite(suite);
+    writer->add_case(suite, suite.cases_[0]);
+    writer->add_case(suite, suite.cases_[1]);
+    writer->end_suite(suite);
+    writer->finish();
+  }
+
+  const std::string xml = read_report_(path);
+  std::filesystem::remove(path);
+
+  SECTION(CountsOnlyWhatRan, {
+    REQUIRE(xml.find("tests=\"2\" failures=\"1\" errors=\"0\" skipped=\"0\"") != std::string::npos);
+    REQUIRE(xml.find("tests=\"3\"") == std::string::npos);
+  });
+
+  SECTION(Cases, {
+    REQUIRE(xml.find("name=\"Passes\"") != std::string::npos);
+    REQUIRE(xml.find("<failure message=\"failed\"/>") != std::string::npos);
+    REQUIRE(xml.find("NeverRan") == std::string::npos);
+  });
+
+  SECTION(Terminated, {
+    REQUIRE(xml.find("</testsuite>") != std::string::npos);
+    REQUIRE(xml.rfind("</testsuites>") != std::string::npos);
+  });
+}
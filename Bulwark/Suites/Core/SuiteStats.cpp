@@ -0,0 +1,75 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Core/Stats.hpp>
+#include <IO/Stream.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+using namespace n19;
+
+static stats::Counter test_plain_{"bulwark.plain"};
+static stats::Counter test_threads_{"bulwark.threads"};
+static stats::Counter test_shared_a_{"bulwark.shared"};
+static stats::Counter test_shared_b_{"bulwark.shared"};
+
+static auto value_of(const std::string_view name) -> uint64_t {
+  const auto all = stats::snapshot();
+  const auto it  = std::ranges::find(all, name, &std::pair<std::string_view, uint64_t>::first);
+  return it != all.end() ? it->second : 0;
+}
+
+TEST_CASE(Stats, Counters) {
+#ifndef N19_DISABLE_STATS
+  SECTION(AddAndSnapshot, {
+    const uint64_t before = value_of("bulwark.plain");
+    test_plain_.add();
+    test_plain_.add(41);
+    REQUIRE(value_of("bulwark.plain") == before + 42);
+
+    const auto all = stats::snapshot();
+    REQUIRE(std::ranges::is_sorted(all));
+  });
+
+  SECTION(MergedAcrossThreads, {
+    const uint64_t before = value_of("bulwark.threads");
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < 4; i++) {
+      threads.emplace_back([] {
+        for(size_t j = 0; j < 1000; j++) test_threads_.add();
+      });
+    }
+
+    for(auto& thread : threads) thread.join();
+    REQUIRE(value_of("bulwark.threads") == before + 4000);
+  });
+
+  SECTION(SameNameReportedOnce, {
+    const uint64_t before = value_of("bulwark.shared");
+    test_shared_a_.add(2);
+    test_shared_b_.add(3);
+    REQUIRE(value_of("bulwark.shared") == before + 5);
+
+    const auto all = stats::snapshot();
+    REQUIRE(std::ranges::count(all, std::string_view{"bulwark.shared"},
+      &std::pair<std::string_view, uint64_t>::first) == 1);
+  });
+
+  SECTION(Json, {
+    test_plain_.add();
+    StringOStream out;
+    stats::print_json(out);
+    REQUIRE(out.str_.starts_with("{\n"));
+    REQUIRE(out.str_.ends_with("\n}\n"));
+    REQUIRE(out.str_.find("\"bulwark.plain\": ") != std::string::npos);
+  });
+#else
+  SECTION(CompiledOut, {
+    test_plain_.add();
+    REQUIRE(stats::snapshot().empty());
+  });
+#endif
+}
@@ -0,0 +1,154 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Core/Task.hpp>
+#include <Core/Scheduler.hpp>
+#include <Sys/File.hpp>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <string>
+using namespace n19;
+
+static auto square(Scheduler& sched, const int value) -> Task<int> {
+  co_await sched.schedule();
+  co_return value * value;
+}
+
+static auto sum_of_squares(Scheduler& sched, const int count) -> Task<int> {
+  int sum = 0;
+  for(int i = 1; i <= count; i++) {
+    sum += co_await square(sched, i);
+  }
+
+  co_return sum;
+}
+
+static auto halve(const int value) -> Result<int> {
+  ERROR_IF(value % 2 != 0, ErrC::InvalidArg, "Odd.");
+  return value / 2;
+}
+
+static auto halve_twice(const int value, bool& finished) -> Task<Result<int>> {
+  const int half    = co_await halve(value);
+  const int quarter = co_await halve(half);
+  finished = true;
+  co_return quarter;
+}
+
+static auto counted(Scheduler& sched, CancelToken token, const int value) -> Task<Result<int>> {
+  co_await sched.schedule();
+  co_await token.check();
+  co_return value;
+}
+
+static auto worker_id(Scheduler& sched) -> Task<std::thread::id> {
+  co_await sched.schedule();
+  co_return std::this_thread::get_id();
+}
+
+TEST_CASE(Task, Basics) {
+  Scheduler sched(2);
+
+  SECTION(AwaitsChildren, {
+    REQUIRE(block_on(sum_of_squares(sched, 4)) == 1 + 4 + 9 + 16);
+  });
+
+  SECTION(RunsOnWorkers, {
+    REQUIRE(block_on(worker_id(sched)) != std::this_thread::get_id());
+  });
+
+  SECTION(Lazy, {
+    auto task = square(sched, 3);
+    REQUIRE(!task.done());
+    REQUIRE(block_on(std::move(task)) == 9);
+  });
+
+  SECTION(Offload, {
+    auto result = block_on(offload(sched, [] { return std::string("offloaded"); }));
+    REQUIRE(result == "offloaded");
+  });
+}
+
+TEST_CASE(Task, Errors) {
+  SECTION(Propagates, {
+    bool finished = false;
+    auto result = block_on(halve_twice(6, finished));
+    REQUIRE(!result.has_value());
+    REQUIRE(result.error().code == ErrC::InvalidArg);
+    REQUIRE(!finished);
+  });
+
+  SECTION(Unwraps, {
+    bool finished = false;
+    auto result = block_on(halve_twice(8, finished));
+    REQUIRE(result.has_value());
+    REQUIRE(*result == 2);
+    REQUIRE(finished);
+  });
+}
+
+TEST_CASE(Task, Structured) {
+  Scheduler sched(4);
+
+  SECTION(WhenAllKeepsOrder, {
+    std::vector<Task<int>> tasks;
+    for(int i = 0; i < 32; i++) {
+      tasks.emplace_back(square(sched, i));
+    }
+
+    auto values = block_on(when_all(sched, std::move(tasks)));
+    REQUIRE(values.size() == 32);
+
+    bool ordered = true;
+    for(int i = 0; i < 32; i++) {
+      ordered = ordered && values[i] == i * i;
+    }
+
+    REQUIRE(ordered);
+  });
+
+  SECTION(WhenAllEmpty, {
+    auto values = block_on(when_all(sched, std::vector<Task<int>>{}));
+    REQUIRE(values.empty());
+  });
+
+  SECTION(Cancellation, {
+    CancelSource source;
+    std::vector<Task<Result<int>>> tasks;
+    tasks.emplace_back(counted(sched, source.token(), 1));
+    source.cancel();
+    tasks.emplace_back(counted(sched, source.token(), 2));
+    tasks.emplace_back(counted(sched, CancelToken{}, 3));
+
+    auto results = block_on(when_all(sched, std::move(tasks)));
+    REQUIRE(results[0].error().code == ErrC::Cancelled);
+    REQUIRE(results[1].error().code == ErrC::Cancelled);
+    REQUIRE(results[2].value() == 3);
+  });
+}
+
+TEST_CASE(Task, Files) {
+  const auto path = std::filesystem::temp_directory_path() / "n19_suite_task.txt";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "hello, async";
+  }
+
+  SECTION(ReadAllAsync, {
+    auto bytes = block_on(sys::File::read_all_async(path.native()));
+    REQUIRE(bytes.has_value());
+    REQUIRE(std::string(bytes->begin(), bytes->end()) == "hello, async");
+  });
+
+  SECTION(MissingFile, {
+    auto bytes = block_on(sys::File::read_all_async(path.native() + _nstr(".missing")));
+    REQUIRE(!bytes.has_value());
+  });
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,79 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_BULWARK_ASTFIXTURES_HPP
+#define N19_BULWARK_ASTFIXTURES_HPP
+#include <Frontend/AstNodes.hpp>
+#include <Frontend/Token.hpp>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Builders for the small ASTs the Frontend suites run passes
+// and analyses over, without going through the parser. Every
+// node is at offset 0 on line 1 and has no file.
+
+BEGIN_NAMESPACE(n19::fixtures);
+
+inline auto make_ref(const std::string& name) -> AstNode::Ptr<> {
+  auto ref   = AstNode::create<AstEntityRefThunk>(0, 1);
+  ref->name_ = name;
+  return ref;
+}
+
+inline auto make_lit(const std::string& value, const bool boolean = false) -> AstNode::Ptr<> {
+  auto lit = AstNode::create<AstScalarLiteral>(0, 1);
+  lit->scalar_type_ = boolean ? AstScalarLiteral::BoolLit : AstScalarLiteral::IntLit;
+  lit->value_       = value;
+  return lit;
+}
+
+inline auto make_call(const std::string& name, AstNode::Ptr<> arg = nullptr) -> AstNode::Ptr<> {
+  auto call     = AstNode::create<AstCall>(0, 1);
+  call->target_ = make_ref(name);
+  if(arg) call->arguments_.emplace_back(std::move(arg));
+  return call;
+}
+
+inline auto make_bin(const TokenType op, AstNode::Ptr<> lhs, AstNode::Ptr<> rhs) -> AstNode::Ptr<> {
+  auto bin      = AstNode::create<AstBinExpr>(0, 1);
+  bin->op_type_ = op;
+  bin->left_    = std::move(lhs);
+  bin->right_   = std::move(rhs);
+  return bin;
+}
+
+inline auto make_return(AstNode::Ptr<> value) -> AstNode::Ptr<> {
+  auto ret    = AstNode::create<AstReturn>(0, 1);
+  ret->value_ = std::move(value);
+  return ret;
+}
+
+/// proc <name>() {}
+inline auto make_proc(const std::string& name) -> AstNode::Ptr<AstProcDecl> {
+  auto proc   = AstNode::create<AstProcDecl>(0, 1);
+  proc->name_ = make_ref(name);
+  return proc;
+}
+
+/// proc <name>(<param>) { return <expr>; }
+inline auto make_proc(
+  const std::string& name,
+  AstNode::Ptr<> expr,
+  const std::string& param = "" ) -> AstNode::Ptr<AstProcDecl>
+{
+  auto proc = make_proc(name);
+  if(!param.empty()) {
+    auto var   = AstNode::create<AstVardecl>(0, 1);
+    var->name_ = make_ref(param);
+    proc->arg_decls_.emplace_back(std::move(var));
+  }
+
+  proc->body_.emplace_back(make_return(std::move(expr)));
+  return proc;
+}
+
+END_NAMESPACE(n19::fixtures);
+#endif //N19_BULWARK_ASTFIXTURES_HPP
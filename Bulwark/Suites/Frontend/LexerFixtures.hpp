@@ -0,0 +1,29 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_BULWARK_LEXERFIXTURES_HPP
+#define N19_BULWARK_LEXERFIXTURES_HPP
+#include <Frontend/Lexer.hpp>
+#include <memory>
+#include <vector>
+#include <string>
+
+BEGIN_NAMESPACE(n19::fixtures);
+
+///
+/// A lexer over a copy of source, already
+/// positioned on its first token.
+inline auto create_lexer(const std::string& source) -> std::shared_ptr<Lexer> {
+  std::vector<char8_t> buffer;
+  buffer.reserve(source.size());
+  for(auto c : source) {
+    buffer.push_back(static_cast<char8_t>(c));
+  }
+
+  return Lexer::create_shared(std::move(buffer)).value();
+}
+
+END_NAMESPACE(n19::fixtures);
+#endif //N19_BULWARK_LEXERFIXTURES_HPP
@@ -0,0 +1,86 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/AstVisitor.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <Bulwark/Suites/Frontend/AstFixtures.hpp>
+#include <string>
+#include <vector>
+using namespace n19;
+using namespace n19::fixtures;
+
+/// proc f() { return a + (b + c); g(d); }
+static auto make_tree() -> AstNode::Ptr<> {
+  const auto add = [](AstNode::Ptr<> lhs, AstNode::Ptr<> rhs) {
+    return make_bin(TokenType::Plus, std::move(lhs), std::move(rhs));
+  };
+
+  auto proc = make_proc("f");
+  proc->body_.emplace_back(make_return(add(make_ref("a"), add(make_ref("b"), make_ref("c")))));
+  proc->body_.emplace_back(make_call("g", make_ref("d")));
+  return proc;
+}
+
+struct NameCollector : AstVisitor<NameCollector> {
+  auto enter(AstEntityRefThunk& ref) -> void { pre_.push_back(ref.name_); }
+  auto leave(AstBinExpr&) -> void { post_ += "+"; }
+  auto leave(AstEntityRefThunk& ref) -> void { post_ += ref.name_; }
+
+  std::vector<std::string> pre_;
+  std::string post_;
+};
+
+struct StopAt : AstVisitor<StopAt> {
+  auto enter(AstEntityRefThunk& ref) -> AstWalk {
+    ++seen_;
+    return ref.name_ == name_ ? AstWalk::Stop : AstWalk::Continue;
+  }
+
+  std::string name_;
+  size_t seen_ = 0;
+};
+
+struct SkipExprs : AstVisitor<SkipExprs> {
+  auto enter(AstBinExpr&) -> AstWalk { return AstWalk::Skip; }
+  auto enter(AstNode&) -> void { ++nodes_; }
+  size_t nodes_ = 0;
+};
+
+TEST_CASE(AstVisitor, Traversal) {
+  auto owner = make_tree();
+  AstNode* tree = owner.get();
+
+  SECTION(PreAndPostOrder, {
+    NameCollector names;
+    REQUIRE(names.traverse(*tree));
+    REQUIRE(names.pre_ == std::vector<std::string>({"f", "a", "b", "c", "g", "d"}));
+    REQUIRE(names.post_ == "fabc++gd");
+  });
+
+  SECTION(EarlyExit, {
+    StopAt stop;
+    stop.name_ = "b";
+    REQUIRE(!stop.traverse(*tree));
+    REQUIRE(stop.seen_ == 3);
+
+    stop.name_ = "nope";
+    stop.seen_ = 0;
+    REQUIRE(stop.traverse(*tree));
+    REQUIRE(stop.seen_ == 6);
+  });
+
+  SECTION(SkipChildren, {
+    /// The proc, f, return, call, g and d; the
+    /// binary expressions are skipped whole.
+    SkipExprs skip;
+    REQUIRE(skip.traverse(*tree));
+    REQUIRE(skip.nodes_ == 6);
+  });
+
+  SECTION(MatchesAstSize, {
+    REQUIRE(ast_size(*tree) == 11);
+  });
+}
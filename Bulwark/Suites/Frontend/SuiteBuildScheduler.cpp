@@ -0,0 +1,64 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/BuildScheduler.hpp>
+#include <filesystem>
+#include <vector>
+using namespace n19;
+
+static auto make_jobs(const std::vector<double>& costs) -> std::vector<CompileJob> {
+  std::vector<CompileJob> jobs;
+  for(const double cost : costs) {
+    CompileJob job;
+    job.predicted_ms_ = cost;
+    jobs.push_back(job);
+  }
+
+  return jobs;
+}
+
+TEST_CASE(BuildScheduler, LongestFirst) {
+  SECTION(Order, {
+    auto jobs = make_jobs({3, 5, 3, 4, 3});
+    BuildScheduler::order(jobs);
+    REQUIRE(jobs[0].predicted_ms_ == 5);
+    REQUIRE(jobs[1].predicted_ms_ == 4);
+    REQUIRE(jobs[4].predicted_ms_ == 3);
+  });
+
+  SECTION(Makespan, {
+    auto jobs = make_jobs({5, 4, 3, 3, 3});
+    REQUIRE(BuildScheduler::predict_makespan(jobs, 2) == 10);
+    REQUIRE(BuildScheduler::predict_makespan(jobs, 1) == 18);
+    REQUIRE(BuildScheduler::predict_makespan(jobs, 8) == 5);
+  });
+}
+
+TEST_CASE(BuildScheduler, Stats) {
+  SECTION(Estimate, {
+    BuildStats stats;
+    const auto none = stats.estimate(_nstr("a.n19"), 2048);
+    REQUIRE(none > stats.estimate(_nstr("a.n19"), 1024));
+
+    stats.record(_nstr("a.n19"), 1000, 10.0);
+    REQUIRE(stats.estimate(_nstr("a.n19"), 2000) == 20.0);
+    REQUIRE(stats.estimate(_nstr("b.n19"), 500) == 5.0);
+  });
+
+  SECTION(RoundTrip, {
+    const auto path = (std::filesystem::temp_directory_path() / "n19_suite_stats").native();
+
+    BuildStats stats;
+    stats.record(_nstr("dir with spaces/a.n19"), 1000, 12.5);
+    REQUIRE(stats.save(path).has_value());
+    REQUIRE(!std::filesystem::exists(path + _nstr(".tmp")));
+
+    auto loaded = BuildStats::load(path);
+    REQUIRE(loaded.entries_.size() == 1);
+    REQUIRE(loaded.estimate(_nstr("dir with spaces/a.n19"), 1000) == 12.5);
+    REQUIRE(BuildStats::load(_nstr("n19-no-such-stats-file")).entries_.empty());
+  });
+}
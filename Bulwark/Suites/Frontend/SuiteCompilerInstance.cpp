@@ -0,0 +1,66 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/CompilerInstance.hpp>
+#include <vector>
+#include <string>
+#include <thread>
+using namespace n19;
+
+static auto to_buffer(const std::string& source) -> std::vector<char8_t> {
+  std::vector<char8_t> buffer;
+  buffer.reserve(source.size());
+  for(auto c : source) {
+    buffer.push_back(static_cast<char8_t>(c));
+  }
+
+  return buffer;
+}
+
+TEST_CASE(CompilerInstance, Reentrancy) {
+  SECTION(ConcurrentInstances, {
+    NullOStream null;
+    CompilerInstance first;
+    CompilerInstance second;
+    first.out_  = first.err_  = &null;
+    second.out_ = second.err_ = &null;
+
+    bool first_ok = false;
+    bool second_ok = false;
+    std::thread worker([&] {
+      first_ok = first.compile_source(
+        to_buffer("proc add(a: i32, b: i32) -> i32 { return a + b; }\n"),
+        _nstr("first"));
+    });
+
+    second_ok = second.compile_source(
+      to_buffer("proc sub(a: i32, b: i32) -> i32 { return a - b; }\n"),
+      _nstr("second"));
+    worker.join();
+
+    REQUIRE(first_ok);
+    REQUIRE(second_ok);
+    REQUIRE(first.entities_->lookup("::add") != nullptr);
+    REQUIRE(first.entities_->lookup("::sub") == nullptr);
+    REQUIRE(second.entities_->lookup("::sub") != nullptr);
+    REQUIRE(second.entities_->lookup("::add") == nullptr);
+    REQUIRE(first.decls_.size() == 1);
+  });
+
+  SECTION(ReusedAfterFailure, {
+    NullOStream null;
+    CompilerInstance instance;
+    instance.out_ = instance.err_ = &null;
+
+    REQUIRE(!instance.compile_source({}, _nstr("empty")));
+    REQUIRE(!instance.compile_source(to_buffer("proc ( {\n"), _nstr("bad")));
+    REQUIRE(instance.compile_source(
+      to_buffer("proc id(a: i32) -> i32 { return a; }\n"),
+      _nstr("good")));
+    REQUIRE(instance.entities_->lookup("::id") != nullptr);
+    REQUIRE(instance.decls_.size() == 1);
+  });
+}
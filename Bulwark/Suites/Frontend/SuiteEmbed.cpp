@@ -0,0 +1,94 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/Parser.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/Lexer.hpp>
+#include <Bulwark/Suites/Frontend/LexerFixtures.hpp>
+#include <IO/Stream.hpp>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <string>
+using namespace n19;
+using namespace n19::fixtures;
+
+TEST_CASE(Embed, Directive) {
+  const auto dir = std::filesystem::temp_directory_path();
+  {
+    std::ofstream out(dir / "n19_suite_embed.bin", std::ios::binary);
+    out.write("\x00\x01\x02\xff", 4);
+  }
+
+  SECTION(MapsRelativeToSource, {
+    auto lxr = create_lexer("@embed(\"n19_suite_embed.bin\")");
+    lxr->file_name_ = (dir / "main.n19").native();
+    ErrorCollector errors;
+    EntityTable table(_nstr("MyTable"));
+    ParseContext ctx(errs(), errors, *lxr, table);
+
+    auto node = detail_::parse_directive_(ctx);
+    REQUIRE(node.has_value());
+    REQUIRE((*node)->type_ == AstNode::Type::Embed);
+    REQUIRE(lxr->current() == TokenType::EndOfFile);
+
+    const auto& embed = static_cast<AstEmbed&>(**node);
+    REQUIRE(embed.bytes().size() == 4);
+    REQUIRE(embed.bytes()[3] == Byte{0xff});
+
+    auto copy = ast_clone(embed);
+    REQUIRE(static_cast<AstEmbed&>(*copy).bytes().data() == embed.bytes().data());
+
+    REQUIRE(ctx.includes_.size() == 1);
+    REQUIRE(ctx.includes_[0].state_ == detail_::IncludeState::Embedded);
+  });
+
+  SECTION(Rejected, {
+    ErrorCollector errors;
+    EntityTable table(_nstr("MyTable"));
+
+    auto too_large = create_lexer("@embed(\"n19_suite_embed.bin\")");
+    too_large->file_name_ = (dir / "main.n19").native();
+    ParseContext large_ctx(errs(), errors, *too_large, table);
+    large_ctx.embed_max_bytes_ = 3;
+    REQUIRE(!detail_::parse_directive_(large_ctx).has_value());
+
+    auto missing = create_lexer("@embed(\"n19_suite_no_such_file.bin\")");
+    ParseContext missing_ctx(errs(), errors, *missing, table);
+    REQUIRE(!detail_::parse_directive_(missing_ctx).has_value());
+    REQUIRE(missing_ctx.includes_.empty());
+
+    auto unknown = create_lexer("@nonsense");
+    ParseContext unknown_ctx(errs(), errors, *unknown, table);
+    REQUIRE(!detail_::parse_directive_(unknown_ctx).has_value());
+  });
+
+  SECTION(DumpTruncated, {
+    {
+      std::ofstream out(dir / "n19_suite_embed_large.bin", std::ios::binary);
+      const std::string bytes(1000, 'x');
+      out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    auto lxr = create_lexer("@embed(\"n19_suite_embed_large.bin\")");
+    lxr->file_name_ = (dir / "main.n19").native();
+    ErrorCollector errors;
+    EntityTable table(_nstr("MyTable"));
+    ParseContext ctx(errs(), errors, *lxr, table);
+
+    auto node = detail_::parse_directive_(ctx);
+    REQUIRE(node.has_value());
+
+    StringOStream out;
+    (*node)->print(0, out, Nothing);
+    REQUIRE(out.str_.find("1000 bytes") != std::string::npos);
+    REQUIRE(out.str_.find("... 936 more bytes") != std::string::npos);
+    REQUIRE(std::ranges::count(out.str_, '\n') == 6);
+    std::filesystem::remove(dir / "n19_suite_embed_large.bin");
+  });
+}
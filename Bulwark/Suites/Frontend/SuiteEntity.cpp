@@ -43,3 +43,96 @@ TEST_CASE(Entity, SymLinks) {
     REQUIRE(resolved->id_ == ptr3->id_);
   });
 }
+
+TEST_CASE(Entity, Forking) {
+  SECTION(ForkSeesBase, {
+    EntityTable fork(EntityTable::builtins());
+    REQUIRE(fork.map_.empty());
+    REQUIRE(fork.exists(BuiltinType::I32));
+    REQUIRE(fork.lookup("::i32") != nullptr);
+    REQUIRE(fork.root_ == EntityTable::builtins()->root_);
+  });
+
+  SECTION(CopyOnWrite, {
+    const auto base = EntityTable::builtins();
+    const size_t base_children = base->root_->chldrn_.size();
+
+    EntityTable fork1(base, _nstr("file1"));
+    EntityTable fork2(base, _nstr("file2"));
+    auto a = fork1.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file1"), "A");
+    auto b = fork2.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file2"), "B");
+
+    /// Same IDs, different tables: neither sees the other,
+    /// and the base root is untouched.
+    REQUIRE(a->id_ == b->id_);
+    REQUIRE(fork1.lookup("::A") != nullptr);
+    REQUIRE(fork1.lookup("::B") == nullptr);
+    REQUIRE(fork2.lookup("::B") != nullptr);
+    REQUIRE(base->root_->chldrn_.size() == base_children);
+    REQUIRE(fork1.root_->chldrn_.size() == base_children + 1);
+    REQUIRE(fork1.root_ != base->root_);
+    REQUIRE(fork1.root_->file_ == _nstr("file1"));
+  });
+
+  SECTION(OwnCopiesOnce, {
+    const auto base = EntityTable::builtins();
+    EntityTable fork(base);
+    auto owned = fork.own(BuiltinType::U8);
+    REQUIRE(owned != base->find_direct(BuiltinType::U8));
+    REQUIRE(fork.own(BuiltinType::U8) == owned);
+    REQUIRE(fork.find_direct(BuiltinType::U8) == owned);
+
+    size_t count = 0;
+    fork.for_each([&](const Entity::Ptr<>&) { ++count; });
+    REQUIRE(count == base->map_.size());
+  });
+}
+
+TEST_CASE(Entity, Removal) {
+  SECTION(RemoveFile, {
+    EntityTable table(EntityTable::builtins(), _nstr("file1"));
+    const size_t base_children = table.root_->chldrn_.size();
+    auto a = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file1"), "A");
+    auto b = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file2"), "B");
+    auto c = table.insert<Struct>(a->id_, 1, 1, _nstr("file1"), "C");
+    const Entity::ID a_id = a->id_;
+    const Entity::ID c_id = c->id_;
+
+    REQUIRE(table.remove_file(_nstr("file1")) == 2);
+    REQUIRE(!table.exists(a_id));
+    REQUIRE(!table.exists(c_id));
+    REQUIRE(table.lookup("::A") == nullptr);
+    REQUIRE(table.lookup("::A::C") == nullptr);
+    REQUIRE(table.lookup("::B") == b);
+    REQUIRE(table.root_->chldrn_.size() == base_children + 1);
+
+    /// Freed IDs are handed out again.
+    auto d = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file1"), "D");
+    REQUIRE(d->id_ == a_id || d->id_ == c_id);
+    REQUIRE(table.remove_file(_nstr("file1")) == 1);
+    REQUIRE(table.remove_file(_nstr("file3")) == 0);
+  });
+
+  SECTION(BuiltinsStay, {
+    EntityTable table(EntityTable::builtins(), _nstr("file1"));
+    REQUIRE(table.remove(BuiltinType::I32) == 0);
+    REQUIRE(table.remove(N19_ROOT_ENTITY_ID) == 0);
+    REQUIRE(table.exists(BuiltinType::I32));
+  });
+
+  SECTION(TombstoneInFork, {
+    auto base = std::make_shared<EntityTable>(EntityTable::builtins(), _nstr("file1"));
+    const Entity::ID a_id = base->insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file1"), "A")->id_;
+    const size_t base_children = base->root_->chldrn_.size();
+
+    EntityTable fork(base);
+    REQUIRE(fork.remove_file(_nstr("file1")) == 1);
+    REQUIRE(!fork.exists(a_id));
+    REQUIRE(fork.lookup("::A") == nullptr);
+    REQUIRE(fork.root_->chldrn_.size() == base_children - 1);
+
+    REQUIRE(base->exists(a_id));
+    REQUIRE(base->lookup("::A") != nullptr);
+    REQUIRE(base->root_->chldrn_.size() == base_children);
+  });
+}
@@ -0,0 +1,111 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/FlightRecorder.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/Token.hpp>
+#include <Frontend/Lexer.hpp>
+#include <IO/Stream.hpp>
+#include <string>
+#include <thread>
+#include <atomic>
+using namespace n19;
+
+TEST_CASE(FlightRecorder, Recording) {
+#ifndef N19_DISABLE_FLIGHT_RECORDER
+  SECTION(Decoded, {
+    /// A fresh thread, so its ring holds only these.
+    StringOStream out;
+    std::thread([&] {
+      flight::file(_nstr("flight.n19"));
+      flight::phase(flight::Parse);
+      flight::token(TokenType::Comma, 120, 14);
+      flight::entity(static_cast<uint16_t>(EntityType::Struct), 45, N19_ROOT_ENTITY_ID);
+      flight::note("dce");
+      flight::dump(out);
+    }).join();
+
+    REQUIRE(out.str_.find("(this thread), last 5 of 5 events") != std::string::npos);
+    REQUIRE(out.str_.find("file      flight.n19") != std::string::npos);
+    REQUIRE(out.str_.find("phase     parse") != std::string::npos);
+    REQUIRE(out.str_.find("line 14, offset 120") != std::string::npos);
+    REQUIRE(out.str_.find("entity    Struct #45 under #1") != std::string::npos);
+    REQUIRE(out.str_.find("note      dce") != std::string::npos);
+  });
+
+  SECTION(OldestDropped, {
+    StringOStream out;
+    std::thread([&] {
+      for(uint32_t i = 0; i < flight::ring_size_ * 2; i++) {
+        flight::token(TokenType::Comma, i, 1);
+      }
+
+      flight::dump(out, 4);
+    }).join();
+
+    const std::string newest = "offset " + std::to_string(flight::ring_size_ * 2 - 1) + "\n";
+    REQUIRE(out.str_.find(fmt("last 4 of {} events", flight::ring_size_)) != std::string::npos);
+    REQUIRE(out.str_.ends_with(newest));
+    REQUIRE(out.str_.find("offset 0\n") == std::string::npos);
+  });
+
+  SECTION(EntityInserts, {
+    StringOStream out;
+    Entity::ID id = N19_INVALID_ENTITY_ID;
+    std::thread([&] {
+      EntityTable table(EntityTable::builtins(), _nstr("flight"));
+      id = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("flight"), "S")->id_;
+      flight::dump(out, 1);
+    }).join();
+
+    REQUIRE(out.str_.find(fmt("Struct #{} under #1", id)) != std::string::npos);
+  });
+
+  SECTION(LookaheadNotRecorded, {
+    StringOStream before, peeked, consumed;
+    std::thread([&] {
+      const std::string source = "a b c d";
+      auto lexer = Lexer::create_shared(std::vector<char8_t>(source.begin(), source.end())).value();
+      flight::dump(before, flight::ring_size_);
+      (void)lexer->peek(2);
+      (void)lexer->batched_peek<3>();
+      flight::dump(peeked, flight::ring_size_);
+      lexer->consume(1);
+      flight::dump(consumed, flight::ring_size_);
+    }).join();
+
+    REQUIRE(before.str_ == peeked.str_);
+    REQUIRE(consumed.str_ != peeked.str_);
+  });
+
+  SECTION(DumpWhileRecording, {
+    /// Another thread's ring is read as it's being
+    /// written. Meant to be run under TSan as well.
+    std::atomic<bool> started = false, stop = false;
+    std::thread writer([&] {
+      for(uint32_t i = 0; !stop.load(std::memory_order_relaxed); i++) {
+        flight::token(TokenType::Comma, i, 1);
+        started.store(true, std::memory_order_release);
+      }
+    });
+
+    while(!started.load(std::memory_order_acquire)) std::this_thread::yield();
+    StringOStream out;
+    for(int i = 0; i < 32; i++) flight::dump(out, 8);
+    stop.store(true, std::memory_order_relaxed);
+    writer.join();
+
+    REQUIRE(out.str_.find("token     ") != std::string::npos);
+  });
+#else
+  SECTION(CompiledOut, {
+    flight::note("dce");
+    StringOStream out;
+    flight::dump(out);
+    REQUIRE(out.str_.empty());
+  });
+#endif
+}
@@ -0,0 +1,82 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/CallGraph.hpp>
+#include <Frontend/Inliner.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <Bulwark/Suites/Frontend/AstFixtures.hpp>
+using namespace n19;
+using namespace n19::fixtures;
+
+static auto returned_expr(AstNode::Ptr<>& proc) -> AstNode* {
+  auto& decl = static_cast<AstProcDecl&>(*proc);
+  return static_cast<AstReturn&>(*decl.body_[0]).value_.get();
+}
+
+TEST_CASE(Inliner, CallGraph) {
+  SECTION(BottomUpOrder, {
+    AstNode::Children<> decls;
+    decls.emplace_back(make_proc("caller", make_call("callee")));
+    decls.emplace_back(make_proc("callee", make_lit("1")));
+    decls.emplace_back(make_proc("rec", make_call("rec")));
+
+    auto graph = CallGraph::build(decls);
+    REQUIRE(graph.nodes_.size() == 3);
+    REQUIRE(graph.sccs_.size() == 3);
+
+    const auto caller = graph.find("caller");
+    const auto callee = graph.find("callee");
+    REQUIRE(caller.has_value() && callee.has_value());
+    REQUIRE(graph.nodes_[*callee].scc_ < graph.nodes_[*caller].scc_);
+    REQUIRE(graph.nodes_[*caller].sites_.size() == 1);
+  });
+}
+
+TEST_CASE(Inliner, Inlining) {
+  SECTION(SubstitutesArguments, {
+    auto square    = AstNode::create<AstBinExpr>(0, 1);
+    square->left_  = make_ref("x");
+    square->right_ = make_ref("x");
+
+    AstNode::Children<> decls;
+    decls.emplace_back(make_proc("sq", std::move(square), "x"));
+    decls.emplace_back(make_proc("main", make_call("sq", make_lit("3"))));
+
+    const auto stats = inline_procedures(decls);
+    REQUIRE(stats.inlined_ == 1);
+
+    AstNode* expr = returned_expr(decls[1]);
+    REQUIRE(expr->type_ == AstNode::Type::BinExpr);
+    auto& bin = static_cast<AstBinExpr&>(*expr);
+    REQUIRE(bin.left_->type_ == AstNode::Type::ScalarLiteral);
+    REQUIRE(bin.right_->type_ == AstNode::Type::ScalarLiteral);
+  });
+
+  SECTION(RefusesDuplicatedSideEffects, {
+    auto square    = AstNode::create<AstBinExpr>(0, 1);
+    square->left_  = make_ref("x");
+    square->right_ = make_ref("x");
+
+    AstNode::Children<> decls;
+    decls.emplace_back(make_proc("sq", std::move(square), "x"));
+    decls.emplace_back(make_proc("main", make_call("sq", make_call("external"))));
+
+    const auto stats = inline_procedures(decls);
+    REQUIRE(stats.missed_ == 1);     /// sq(external()) must keep its call,
+    REQUIRE(stats.inlined_ == 0);    /// or external() would run twice.
+    REQUIRE(returned_expr(decls[1])->type_ == AstNode::Type::Call);
+  });
+
+  SECTION(RecursionIsSafe, {
+    AstNode::Children<> decls;
+    decls.emplace_back(make_proc("rec", make_call("rec")));
+
+    const auto stats = inline_procedures(decls);
+    REQUIRE(stats.inlined_ == 0);
+    REQUIRE(stats.missed_ == 1);
+    REQUIRE(returned_expr(decls[0])->type_ == AstNode::Type::Call);
+  });
+}
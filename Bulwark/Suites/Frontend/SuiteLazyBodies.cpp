@@ -0,0 +1,87 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/Parser.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/Lexer.hpp>
+#include <Bulwark/Suites/Frontend/LexerFixtures.hpp>
+#include <vector>
+#include <string>
+using namespace n19;
+using namespace n19::fixtures;
+
+static const std::string add_source =
+  "proc add(a: i32, b: i32) -> i32 {\n"
+  "  return a + b; # not a } brace\n"
+  "}\n";
+
+TEST_CASE(LazyBodies, SkipBlock) {
+  SECTION(MatchesBraces, {
+    auto lxr = create_lexer("{ f(\"}\"); # }\n { '}' } } after");
+    REQUIRE(lxr->current() == TokenType::LeftBrace);
+    REQUIRE(lxr->skip_block().has_value());
+    REQUIRE(lxr->current() == TokenType::Identifier);
+    REQUIRE(lxr->current().value(*lxr).value() == "after");
+    REQUIRE(lxr->current().line_ == 2);
+  });
+
+  SECTION(SkipsBacktickStrings, {
+    auto lxr = create_lexer("{ f(`}`); } after");
+    REQUIRE(lxr->skip_block().has_value());
+    REQUIRE(lxr->current().value(*lxr).value() == "after");
+  });
+
+  SECTION(RejectsUnterminated, {
+    auto lxr = create_lexer("{ { }");
+    REQUIRE(!lxr->skip_block().has_value());
+  });
+}
+
+TEST_CASE(LazyBodies, Parsing) {
+  SECTION(EagerBody, {
+    auto lxr = create_lexer(add_source);
+    ErrorCollector errors;
+    EntityTable table(_nstr("MyTable"));
+    ParseContext ctx(errs(), errors, *lxr, table);
+
+    REQUIRE(parse(ctx));
+    REQUIRE(ctx.toplevel_decls_.size() == 1);
+
+    auto& proc = static_cast<AstProcDecl&>(*ctx.toplevel_decls_[0]);
+    REQUIRE(proc.lazy_body_ == nullptr);
+    REQUIRE(proc.arg_decls_.size() == 2);
+    REQUIRE(proc.body_.size() == 1);
+    REQUIRE(proc.body_[0]->type_ == AstNode::Type::Return);
+
+    auto ent = Entity::try_cast<Proc>(table.lookup("::add"));
+    REQUIRE(ent != nullptr);
+    REQUIRE(ent->parameters_.size() == 2);
+    REQUIRE(ent->return_type_ == BuiltinType::I32);
+  });
+
+  SECTION(SkippedThenParsed, {
+    auto lxr = create_lexer(add_source);
+    ErrorCollector errors;
+    EntityTable table(_nstr("MyTable"));
+    ParseContext ctx(errs(), errors, *lxr, table);
+    ctx.lazy_bodies_ = true;
+
+    REQUIRE(parse(ctx));
+    REQUIRE(ctx.toplevel_decls_.size() == 1);
+
+    auto& proc = static_cast<AstProcDecl&>(*ctx.toplevel_decls_[0]);
+    REQUIRE(proc.lazy_body_ != nullptr);
+    REQUIRE(proc.lazy_body_->src_ == lxr->buf_);
+    REQUIRE(proc.body_.empty());
+    REQUIRE(table.lookup("::add") != nullptr);
+
+    REQUIRE(parse_bodies(ctx.toplevel_decls_, ctx));
+    REQUIRE(proc.lazy_body_ == nullptr);
+    REQUIRE(proc.body_.size() == 1);
+    REQUIRE(proc.body_[0]->type_ == AstNode::Type::Return);
+    REQUIRE(proc.body_[0]->line_ == 2);
+  });
+}
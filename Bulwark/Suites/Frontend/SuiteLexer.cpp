@@ -5,20 +5,12 @@
 
 #include <Bulwark/Bulwark.hpp>
 #include <Frontend/Lexer.hpp>
+#include <Bulwark/Suites/Frontend/LexerFixtures.hpp>
 #include <Frontend/Token.hpp>
 #include <vector>
 #include <string>
 using namespace n19;
-
-static auto create_lexer(const std::string& source) -> std::shared_ptr<Lexer> {
-  std::vector<char8_t> buffer;
-  buffer.reserve(source.size());
-  for(auto c : source) {
-    buffer.push_back(static_cast<char8_t>(c));
-  }
-
-  return Lexer::create_shared(std::move(buffer)).value();
-}
+using namespace n19::fixtures;
 
 TEST_CASE(Lexer, BasicTokenRecognition) {
   SECTION(SimpleTokens, {
@@ -0,0 +1,168 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/ModuleInterface.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <string>
+#include <vector>
+using namespace n19;
+
+///
+/// Copies the interface at path, letting fn change the named
+/// record and the bytes around it. Returns the copy's path.
+template<typename F>
+static auto patch_record_(const sys::String& path, const std::string& name, F&& fn) -> sys::String {
+  std::vector<char> bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+
+  detail_::IfaceHeader header{};
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  for(uint32_t i = 0; i < header.num_records_; i++) {
+    detail_::IfaceRecord rec{};
+    char* at = bytes.data() + header.records_off_ + i * sizeof(rec);
+    std::memcpy(&rec, at, sizeof(rec));
+    if(std::string(bytes.data() + header.strings_off_ + rec.name_off_, rec.name_len_) != name) continue;
+
+    fn(bytes, header, rec);
+    std::memcpy(at, &rec, sizeof(rec));
+    break;
+  }
+
+  const auto copy = path + _nstr(".corrupt");
+  std::ofstream out(copy, std::ios::binary);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  return copy;
+}
+
+TEST_CASE(ModuleInterface, RoundTrip) {
+  const auto path = (std::filesystem::temp_directory_path() / "n19_suite_iface.n19i").native();
+
+  {
+    EntityTable exporter(_nstr("exporter"));
+    auto ns   = exporter.insert<Static>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "ns");
+    auto node = exporter.insert<Struct>(ns->id_, 10, 2, _nstr("file"), "Node");
+    auto proc = exporter.insert<Proc>(ns->id_, 20, 3, _nstr("file"), "walk");
+    auto unused = exporter.insert<Struct>(N19_ROOT_ENTITY_ID, 30, 4, _nstr("file"), "Unused");
+    REQUIRE(ns && node && proc && unused);
+
+    Struct::Member next;
+    next.name_            = "next";
+    next.type_id_         = node->id_;
+    next.quals_.ptr_depth_ = 1;
+    node->members_.emplace_back(next);
+    proc->return_type_ = node->id_;
+
+    REQUIRE(ModuleInterface::write(exporter, path).has_value());
+    REQUIRE(!std::filesystem::exists(path + _nstr(".tmp")));
+  }
+
+  SECTION(LazyMaterialization, {
+    auto iface = ModuleInterface::open(path, _nstr("file"));
+    REQUIRE(iface.has_value());
+    REQUIRE((*iface)->num_records() == 4);
+    REQUIRE((*iface)->num_materialized() == 0);
+
+    EntityTable importer(_nstr("importer"));
+    importer.imports_.emplace_back(*iface);
+
+    auto proc = Entity::try_cast<Proc>(importer.lookup("::ns::walk"));
+    REQUIRE(proc);
+    REQUIRE(proc->name_ == "::ns::walk");
+
+    /// The namespace, the proc and the struct it returns.
+    /// "::Unused" is never touched, so it's never inserted.
+    REQUIRE((*iface)->num_materialized() == 3);
+    REQUIRE(importer.lookup_local("::Unused") == nullptr);
+
+    auto node = Entity::try_cast<Struct>(importer.find(proc->return_type_));
+    REQUIRE(node);
+    REQUIRE(node->name_ == "::ns::Node");
+    REQUIRE(node->members_.size() == 1);
+    REQUIRE(node->members_[0].type_id_ == node->id_);
+    REQUIRE(node->members_[0].quals_.ptr_depth_ == 1);
+
+    /// A second lookup hits the importer's own table.
+    REQUIRE(importer.lookup("::ns::Node")->id_ == node->id_);
+    REQUIRE((*iface)->num_materialized() == 3);
+    REQUIRE(importer.lookup("::ns::missing") == nullptr);
+  });
+
+  SECTION(MaterializeAll, {
+    auto iface = ModuleInterface::open(path, _nstr("file"));
+    REQUIRE(iface.has_value());
+
+    EntityTable importer(_nstr("importer"));
+    REQUIRE((*iface)->materialize_all(importer).has_value());
+    REQUIRE((*iface)->num_materialized() == 4);
+    REQUIRE(importer.lookup_local("::Unused") != nullptr);
+    REQUIRE(importer.lookup_local("::ns::walk") != nullptr);
+  });
+
+  SECTION(RemovedIdsAreForgotten, {
+    auto iface = ModuleInterface::open(path, _nstr("file"));
+    REQUIRE(iface.has_value());
+
+    EntityTable importer(_nstr("importer"));
+    importer.imports_.emplace_back(*iface);
+    const auto unused = importer.lookup("::Unused");
+    REQUIRE(unused != nullptr);
+    REQUIRE(importer.remove(unused->id_) == 1);
+    REQUIRE((*iface)->num_materialized() == 0);
+
+    /// The freed ID goes to the next entity inserted, the
+    /// interface mustn't hand that one out as "::Unused".
+    auto squatter = importer.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("importer"), "squatter");
+    REQUIRE(squatter->id_ == unused->id_);
+
+    const auto again = importer.lookup("::Unused");
+    REQUIRE(again != nullptr);
+    REQUIRE(again->id_ != squatter->id_);
+    REQUIRE(again->type_ == EntityType::Struct);
+    REQUIRE((*iface)->num_materialized() == 1);
+  });
+
+  SECTION(CorruptExtra, {
+    /// Point the first member's name far past the string pool.
+    const auto corrupt = patch_record_(path, "::ns::Node", [](std::vector<char>& bytes,
+      const detail_::IfaceHeader& header, detail_::IfaceRecord& rec) {
+      const uint32_t name_len = 0x7fffffff;
+      std::memcpy(bytes.data() + header.extra_off_ + (rec.extra_off_ + 2) * sizeof(uint32_t), &name_len, sizeof(name_len));
+    });
+
+    auto iface = ModuleInterface::open(corrupt, _nstr("file"));
+    REQUIRE(iface.has_value());
+    EntityTable importer(_nstr("importer"));
+    REQUIRE(!(*iface)->resolve(importer, "::ns::Node").has_value());
+
+    /// Nothing half decoded is left behind to be found later.
+    REQUIRE(importer.lookup_local("::ns::Node") == nullptr);
+    REQUIRE(!(*iface)->resolve(importer, "::ns::Node").has_value());
+    std::filesystem::remove(corrupt);
+  });
+
+  SECTION(ExtraOutOfBounds, {
+    const auto corrupt = patch_record_(path, "::ns::Node", [](std::vector<char>&,
+      const detail_::IfaceHeader& header, detail_::IfaceRecord& rec) {
+      rec.extra_off_ = header.num_extra_;
+    });
+
+    auto iface = ModuleInterface::open(corrupt, _nstr("file"));
+    REQUIRE(iface.has_value());
+    EntityTable importer(_nstr("importer"));
+    REQUIRE(!(*iface)->resolve(importer, "::ns::Node").has_value());
+    REQUIRE(importer.lookup_local("::ns::Node") == nullptr);
+    std::filesystem::remove(corrupt);
+  });
+
+  std::filesystem::remove(path);
+}
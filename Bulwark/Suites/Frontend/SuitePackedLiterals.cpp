@@ -0,0 +1,119 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/Parser.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/Lexer.hpp>
+#include <Bulwark/Suites/Frontend/LexerFixtures.hpp>
+#include <Core/Stats.hpp>
+#include <algorithm>
+#include <vector>
+#include <string>
+using namespace n19;
+using namespace n19::fixtures;
+
+static auto tokens_lexed() -> uint64_t {
+  const auto all = stats::snapshot();
+  const auto it  = std::ranges::find(all, "lexer.tokens", &std::pair<std::string_view, uint64_t>::first);
+  return it != all.end() ? it->second : 0;
+}
+
+static auto parse_aggregate(const std::string& source, const size_t min_elems) -> AstNode::Ptr<> {
+  auto lxr = create_lexer(source);
+  ErrorCollector errors;
+  EntityTable table(_nstr("MyTable"));
+  ParseContext ctx(errs(), errors, *lxr, table);
+  ctx.packed_min_elems_ = min_elems;
+
+  auto node = detail_::parse_aggregate_lit_(ctx);
+  return node.has_value() ? std::move(*node) : nullptr;
+}
+
+TEST_CASE(PackedLiterals, Packing) {
+  SECTION(Integers, {
+    auto node = parse_aggregate("{1, 0x10, 017,\n -2, 18446744073709551615}", 1);
+    REQUIRE(node != nullptr);
+
+    const auto& agg = static_cast<AstAggregateLiteral&>(*node);
+    REQUIRE(agg.children_.empty());
+    REQUIRE(agg.packed_ != nullptr);
+    REQUIRE(agg.packed_->kind_ == AstScalarLiteral::IntLit);
+    REQUIRE(agg.packed_->has_negatives_);
+    REQUIRE((agg.packed_->ints_ == std::vector<uint64_t>{1, 16, 15, static_cast<uint64_t>(-2), UINT64_MAX}));
+    REQUIRE(agg.packed_->pos_[1] == 4);
+    REQUIRE(agg.packed_->line_of(2) == 1);
+    REQUIRE(agg.packed_->line_of(3) == 2);
+    REQUIRE(agg.packed_->line_of(4) == 2);
+  });
+
+  SECTION(Floats, {
+    auto node = parse_aggregate("{1.5, -2.25, 3e2,}", 1);
+    REQUIRE(node != nullptr);
+
+    const auto& agg = static_cast<AstAggregateLiteral&>(*node);
+    REQUIRE(agg.packed_ != nullptr);
+    REQUIRE((agg.packed_->floats_ == std::vector<double>{1.5, -2.25, 300.0}));
+    REQUIRE(agg.packed_->ints_.empty());
+  });
+
+  SECTION(Cloned, {
+    auto node = parse_aggregate("{true, false, true}", 1);
+    REQUIRE(node != nullptr);
+
+    auto copy = ast_clone(*node);
+    const auto& agg = static_cast<AstAggregateLiteral&>(*copy);
+    REQUIRE(agg.packed_ != nullptr);
+    REQUIRE(agg.packed_->kind_ == AstScalarLiteral::BoolLit);
+    REQUIRE((agg.packed_->ints_ == std::vector<uint64_t>{1, 0, 1}));
+  });
+}
+
+TEST_CASE(PackedLiterals, Fallback) {
+  SECTION(MixedKinds, {
+    auto node = parse_aggregate("{1, 2.0, 3}", 1);
+    REQUIRE(node != nullptr);
+
+    const auto& agg = static_cast<AstAggregateLiteral&>(*node);
+    REQUIRE(agg.packed_ == nullptr);
+    REQUIRE(agg.children_.size() == 3);
+  });
+
+  SECTION(NonLiterals, {
+    auto node = parse_aggregate("{1, 2 + 3, 4}", 1);
+    REQUIRE(node != nullptr);
+    REQUIRE(static_cast<AstAggregateLiteral&>(*node).packed_ == nullptr);
+  });
+
+  SECTION(BelowThreshold, {
+    auto node = parse_aggregate("{1, 2, 3}", 4);
+    REQUIRE(node != nullptr);
+
+    const auto& agg = static_cast<AstAggregateLiteral&>(*node);
+    REQUIRE(agg.packed_ == nullptr);
+    REQUIRE(agg.children_.size() == 3);
+    REQUIRE(agg.children_[0]->type_ == AstNode::Type::ScalarLiteral);
+  });
+
+#ifndef N19_DISABLE_STATS
+  SECTION(RejectedWithoutLexing, {
+    /// Too few elements, and a call: neither is lexed
+    /// by the fast path before the general one takes over.
+    for(const auto* source : {"{1, 2, 3}", "{f(1), 2, 3, 4, 5}"}) {
+      auto lxr = create_lexer(source);
+      ErrorCollector errors;
+      EntityTable table(_nstr("MyTable"));
+      ParseContext ctx(errs(), errors, *lxr, table);
+      ctx.packed_min_elems_ = 4;
+
+      const uint64_t before = tokens_lexed();
+      REQUIRE(detail_::parse_packed_lit_(ctx) == nullptr);
+      REQUIRE(tokens_lexed() == before);
+      REQUIRE(lxr->current() == TokenType::LeftBrace);
+    }
+  });
+#endif
+}
@@ -0,0 +1,175 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/Parser.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/Lexer.hpp>
+#include <Bulwark/Suites/Frontend/LexerFixtures.hpp>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <thread>
+using namespace n19;
+using namespace n19::fixtures;
+
+TEST_CASE(ParallelParse, PreScan) {
+  SECTION(FindsBoundaries, {
+    auto lxr = create_lexer(
+      "proc f() { let s = \"}\"; } # not a { brace\n"
+      "let y = {1, (2)};\n"
+      "namespace a { let z = 3; }\n");
+
+    auto ranges = detail_::scan_toplevel_(*lxr);
+    REQUIRE(ranges.has_value());
+    REQUIRE(ranges->size() == 3);
+    REQUIRE((*ranges)[0].first_ == TokenType::Proc);
+    REQUIRE((*ranges)[1].first_ == TokenType::Let);
+    REQUIRE((*ranges)[2].first_ == TokenType::Namespace);
+    REQUIRE((*ranges)[0].end_ == (*ranges)[1].first_.pos_);
+    REQUIRE((*ranges)[1].end_ == (*ranges)[2].first_.pos_);
+    REQUIRE((*ranges)[0].idents_ == 2);
+    REQUIRE(lxr->current() == TokenType::EndOfFile);
+  });
+
+  SECTION(RejectsUnbalanced, {
+    auto open = create_lexer("proc f() { let x = 1;");
+    REQUIRE(!detail_::scan_toplevel_(*open).has_value());
+
+    auto stray = create_lexer("let x = 1; }");
+    REQUIRE(!detail_::scan_toplevel_(*stray).has_value());
+  });
+}
+
+TEST_CASE(ParallelParse, LexerLimit) {
+  SECTION(StopsAtLimit, {
+    auto lxr = create_lexer("alpha beta gamma");
+    lxr->limit_ = 6;
+    lxr->seek(0, 1);
+    REQUIRE(lxr->current() == TokenType::Identifier);
+    REQUIRE(lxr->consume(1) == TokenType::EndOfFile);
+
+    lxr->limit_ = UINT32_MAX;
+    lxr->seek(6, 1);
+    REQUIRE(lxr->current().value(*lxr).value() == "beta");
+  });
+}
+
+TEST_CASE(ParallelParse, EntityIds) {
+  SECTION(ReservedRangesAreDeterministic, {
+    EntityTable table(_nstr("MyTable"));
+    auto first  = table.reserve_ids(4);
+    auto second = table.reserve_ids(4);
+    REQUIRE(first.end_ == second.next_);
+
+    const auto first_id  = first.next_;
+    const auto second_id = second.next_;
+
+    table.set_concurrent(true);
+    std::thread worker([&] {
+      EntityTable::IdScope scope(table, second);
+      table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "c");
+      table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "d");
+    });
+
+    {
+      EntityTable::IdScope scope(table, first);
+      table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "a");
+      table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "b");
+    }
+
+    worker.join();
+    table.set_concurrent(false);
+
+    REQUIRE(table.lookup("::a")->id_ == first_id);
+    REQUIRE(table.lookup("::b")->id_ == first_id + 1);
+    REQUIRE(table.lookup("::c")->id_ == second_id);
+    REQUIRE(table.lookup("::d")->id_ == second_id + 1);
+
+    const auto& children = table.root_->chldrn_;
+    REQUIRE(std::ranges::is_sorted(children));
+    REQUIRE(table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "e")->id_ == second.end_);
+  });
+}
+
+TEST_CASE(ParallelParse, ChildOrder) {
+  SECTION(FollowsDeclarationsNotIds, {
+    EntityTable table(_nstr("MyTable"));
+    const auto gone = table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "gone")->id_;
+    const auto kept = table.insert<Variable>(N19_ROOT_ENTITY_ID, 2, 1, _nstr("file"), "kept")->id_;
+    REQUIRE(table.remove(gone) == 1);
+
+    /// "later" reuses the freed ID, below both of the others.
+    table.set_concurrent(true);
+    const auto later  = table.insert<Variable>(N19_ROOT_ENTITY_ID, 30, 3, _nstr("file"), "later")->id_;
+    const auto sooner = table.insert<Variable>(N19_ROOT_ENTITY_ID, 20, 2, _nstr("file"), "sooner")->id_;
+    table.set_concurrent(false);
+    REQUIRE(later == gone);
+
+    const auto& children = table.root_->chldrn_;
+    REQUIRE(children.size() >= 3);
+    REQUIRE((std::vector<Entity::ID>(children.end() - 3, children.end()) == std::vector<Entity::ID>{kept, sooner, later}));
+  });
+}
+
+TEST_CASE(ParallelParse, IdScopes) {
+  SECTION(OnlySteerTheirOwnTable, {
+    EntityTable table(_nstr("MyTable"));
+    EntityTable other(_nstr("Other"));
+    auto range = table.reserve_ids(4);
+    const auto reserved = range.next_;
+
+    EntityTable::IdScope scope(table, range);
+    const auto id = other.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "o")->id_;
+    REQUIRE(range.next_ == reserved);
+    REQUIRE(id == BuiltinType::AfterLastID);
+    REQUIRE(table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "t")->id_ == reserved);
+  });
+}
+
+TEST_CASE(ParallelParse, MatchesSequential) {
+  SECTION(StopsAtFirstFailure, {
+    const std::string source = "1;\n2;\n3;\n";
+    NullOStream null;
+
+    for(const size_t threads : {size_t{1}, size_t{3}}) {
+      auto lxr = create_lexer(source);
+      ErrorCollector errors;
+      EntityTable table(_nstr("MyTable"));
+      ParseContext ctx(null, errors, *lxr, table);
+      ctx.threads_ = threads;
+      ctx.parallel_min_bytes_ = 0;
+
+      REQUIRE(!parse(ctx));
+      REQUIRE(ctx.toplevel_decls_.empty());
+    }
+  });
+
+  SECTION(TypeNamesSeeEarlierDecls, {
+    const std::string source =
+      "proc a(x: b) {}\n"
+      "proc b() {}\n"
+      "proc c(y: b) -> b {}\n";
+    NullOStream null;
+
+    for(const size_t threads : {size_t{1}, size_t{3}}) {
+      auto lxr = create_lexer(source);
+      ErrorCollector errors;
+      EntityTable table(_nstr("MyTable"));
+      ParseContext ctx(null, errors, *lxr, table);
+      ctx.threads_ = threads;
+      ctx.parallel_min_bytes_ = 0;
+      REQUIRE(parse(ctx));
+
+      const auto b = table.lookup("::b");
+      const auto a = Entity::cast<Proc>(table.lookup("::a"));
+      const auto c = Entity::cast<Proc>(table.lookup("::c"));
+      REQUIRE(b != nullptr);
+      REQUIRE(Entity::cast<Variable>(table.find_direct(a->parameters_[0]))->type_ == N19_INVALID_ENTITY_ID);
+      REQUIRE(Entity::cast<Variable>(table.find_direct(c->parameters_[0]))->type_ == b->id_);
+      REQUIRE(c->return_type_ == b->id_);
+    }
+  });
+}
@@ -0,0 +1,255 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/PassManager.hpp>
+#include <Frontend/Passes.hpp>
+#include <Bulwark/Suites/Frontend/AstFixtures.hpp>
+using namespace n19;
+using namespace n19::fixtures;
+
+/// proc <name>() { return 1; 2; external(); }
+static auto make_dead_tail(const std::string& name) -> AstNode::Ptr<> {
+  auto proc = make_proc(name);
+  proc->body_.emplace_back(make_return(make_lit("1")));
+  proc->body_.emplace_back(make_lit("2"));
+  proc->body_.emplace_back(make_call("external"));
+  return proc;
+}
+
+TEST_CASE(PassManager, Analyses) {
+  SECTION(ControlFlowReachability, {
+    AstNode::Children<> decls;
+    decls.emplace_back(make_dead_tail("f"));
+    auto& proc = static_cast<AstProcDecl&>(*decls[0]);
+
+    const auto cfg = ControlFlowGraph::compute(proc);
+    REQUIRE(cfg.is_reachable(proc.body_[0].get()));
+    REQUIRE(!cfg.is_reachable(proc.body_[1].get()));
+    REQUIRE(!cfg.is_reachable(proc.body_[2].get()));
+  });
+
+  SECTION(CachedUntilInvalidated, {
+    auto proc = make_proc("f");
+    proc->body_.emplace_back(make_return(make_ref("x")));
+
+    AnalysisCache cache(*proc);
+    REQUIRE(cache.use_def().find("x") != nullptr);
+    REQUIRE(cache.use_def().find("x")->uses_.size() == 1);
+    REQUIRE(cache.num_computed() == 1);
+
+    cache.invalidate(AnalysisCache::All);
+    (void)cache.use_def();
+    REQUIRE(cache.num_computed() == 1);
+
+    cache.invalidate(AnalysisCache::Scopes | AnalysisCache::ControlFlow);
+    (void)cache.use_def();
+    REQUIRE(cache.num_computed() == 2);
+  });
+}
+
+TEST_CASE(PassManager, Passes) {
+  SECTION(DeadCodeAfterReturn, {
+    AstNode::Children<> decls;
+    decls.emplace_back(make_dead_tail("f"));
+
+    PassManager manager;
+    manager.add<DeadCodePass>().run(decls);
+
+    auto& proc = static_cast<AstProcDecl&>(*decls[0]);
+    REQUIRE(proc.body_.size() == 1);
+    REQUIRE(proc.body_[0]->type_ == AstNode::Type::Return);
+    REQUIRE(manager.timing(0).changed_ == 1);
+  });
+
+  SECTION(DeadStores, {
+    auto var    = AstNode::create<AstVardecl>(0, 1);
+    var->name_  = make_ref("y");
+
+    auto store       = AstNode::create<AstBinExpr>(0, 1);
+    store->op_type_  = TokenType::ValueAssignment;
+    store->left_     = make_ref("y");
+    store->right_    = make_lit("5");
+
+    AstNode::Children<> decls;
+    auto proc = make_proc("f");
+    proc->body_.emplace_back(std::move(var));
+    proc->body_.emplace_back(std::move(store));
+    proc->body_.emplace_back(make_return(make_lit("0")));
+    decls.emplace_back(std::move(proc));
+
+    PassManager manager;
+    manager.add<DeadCodePass>().run(decls);
+
+    auto& body = static_cast<AstProcDecl&>(*decls[0]).body_;
+    REQUIRE(body.size() == 1);
+    REQUIRE(body[0]->type_ == AstNode::Type::Return);
+  });
+
+  SECTION(DoWhileThatReturns, {
+    /// do { return x; } while(c); return 0;
+    auto loop        = AstNode::create<AstWhile>(0, 1);
+    loop->is_dowhile = true;
+    loop->cond_      = make_ref("c");
+    loop->body_.emplace_back(make_return(make_ref("x")));
+
+    AstNode::Children<> decls;
+    auto proc = make_proc("f");
+    proc->body_.emplace_back(std::move(loop));
+    proc->body_.emplace_back(make_return(make_lit("0")));
+    decls.emplace_back(std::move(proc));
+
+    PassManager manager;
+    manager.add<DeadCodePass>().run(decls);
+
+    auto& body = static_cast<AstProcDecl&>(*decls[0]).body_;
+    REQUIRE(body.size() == 1);
+    REQUIRE(body[0]->type_ == AstNode::Type::While);
+    REQUIRE(static_cast<AstWhile&>(*body[0]).body_.size() == 1);
+  });
+
+  SECTION(FoldsConstantBranches, {
+    auto branch = AstNode::create<AstBranch>(0, 1);
+    branch->if_ = AstNode::create<AstIf>(0, 1, branch.get());
+    branch->if_->condition_ = make_lit("true", true);
+    branch->if_->body_.emplace_back(make_call("taken"));
+    branch->else_ = AstNode::create<AstElse>(0, 1, branch.get());
+    branch->else_->body_.emplace_back(make_call("not_taken"));
+
+    AstNode::Children<> decls;
+    auto proc = make_proc("f");
+    proc->body_.emplace_back(std::move(branch));
+    decls.emplace_back(std::move(proc));
+
+    PassManager manager;
+    manager.add<SimplifyCfgPass>().run(decls);
+
+    auto& body = static_cast<AstProcDecl&>(*decls[0]).body_;
+    REQUIRE(body.size() == 1);
+    REQUIRE(body[0]->type_ == AstNode::Type::Call);
+    REQUIRE(body[0]->parent_ == decls[0].get());
+  });
+}
+
+///
+/// Drops the last toplevel declaration.
+class DropLastPass_ final : public ModulePass {
+public:
+  NODISCARD_ auto name() const -> std::string_view override { return "drop-last"; }
+  auto run(AstNode::Children<>& decls) -> uint8_t override {
+    decls.pop_back();
+    return AnalysisCache::None;
+  }
+};
+
+TEST_CASE(PassManager, Pipelines) {
+  SECTION(ParallelFunctionPasses, {
+    AstNode::Children<> decls;
+    for(int i = 0; i < 64; i++) {
+      decls.emplace_back(make_dead_tail("f" + std::to_string(i)));
+    }
+
+    auto manager = PassManager::for_level(1);
+    manager.threads_ = 4;
+    manager.run(decls);
+
+    REQUIRE(manager.num_passes() == 2);
+    REQUIRE(manager.timing(1).runs_ == 64);
+    REQUIRE(manager.timing(1).changed_ == 64);
+    for(auto& decl : decls) {
+      REQUIRE(static_cast<AstProcDecl&>(*decl).body_.size() == 1);
+    }
+  });
+
+  SECTION(LevelZeroDoesNothing, {
+    AstNode::Children<> decls;
+    decls.emplace_back(make_dead_tail("f"));
+
+    auto manager = PassManager::for_level(0);
+    manager.run(decls);
+
+    REQUIRE(manager.num_passes() == 0);
+    REQUIRE(static_cast<AstProcDecl&>(*decls[0]).body_.size() == 3);
+  });
+
+  SECTION(ModulePassRemovesProcs, {
+    AstNode::Children<> decls;
+    for(int i = 0; i < 4; i++) {
+      decls.emplace_back(make_dead_tail("f" + std::to_string(i)));
+    }
+
+    /// The second group must only see what's left.
+    PassManager manager;
+    manager
+      .add<SimplifyCfgPass>()
+      .add<DropLastPass_>()
+      .add<DeadCodePass>();
+    manager.run(decls);
+
+    REQUIRE(decls.size() == 3);
+    REQUIRE(manager.timing(0).runs_ == 4);
+    REQUIRE(manager.timing(2).runs_ == 3);
+    REQUIRE(manager.timing(2).changed_ == 3);
+  });
+}
+
+static auto a_plus_b() -> AstNode::Ptr<> {
+  return make_bin(TokenType::Plus, make_ref("a"), make_ref("b"));
+}
+
+TEST_CASE(PassManager, ExprDag) {
+  SECTION(SharesRepeatedExprs, {
+    /// return (a + b) * (a + b); x = a + b; g(a + b);
+    auto proc  = make_proc("f");
+    auto call  = AstNode::create<AstCall>(0, 1);
+    call->target_ = make_ref("g");
+    call->arguments_.emplace_back(a_plus_b());
+
+    proc->body_.emplace_back(make_return(make_bin(TokenType::Mul, a_plus_b(), a_plus_b())));
+    proc->body_.emplace_back(make_bin(TokenType::ValueAssignment, make_ref("x"), a_plus_b()));
+    proc->body_.emplace_back(std::move(call));
+
+    const auto dag = ExprDag::compute(*proc);
+    const auto& ret   = static_cast<AstReturn&>(*proc->body_[0]);
+    const auto& mul   = static_cast<AstBinExpr&>(*ret.value_);
+    const auto& store = static_cast<AstBinExpr&>(*proc->body_[1]);
+    const auto& args  = static_cast<AstCall&>(*proc->body_[2]).arguments_;
+
+    const auto sum = dag.id_of(mul.left_.get());
+    REQUIRE(sum != ExprDag::none_);
+    REQUIRE(dag.id_of(mul.right_.get()) == sum);
+    REQUIRE(dag.id_of(store.right_.get()) == sum);
+    REQUIRE(dag.id_of(args[0].get()) == sum);
+    REQUIRE(dag.id_of(&store) == ExprDag::none_);
+    REQUIRE(dag.id_of(proc->body_[2].get()) == ExprDag::none_);
+
+    /// a, b, a + b, (a + b) * (a + b), x and g.
+    REQUIRE(dag.nodes_.size() == 6);
+    REQUIRE(dag.nodes_[dag.id_of(&mul)].lhs_ == sum);
+  });
+
+  SECTION(DistinguishesStructure, {
+    ExprDag dag;
+    auto lhs = make_bin(TokenType::Sub, make_ref("a"), make_ref("b"));
+    auto rhs = make_bin(TokenType::Sub, make_ref("b"), make_ref("a"));
+    auto lit = make_lit("1");
+    auto boolean = make_lit("1", true);
+
+    REQUIRE(dag.intern(*lhs) != dag.intern(*rhs));
+    REQUIRE(dag.intern(*lit) != dag.intern(*boolean));
+    REQUIRE(dag.intern(*make_call("g")) == ExprDag::none_);
+  });
+
+  SECTION(Cached, {
+    auto proc = make_proc("f");
+    proc->body_.emplace_back(make_return(a_plus_b()));
+
+    AnalysisCache cache(*proc);
+    REQUIRE(cache.exprs().nodes_.size() == 3);
+    cache.invalidate(AnalysisCache::All);
+    REQUIRE(cache.exprs().nodes_.size() == 3);
+    REQUIRE(cache.num_computed() == 1);
+  });
+}
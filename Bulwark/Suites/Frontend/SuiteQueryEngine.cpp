@@ -0,0 +1,159 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/QueryEngine.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <IO/Stream.hpp>
+using namespace n19;
+
+TEST_CASE(QueryEngine, Queries) {
+  SECTION(Basic, {
+    EntityTable table(EntityTable::builtins(), _nstr("main"));
+    TypeTable types(&table);
+    QueryEngine queries(table, types);
+
+    auto s = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("a"), "S");
+    s->members_.emplace_back("x", EntityQualifierBase{}, BuiltinType::I32);
+    auto v = table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("b"), "v");
+    v->type_ = s->id_;
+    v->quals_.ptr_depth_ = 1;
+
+    EntityQualifierBase ptr;
+    ptr.ptr_depth_ = 1;
+    REQUIRE(queries.type_of(v->id_).value() == types.intern(s->id_, ptr));
+    REQUIRE(queries.type_of(v->id_).value() == types.intern(s->id_, ptr));
+    REQUIRE(queries.counts(QueryEngine::TypeOf).computed_ == 1);
+    REQUIRE(queries.counts(QueryEngine::TypeOf).hits_ == 1);
+
+    const auto members = queries.members_of(s->id_);
+    REQUIRE(members.has_value());
+    REQUIRE(members.value().size() == 1);
+    REQUIRE(members.value()[0].name_ == "x");
+    REQUIRE(members.value()[0].type_ == types.intern(BuiltinType::I32, {}));
+
+    REQUIRE(!queries.members_of(v->id_).has_value());
+    REQUIRE(queries.resolve(N19_ROOT_ENTITY_ID, "S").value() == s->id_);
+    REQUIRE(queries.resolve(N19_ROOT_ENTITY_ID, "nope").value() == N19_INVALID_ENTITY_ID);
+  });
+
+  SECTION(OnlyAffectedRecompute, {
+    EntityTable table(EntityTable::builtins(), _nstr("main"));
+    TypeTable types(&table);
+    QueryEngine queries(table, types);
+
+    auto s = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("a"), "S");
+    auto v = table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("b"), "v");
+    v->type_ = BuiltinType::I64;
+
+    REQUIRE(queries.members_of(s->id_).has_value());
+    REQUIRE(queries.type_of(v->id_).has_value());
+
+    /// Nothing "a" owns changed.
+    queries.touch(_nstr("b"));
+    REQUIRE(queries.members_of(s->id_).has_value());
+    REQUIRE(queries.counts(QueryEngine::MembersOf).computed_ == 1);
+    REQUIRE(queries.counts(QueryEngine::MembersOf).validated_ == 1);
+
+    v->type_ = BuiltinType::U8;
+    REQUIRE(queries.type_of(v->id_).value() == types.intern(BuiltinType::U8, {}));
+    REQUIRE(queries.counts(QueryEngine::TypeOf).computed_ == 2);
+  });
+
+  SECTION(EarlyCutoff, {
+    EntityTable table(EntityTable::builtins(), _nstr("main"));
+    TypeTable types(&table);
+    QueryEngine queries(table, types);
+
+    auto s  = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("a"), "S");
+    auto ns = table.insert<Static>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("c"), "ns");
+    REQUIRE(queries.resolve(ns->id_, "S").value() == s->id_);
+    REQUIRE(queries.counts(QueryEngine::Resolve).computed_ == 2);
+
+    /// The root lookup is redone and comes out the same,
+    /// so the lookup from within "ns" is left alone.
+    queries.touch(_nstr("a"));
+    REQUIRE(queries.resolve(ns->id_, "S").value() == s->id_);
+    REQUIRE(queries.counts(QueryEngine::Resolve).computed_ == 3);
+    REQUIRE(queries.counts(QueryEngine::Resolve).cutoffs_ == 1);
+    REQUIRE(queries.counts(QueryEngine::Resolve).validated_ == 1);
+
+    /// Shadowing it in "ns" is noticed.
+    auto inner = table.insert<Struct>(ns->id_, 1, 1, _nstr("c"), "S");
+    queries.touch(_nstr("c"));
+    REQUIRE(queries.resolve(ns->id_, "S").value() == inner->id_);
+  });
+
+  SECTION(FileRemoved, {
+    EntityTable table(EntityTable::builtins(), _nstr("main"));
+    TypeTable types(&table);
+    QueryEngine queries(table, types);
+
+    const Entity::ID s = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("a"), "S")->id_;
+    REQUIRE(queries.resolve(N19_ROOT_ENTITY_ID, "S").value() == s);
+    REQUIRE(queries.members_of(s).has_value());
+
+    table.remove_file(_nstr("a"));
+    queries.touch(_nstr("a"));
+    REQUIRE(queries.resolve(N19_ROOT_ENTITY_ID, "S").value() == N19_INVALID_ENTITY_ID);
+    REQUIRE(!queries.members_of(s).has_value());
+  });
+
+  SECTION(LayoutsFollowMembers, {
+    EntityTable table(EntityTable::builtins(), _nstr("main"));
+    TypeTable types(&table);
+    QueryEngine queries(table, types);
+
+    auto t = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("c"), "T");
+    t->members_.emplace_back("i", EntityQualifierBase{}, BuiltinType::I32);
+    auto s = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("a"), "S");
+    s->members_.emplace_back("t", EntityQualifierBase{}, t->id_);
+    auto v = table.insert<Variable>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("b"), "v");
+    v->type_ = s->id_;
+
+    REQUIRE(types.get(queries.type_of(v->id_).value()).size_ == 4);
+    REQUIRE(types.get(queries.members_of(s->id_).value()[0].type_).size_ == 4);
+
+    /// Neither "a" nor "b" changed, but what S holds did.
+    const Entity::ID old = t->id_;
+    table.remove_file(_nstr("c"));
+    auto wide = table.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("c"), "T");
+    wide->members_.emplace_back("i", EntityQualifierBase{}, BuiltinType::I64);
+    REQUIRE(wide->id_ == old);
+
+    queries.touch(_nstr("c"));
+    REQUIRE(types.get(queries.type_of(v->id_).value()).size_ == 8);
+    REQUIRE(types.get(queries.members_of(s->id_).value()[0].type_).size_ == 8);
+  });
+
+  SECTION(Cycles, {
+    EntityTable table(EntityTable::builtins(), _nstr("main"));
+    TypeTable types(&table);
+    QueryEngine queries(table, types);
+
+    auto a = table.insert<AliasType>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("a"), "A");
+    auto b = table.insert<AliasType>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("a"), "B");
+    a->link_ = b->id_;
+    b->link_ = a->id_;
+    REQUIRE(!queries.type_of(a->id_).has_value());
+
+    /// Errors aren't memoized: fixing the cycle is enough.
+    b->link_ = BuiltinType::I32;
+    queries.touch(_nstr("a"));
+    REQUIRE(queries.type_of(a->id_).value() == types.intern(BuiltinType::I32, {}));
+  });
+
+  SECTION(Stats, {
+    EntityTable table(EntityTable::builtins(), _nstr("main"));
+    TypeTable types(&table);
+    QueryEngine queries(table, types);
+    REQUIRE(queries.type_of(BuiltinType::I32).has_value());
+
+    StringOStream out;
+    queries.dump_stats(out);
+    REQUIRE(out.str_.find("type_of") != std::string::npos);
+    REQUIRE(out.str_.find("resolve") != std::string::npos);
+  });
+}
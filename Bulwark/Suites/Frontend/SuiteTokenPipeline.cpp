@@ -0,0 +1,163 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/Parser.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/Lexer.hpp>
+#include <Bulwark/Suites/Frontend/LexerFixtures.hpp>
+#include <Frontend/TokenPipeline.hpp>
+#include <vector>
+#include <string>
+#include <utility>
+using namespace n19;
+using namespace n19::fixtures;
+
+static auto long_source(const size_t procs) -> std::string {
+  std::string source;
+  for(size_t i = 0; i < procs; i++) {
+    const auto n = std::to_string(i);
+    source += "proc f" + n + "(a: i32) -> i32 {\n  return a + " + n + "; # not a } brace\n}\n";
+  }
+
+  return source;
+}
+
+static auto same_token(const Token& lhs, const Token& rhs) -> bool {
+  return lhs == rhs && lhs.pos_ == rhs.pos_ && lhs.line_ == rhs.line_ && lhs.len_ == rhs.len_;
+}
+
+TEST_CASE(TokenPipeline, Stream) {
+  SECTION(MatchesSequential, {
+    const auto source = long_source(1000);
+    auto sequential = create_lexer(source);
+    auto piped      = create_lexer(source);
+    piped->start_pipeline();
+    REQUIRE(piped->pipe_ != nullptr);
+
+    bool same = true;
+    while(sequential->current() != TokenType::EndOfFile) {
+      same = same && same_token(sequential->current(), piped->current());
+      sequential->consume(1);
+      piped->consume(1);
+    }
+
+    REQUIRE(same);
+    REQUIRE(piped->current() == TokenType::EndOfFile);
+    REQUIRE(piped->consume(1) == TokenType::EndOfFile);
+  });
+
+  SECTION(Peeking, {
+    auto lxr = create_lexer("a b c d e");
+    lxr->start_pipeline();
+
+    const auto peeked = lxr->peek(3);
+    const auto batch  = lxr->batched_peek<8>();
+    REQUIRE(lxr->current().value(*lxr).value() == "a");
+    REQUIRE(peeked.value(*lxr).value() == "d");
+    REQUIRE(batch[3].value(*lxr).value() == "e");
+    REQUIRE(batch[4] == TokenType::EndOfFile);
+    REQUIRE(batch[7] == TokenType::EndOfFile);
+    REQUIRE(lxr->consume(3).value(*lxr).value() == "d");
+  });
+
+  SECTION(StopsWhereItWas, {
+    auto lxr = create_lexer("alpha beta gamma");
+    lxr->start_pipeline();
+    lxr->consume(1);
+    lxr->stop_pipeline();
+
+    REQUIRE(lxr->pipe_ == nullptr);
+    REQUIRE(lxr->current().value(*lxr).value() == "beta");
+    REQUIRE(lxr->consume(1).value(*lxr).value() == "gamma");
+  });
+
+  SECTION(IllegalToken, {
+    auto sequential = create_lexer("a ? b");
+    auto piped      = create_lexer("a ? b");
+    piped->start_pipeline();
+
+    bool same = true;
+    for(int i = 0; i < 4; i++) {
+      same = same && same_token(sequential->consume(1), piped->consume(1));
+    }
+
+    REQUIRE(same);
+  });
+}
+
+TEST_CASE(TokenPipeline, Rewinding) {
+  SECTION(InsideWindow, {
+    auto lxr = create_lexer(long_source(4));
+    lxr->start_pipeline();
+    lxr->consume(2);
+
+    const auto saved = lxr->current();
+    lxr->consume(10);
+    lxr->revert_before(saved);
+
+    REQUIRE(lxr->pipe_ != nullptr);
+    REQUIRE(same_token(lxr->current(), saved));
+    REQUIRE(same_token(lxr->consume(1), saved));
+
+    const auto next = lxr->consume(1);
+    lxr->seek(saved.pos_, saved.line_);
+    REQUIRE(lxr->pipe_ != nullptr);
+    REQUIRE(same_token(lxr->current(), saved));
+    REQUIRE(same_token(lxr->consume(1), next));
+  });
+
+  SECTION(OutsideWindow, {
+    auto lxr = create_lexer(long_source(1000));
+    lxr->start_pipeline();
+    lxr->consume(1);
+
+    const auto saved = lxr->current();
+    const auto next  = lxr->consume(1);
+    lxr->consume(static_cast<uint32_t>(TokenPipeline::retain_ * 3));
+    lxr->revert_before(saved);
+
+    REQUIRE(lxr->pipe_ == nullptr);
+    REQUIRE(same_token(lxr->consume(1), saved));
+    REQUIRE(same_token(lxr->consume(1), next));
+  });
+
+  SECTION(SkipBlock, {
+    auto lxr = create_lexer("{ a { b } \"}\" } c");
+    lxr->start_pipeline();
+
+    REQUIRE(lxr->skip_block().has_value());
+    REQUIRE(lxr->current().value(*lxr).value() == "c");
+    REQUIRE(lxr->consume(1) == TokenType::EndOfFile);
+  });
+}
+
+TEST_CASE(TokenPipeline, Parsing) {
+  SECTION(MatchesSequential, {
+    const auto source = long_source(500) + "proc g(a: i32) -> i32 {\n  return {1, 2, a};\n}\n";
+    NullOStream null;
+
+    std::vector<size_t> counts;
+    for(const auto [pipeline_min, lazy] : {std::pair{SIZE_MAX, false}, {size_t{0}, false}, {size_t{0}, true}}) {
+      auto lxr = create_lexer(source);
+      ErrorCollector errors;
+      EntityTable table(_nstr("MyTable"));
+      ParseContext ctx(null, errors, *lxr, table);
+      ctx.threads_ = 2;
+      ctx.parallel_min_bytes_ = SIZE_MAX;
+      ctx.pipeline_min_bytes_ = pipeline_min;
+      ctx.packed_min_elems_   = 1;
+      ctx.lazy_bodies_        = lazy;
+
+      REQUIRE(parse(ctx));
+      REQUIRE(lxr->pipe_ == nullptr);
+      counts.push_back(ctx.toplevel_decls_.size());
+    }
+
+    REQUIRE(counts[0] == 501);
+    REQUIRE(counts[0] == counts[1]);
+    REQUIRE(counts[0] == counts[2]);
+  });
+}
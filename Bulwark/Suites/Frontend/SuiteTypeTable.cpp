@@ -0,0 +1,107 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Frontend/TypeTable.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <thread>
+#include <vector>
+using namespace n19;
+
+static auto quals(const uint32_t ptr_depth, std::vector<uint32_t> lengths = {}) -> EntityQualifierBase {
+  EntityQualifierBase out;
+  out.ptr_depth_   = ptr_depth;
+  out.arr_lengths_ = std::move(lengths);
+  return out;
+}
+
+TEST_CASE(TypeTable, Interning) {
+  SECTION(EqualTypesShareAnID, {
+    TypeTable types;
+    const auto a = types.intern(BuiltinType::I32, quals(1));
+    const auto b = types.intern(BuiltinType::I32, quals(1));
+    const auto c = types.intern(BuiltinType::I32, quals(2));
+    const auto d = types.intern(BuiltinType::U32, quals(1));
+    const auto e = types.intern(BuiltinType::I32, quals(1, {4}));
+
+    REQUIRE(a != TypeTable::invalid_);
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+    REQUIRE(a != d);
+    REQUIRE(a != e);
+    REQUIRE(types.size() == 4);
+
+    auto constant = quals(1);
+    constant.flags_ |= EntityQualifierBase::Constant;
+    REQUIRE(types.intern(BuiltinType::I32, constant) != a);
+  });
+
+  SECTION(CachedProperties, {
+    TypeTable types;
+    const auto& i16 = types.get(types.intern(BuiltinType::I16, quals(0)));
+    REQUIRE(i16.size_ == 2);
+    REQUIRE(i16.align_ == 2);
+    REQUIRE(!i16.is_pointer_);
+
+    const auto& ptr = types.get(types.intern(BuiltinType::U8, quals(2)));
+    REQUIRE(ptr.size_ == TypeTable::pointer_size_);
+    REQUIRE(ptr.is_pointer_);
+
+    const auto& matrix = types.get(types.intern(BuiltinType::F32, quals(0, {3, 4})));
+    REQUIRE(matrix.size_ == 48);
+    REQUIRE(matrix.align_ == 4);
+  });
+
+  SECTION(StructsAndAliases, {
+    EntityTable entities(_nstr("MyTable"));
+    TypeTable types(&entities);
+
+    /// struct S { u8 a; i64 b; u16 c; }
+    auto s = entities.insert<Struct>(N19_ROOT_ENTITY_ID, 1, 1, _nstr("file"), "S");
+    s->members_.push_back({"a", quals(0), BuiltinType::U8});
+    s->members_.push_back({"b", quals(0), BuiltinType::I64});
+    s->members_.push_back({"c", quals(0), BuiltinType::U16});
+
+    const auto& layout = types.get(types.intern(s->id_, quals(0)));
+    REQUIRE(layout.size_ == 24);
+    REQUIRE(layout.align_ == 8);
+
+    /// type P = S*; "P[2]" is "S*[2]".
+    auto p = entities.insert<AliasType>(N19_ROOT_ENTITY_ID, 2, 2, _nstr("file"), "P");
+    p->link_  = s->id_;
+    p->quals_ = quals(1);
+
+    const auto via_alias = types.intern(p->id_, quals(0, {2}));
+    REQUIRE(via_alias == types.intern(s->id_, quals(1, {2})));
+    REQUIRE(types.get(via_alias).base_ == s->id_);
+    REQUIRE(types.get(via_alias).size_ == 2 * TypeTable::pointer_size_);
+
+    /// Containing itself by value: never complete.
+    auto r = entities.insert<Struct>(N19_ROOT_ENTITY_ID, 3, 3, _nstr("file"), "R");
+    r->members_.push_back({"self", quals(0), r->id_});
+    REQUIRE(types.get(types.intern(r->id_, quals(0))).size_ == 0);
+  });
+
+  SECTION(ConcurrentInterning, {
+    TypeTable types;
+    constexpr uint32_t per_thread = 2000;
+    std::vector<std::vector<TypeTable::ID>> seen(4);
+    std::vector<std::thread> threads;
+
+    for(size_t t = 0; t < seen.size(); t++) {
+      threads.emplace_back([&types, &seen, t] {
+        for(uint32_t i = 0; i < per_thread; i++) {
+          seen[t].push_back(types.intern(BuiltinType::I8 + i % 8, quals(i / 8)));
+        }
+      });
+    }
+
+    for(auto& thread : threads) thread.join();
+    REQUIRE(types.size() == per_thread);
+    for(size_t t = 1; t < seen.size(); t++) {
+      REQUIRE(seen[t] == seen[0]);
+    }
+  });
+}
@@ -0,0 +1,84 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Sys/DirWalk.hpp>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <string>
+using namespace n19;
+using namespace n19::sys;
+
+namespace fs = std::filesystem;
+
+static auto touch(const fs::path& path) -> void {
+  fs::create_directories(path.parent_path());
+  std::ofstream out(path, std::ios::binary);
+  out << "proc f() -> i32 {\n return 0;\n}\n";
+}
+
+TEST_CASE(DirWalk, Globs) {
+  SECTION(Wildcards, {
+    REQUIRE(glob_match(_nstr("*.n19"), _nstr("main.n19")));
+    REQUIRE(glob_match(_nstr("*.n19"), _nstr(".n19")));
+    REQUIRE(!glob_match(_nstr("*.n19"), _nstr("main.n19i")));
+    REQUIRE(glob_match(_nstr("m?in.*"), _nstr("main.n19")));
+    REQUIRE(glob_match(_nstr("*a*b*"), _nstr("xxaxxbxx")));
+    REQUIRE(!glob_match(_nstr("*a*b"), _nstr("xxaxxbxx")));
+    REQUIRE(glob_match(_nstr("*"), _nstr("")));
+    REQUIRE(!glob_match(_nstr("?"), _nstr("")));
+  });
+
+  SECTION(DerivedOutputs, {
+    const auto root = (fs::path("proj") / "src").native();
+    const auto file = (fs::path("proj") / "src" / "a" / "b.n19").native();
+    const auto out  = (fs::path("build")).native();
+    REQUIRE(derive_output_path(file, root, out, _nstr(".o")) == (fs::path("build") / "a" / "b.o").native());
+    REQUIRE(derive_output_path(file, root, _nstr(""), _nstr(".o")) == (fs::path(root) / "a" / "b.o").native());
+  });
+}
+
+TEST_CASE(DirWalk, Tree) {
+  const auto root = fs::temp_directory_path() / "n19_suite_dirwalk";
+  fs::remove_all(root);
+
+  std::vector<String> expected;
+  for(int i = 0; i < 8; i++) {
+    for(int j = 0; j < 16; j++) {
+      const auto dir  = root / ("d" + std::to_string(i)) / ("e" + std::to_string(j % 3));
+      const auto file = dir / ("f" + std::to_string(j) + ".n19");
+      touch(file);
+      touch(dir / ("f" + std::to_string(j) + ".txt"));
+      expected.push_back(file.native());
+    }
+  }
+
+  touch(root / "top.n19");
+  expected.push_back((root / "top.n19").native());
+  std::ranges::sort(expected);
+
+  SECTION(FindsEverythingSorted, {
+    for(const size_t threads : {size_t{1}, size_t{4}}) {
+      auto found = walk_directory(root.native(), {_nstr("*.n19")}, threads);
+      REQUIRE(found.has_value());
+      REQUIRE(*found == expected);
+    }
+  });
+
+  SECTION(SeveralGlobs, {
+    auto found = walk_directory(root.native(), {_nstr("*.txt"), _nstr("top.*")}, 4);
+    REQUIRE(found.has_value());
+    REQUIRE(found->size() == 8 * 16 + 1);
+  });
+
+  SECTION(MissingRoot, {
+    auto found = walk_directory((root / "missing").native(), {_nstr("*")}, 2);
+    REQUIRE(!found.has_value());
+  });
+
+  fs::remove_all(root);
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Sys/Process.hpp>
+#include <string>
+#include <vector>
+using namespace n19;
+using namespace n19::sys;
+
+#ifdef N19_POSIX
+TEST_CASE(Process, Run) {
+  SECTION(CapturesOutputAndStatus, {
+    Process::Spec spec;
+    spec.argv_ = {"sh", "-c", "echo out; echo err 1>&2; exit 3"};
+
+    auto output = Process::run(spec);
+    REQUIRE(output.has_value());
+    REQUIRE(output->status_ == 3);
+    REQUIRE(output->out_ == "out\n");
+    REQUIRE(output->err_ == "err\n");
+  });
+
+  SECTION(LargeInputDoesNotDeadlock, {
+    /// Far more than a pipe buffer in both directions.
+    Process::Spec spec;
+    spec.argv_  = {"cat"};
+    spec.input_ = std::string(1 << 20, 'x');
+
+    auto output = Process::run(spec);
+    REQUIRE(output.has_value());
+    REQUIRE(output->status_ == 0);
+    REQUIRE(output->out_ == spec.input_);
+  });
+
+  SECTION(MissingProgram, {
+    Process::Spec spec;
+    spec.argv_ = {"n19-no-such-program"};
+
+    auto output = Process::run(spec);
+    REQUIRE(!output.has_value() || output->status_ == 127);
+  });
+}
+
+TEST_CASE(Process, RunAll) {
+  SECTION(KeepsOrder, {
+    std::vector<Process::Spec> specs;
+    for(int i = 0; i < 6; i++) {
+      Process::Spec spec;
+      spec.argv_ = {"sh", "-c", "sleep 0.0" + std::to_string(6 - i) + "; echo " + std::to_string(i)};
+      specs.push_back(std::move(spec));
+    }
+
+    auto results = Process::run_all(specs, 3);
+    REQUIRE(results.size() == specs.size());
+    for(size_t i = 0; i < results.size(); i++) {
+      REQUIRE(results[i].has_value());
+      REQUIRE(results[i]->out_ == std::to_string(i) + "\n");
+    }
+  });
+}
+#endif
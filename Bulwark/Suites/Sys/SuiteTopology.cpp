@@ -0,0 +1,71 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Bulwark/Bulwark.hpp>
+#include <Sys/Topology.hpp>
+#include <algorithm>
+#include <vector>
+using namespace n19;
+using namespace n19::sys;
+
+TEST_CASE(Topology, Placement) {
+  SECTION(CoversAllowedCpus, {
+    const auto& topology = CpuTopology::the();
+    REQUIRE(topology.size() >= 1);
+    REQUIRE(topology.num_nodes() >= 1);
+
+    auto order = topology.placement();
+    REQUIRE(order.size() == topology.size());
+
+    std::vector<uint32_t> ids;
+    for(const auto& cpu : topology.cpus_) ids.push_back(cpu.id_);
+    std::ranges::sort(order);
+    std::ranges::sort(ids);
+    REQUIRE(order == ids);
+  });
+
+  SECTION(CompactAcrossNodes, {
+    CpuTopology topology;
+    topology.cpus_ = {
+      {0, 0, 0, 0}, {1, 1, 0, 0}, {2, 0, 1, 1}, {3, 1, 1, 1},
+      {4, 0, 0, 0}, {5, 1, 0, 0}, {6, 0, 1, 1}, {7, 1, 1, 1},
+    };
+
+    /// Whichever node the caller is on comes first, physical
+    /// cores before their siblings, one node at a time.
+    const auto order = topology.placement();
+    REQUIRE(order.size() == 8);
+    for(size_t i = 0; i < 4; i++) {
+      const auto node = topology.cpus_[order[i]].node_;
+      REQUIRE(node == topology.cpus_[order[0]].node_);
+      REQUIRE((order[i] < 4) == (i < 2));
+    }
+
+    REQUIRE(topology.pinning(4).size() == 8);
+    REQUIRE(topology.pinning(1).empty());
+  });
+
+  SECTION(NoPinningOnOneNode, {
+    CpuTopology topology;
+    topology.cpus_ = {{0, 0, 0, 0}, {1, 1, 0, 0}, {2, 2, 0, 0}, {3, 3, 0, 0}};
+    REQUIRE(topology.pinning(4).empty());
+  });
+}
+
+#ifdef N19_LINUX
+TEST_CASE(Topology, Affinity) {
+  SECTION(PinsAndRestores, {
+    const auto cpu = CpuTopology::the().cpus_.back().id_;
+    const auto before = CpuTopology::discover().size();
+    {
+      AffinityScope pin(cpu);
+      REQUIRE(current_cpu().has_value());
+      REQUIRE(*current_cpu() == cpu);
+    }
+
+    REQUIRE(CpuTopology::discover().size() == before);
+  });
+}
+#endif
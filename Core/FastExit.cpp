@@ -0,0 +1,66 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Core/FastExit.hpp>
+#include <IO/Console.hpp>
+#include <IO/Fmt.hpp>
+#include <Sys/Time.hpp>
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+#include <mutex>
+
+static std::mutex s_mtx_;
+BEGIN_NAMESPACE(n19);
+
+auto FastExit::get() -> FastExit& {
+  static FastExit the_handler;
+  return the_handler;
+}
+
+auto FastExit::add_flush_callback(Callback&& callback) -> bool {
+  std::lock_guard<std::mutex> lock(s_mtx_);
+  if(index_ >= callbacks_.size()) return false;
+  callbacks_[index_++] = std::move(callback);
+  return true;
+}
+
+auto FastExit::flush_all_() -> void {
+  ///
+  /// Callbacks run without the lock held: one that logs, or
+  /// registers another callback, would otherwise deadlock.
+  std::array<Callback, 24> callbacks;
+  size_t count = 0;
+  {
+    std::lock_guard<std::mutex> lock(s_mtx_);
+    count = index_;
+    std::copy_n(callbacks_.begin(), count, callbacks.begin());
+  }
+
+  for(size_t i = 0; i < count; ++i) {
+    callbacks[i]();
+  }
+
+  outs().flush();
+  errs().flush();
+}
+
+auto FastExit::exit(const int status) -> void {
+  flush_all_();
+
+  if(verbose_) {
+    sys::Stopwatch watch;         /// Only done to measure what
+    retained_.clear();            /// we would've spent otherwise.
+    outs()
+      << "Fast exit saved "
+      << fmt("{:.3f}", watch.elapsed_ms())
+      << "ms of teardown.\n";
+    outs().flush();
+  }
+
+  std::_Exit(status);
+}
+
+END_NAMESPACE(n19);
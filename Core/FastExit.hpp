@@ -0,0 +1,68 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_FASTEXIT_HPP
+#define N19_FASTEXIT_HPP
+#include <Core/Platform.hpp>
+#include <Core/ClassTraits.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <array>
+BEGIN_NAMESPACE(n19);
+
+///
+/// Tearing down the AST and the entity graph of a large program
+/// means chasing millions of pointers just to hand memory back to the
+/// OS, which is going to reclaim it anyway. When fast exit is enabled,
+/// large structures are retained here instead of being destroyed, and
+/// exit() flushes all output and leaves through _Exit() without running
+/// any destructors. It's disabled by default: Bulwark and library users
+/// get normal teardown unless they explicitly opt in.
+class FastExit {
+  N19_MAKE_NONMOVABLE(FastExit);
+  N19_MAKE_NONCOPYABLE(FastExit);
+public:
+  using Callback = std::function<void()>;
+
+  NODISCARD_ static auto get() -> FastExit&;
+  auto add_flush_callback(Callback&&) -> bool;
+
+  template<typename T>
+  auto retain(std::unique_ptr<T>&& ptr) -> void;
+
+  template<typename T>
+  auto retain(std::shared_ptr<T> ptr) -> void;
+
+  ///
+  /// Flushes the global streams, runs the flush callbacks and
+  /// terminates. When "verbose" is set, the retained objects are
+  /// destroyed anyway (after all output is flushed) just to
+  /// measure and report how long normal teardown would've taken.
+  NORETURN_ auto exit(int status) -> void;
+
+  bool enabled_ = false;
+  bool verbose_ = false;
+private:
+  FastExit() = default;
+  auto flush_all_() -> void;
+
+  size_t index_{};
+  std::array<Callback, 24> callbacks_{};
+  std::vector<std::shared_ptr<void>> retained_;
+};
+
+template<typename T>
+auto FastExit::retain(std::unique_ptr<T>&& ptr) -> void {
+  if(ptr) retained_.emplace_back(std::shared_ptr<T>(std::move(ptr)));
+}
+
+template<typename T>
+auto FastExit::retain(std::shared_ptr<T> ptr) -> void {
+  if(ptr) retained_.emplace_back(std::move(ptr));
+}
+
+END_NAMESPACE(n19);
+#endif //N19_FASTEXIT_HPP
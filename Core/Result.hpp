@@ -33,6 +33,7 @@ struct ErrC_ final {
     Overflow   = 0x08,
     NotImplimented = 0x09,
     BadExpr    = 0x0A,
+    Cancelled  = 0x0B,
   };
 
   Value value = None;
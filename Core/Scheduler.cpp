@@ -0,0 +1,65 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Core/Scheduler.hpp>
+#include <algorithm>
+BEGIN_NAMESPACE(n19);
+
+/// Blocking reads mostly wait, so a few more
+/// of them than there are disks is plenty.
+static constexpr size_t io_workers_ = 4;
+
+auto Scheduler::the() -> Scheduler& {
+  static Scheduler scheduler(std::max<size_t>(1, std::thread::hardware_concurrency()));
+  return scheduler;
+}
+
+auto Scheduler::io() -> Scheduler& {
+  static Scheduler scheduler(io_workers_);
+  return scheduler;
+}
+
+Scheduler::Scheduler(const size_t workers) {
+  workers_.reserve(std::max<size_t>(workers, 1));
+  for(size_t i = 0; i < std::max<size_t>(workers, 1); i++) {
+    workers_.emplace_back([this] { work_(); });
+  }
+}
+
+Scheduler::~Scheduler() {
+  {
+    std::scoped_lock lock(lock_);
+    stopping_ = true;
+  }
+
+  ready_.notify_all();
+  for(auto& worker : workers_) worker.join();
+}
+
+auto Scheduler::post(const std::coroutine_handle<> handle) -> void {
+  {
+    std::scoped_lock lock(lock_);
+    queue_.push_back(handle);
+  }
+
+  ready_.notify_one();
+}
+
+auto Scheduler::work_() -> void {
+  while(true) {
+    std::coroutine_handle<> next;
+    {
+      std::unique_lock lock(lock_);
+      ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if(queue_.empty()) return;   /// Stopping, and nothing left to run.
+      next = queue_.front();
+      queue_.pop_front();
+    }
+
+    next.resume();
+  }
+}
+
+END_NAMESPACE(n19);
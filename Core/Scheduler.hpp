@@ -0,0 +1,234 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_SCHEDULER_HPP
+#define N19_SCHEDULER_HPP
+#include <Core/Platform.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Task.hpp>
+#include <Core/Try.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+BEGIN_NAMESPACE(n19);
+
+///
+/// A pool of worker threads that resume coroutines. A task moves
+/// onto one with co_await scheduler.schedule(), and from then on
+/// runs there until it suspends again. The queue is FIFO, so
+/// continuations run in roughly the order they became ready.
+class Scheduler {
+  N19_MAKE_NONCOPYABLE(Scheduler);
+  N19_MAKE_NONMOVABLE(Scheduler);
+public:
+  struct Awaiter {
+    auto await_ready() const noexcept -> bool { return false; }
+    auto await_suspend(std::coroutine_handle<> handle) const -> void { sched_.post(handle); }
+    auto await_resume() const noexcept -> void {}
+    Scheduler& sched_;
+  };
+
+  /// the() has a worker per hardware thread and is meant for
+  /// work that keeps a CPU busy. io() is a small separate pool
+  /// for blocking system calls, so those never hold up the CPU
+  /// workers while they wait on the disk.
+  NODISCARD_ static auto the() -> Scheduler&;
+  NODISCARD_ static auto io()  -> Scheduler&;
+
+  NODISCARD_ auto schedule() -> Awaiter { return Awaiter{*this}; }
+  NODISCARD_ auto size() const -> size_t { return workers_.size(); }
+  auto post(std::coroutine_handle<> handle) -> void;
+
+  explicit Scheduler(size_t workers);
+ ~Scheduler();
+private:
+  auto work_() -> void;
+
+  std::mutex lock_;
+  std::condition_variable ready_;
+  std::deque<std::coroutine_handle<>> queue_;
+  std::vector<std::thread> workers_;
+  bool stopping_ = false;
+};
+
+///
+/// Cooperative cancellation. Tasks are never torn down from the
+/// outside: they look at their token at convenient points, and
+/// co_await token.check() inside of a Task<Result<T>> finishes
+/// it with ErrC::Cancelled once the source has been cancelled.
+class CancelToken {
+public:
+  NODISCARD_ auto cancelled() const -> bool;
+  NODISCARD_ auto check() const -> Result<void>;
+
+  std::shared_ptr<const std::atomic<bool>> flag_; /// Null: can't be cancelled.
+};
+
+class CancelSource {
+public:
+  NODISCARD_ auto token() const -> CancelToken { return CancelToken{flag_}; }
+  auto cancel() -> void { flag_->store(true, std::memory_order::relaxed); }
+
+  std::shared_ptr<std::atomic<bool>> flag_ = std::make_shared<std::atomic<bool>>(false);
+};
+
+///
+/// Runs a task to completion and blocks the calling thread until
+/// it's done. This is where synchronous code enters async code,
+/// never call it from a scheduler's worker.
+template<typename T>
+auto block_on(Task<T> task) -> T;
+
+///
+/// Starts every task on the scheduler at once and finishes when
+/// the last of them does, with their values in the same order.
+/// With Result values, the errors are left for the caller to look
+/// at: a failing task doesn't cancel its siblings unless they share
+/// a CancelToken.
+template<typename T>
+auto when_all(Scheduler& sched, std::vector<Task<T>> tasks) -> Task<std::vector<T>>;
+
+template<typename T>
+auto when_all(std::vector<Task<T>> tasks) -> Task<std::vector<T>>;
+
+/// Calls fn() on one of the scheduler's workers.
+template<typename F>
+auto offload(Scheduler& sched, F fn) -> Task<std::invoke_result_t<F&>>;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail_ {
+struct WhenAllState_ {
+  std::atomic<size_t> remaining_ = 0;
+  std::coroutine_handle<> waiter_;
+  Scheduler* sched_ = nullptr;
+};
+
+template<typename T>
+auto when_all_child_(Scheduler& sched, Task<T>& task, Maybe<T>& out, WhenAllState_& state) -> Detached_ {
+  co_await sched.schedule();
+  out.emplace(co_await task);
+  if(state.remaining_.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+    state.sched_->post(state.waiter_);
+  }
+}
+
+template<typename T>
+struct WhenAllAwaiter_ {
+  auto await_ready() const noexcept -> bool { return tasks_.empty(); }
+  auto await_resume() const noexcept -> void {}
+  auto await_suspend(std::coroutine_handle<> handle) -> void {
+    state_.waiter_ = handle;
+    state_.sched_  = &sched_;
+    state_.remaining_.store(tasks_.size(), std::memory_order::relaxed);
+
+    /// Once the last child is started the awaiting coroutine can be
+    /// resumed and finished on a worker, taking this awaiter with it.
+    /// Nothing but locals may be touched from then on.
+    Scheduler& sched     = sched_;
+    WhenAllState_& state = state_;
+    Task<T>* tasks       = tasks_.data();
+    Maybe<T>* results    = results_.data();
+    const size_t count   = tasks_.size();
+    for(size_t i = 0; i < count; i++) {
+      when_all_child_(sched, tasks[i], results[i], state);
+    }
+  }
+
+  Scheduler& sched_;
+  std::vector<Task<T>>& tasks_;
+  std::vector<Maybe<T>>& results_;
+  WhenAllState_& state_;
+};
+
+/// The waiting thread may tear this down as soon as done_ is
+/// set, hence notifying with the lock still held.
+struct BlockOnState_ {
+  auto signal() -> void {
+    std::scoped_lock lock(lock_);
+    done_ = true;
+    ready_.notify_one();
+  }
+
+  auto wait() -> void {
+    std::unique_lock lock(lock_);
+    ready_.wait(lock, [this] { return done_; });
+  }
+
+  std::mutex lock_;
+  std::condition_variable ready_;
+  bool done_ = false;
+};
+
+template<typename T>
+auto block_on_child_(Task<T>& task, Maybe<T>& out, BlockOnState_& state) -> Detached_ {
+  out.emplace(co_await task);
+  state.signal();
+}
+
+inline auto block_on_child_(Task<void>& task, BlockOnState_& state) -> Detached_ {
+  co_await task;
+  state.signal();
+}
+} // namespace detail_
+
+template<typename T>
+auto block_on(Task<T> task) -> T {
+  detail_::BlockOnState_ state;
+  if constexpr(std::is_void_v<T>) {
+    detail_::block_on_child_(task, state);
+    state.wait();
+  } else {
+    Maybe<T> out;
+    detail_::block_on_child_(task, out, state);
+    state.wait();
+    return out.release_value();
+  }
+}
+
+template<typename T>
+auto when_all(Scheduler& sched, std::vector<Task<T>> tasks) -> Task<std::vector<T>> {
+  static_assert(!std::is_void_v<T>, "when_all() needs tasks that produce a value.");
+  std::vector<Maybe<T>> results(tasks.size());
+  detail_::WhenAllState_ state;
+  co_await detail_::WhenAllAwaiter_<T>{sched, tasks, results, state};
+
+  std::vector<T> values;
+  values.reserve(results.size());
+  for(auto& result : results) {
+    values.emplace_back(result.release_value());
+  }
+
+  co_return std::move(values);
+}
+
+template<typename T>
+auto when_all(std::vector<Task<T>> tasks) -> Task<std::vector<T>> {
+  return when_all(Scheduler::the(), std::move(tasks));
+}
+
+template<typename F>
+auto offload(Scheduler& sched, F fn) -> Task<std::invoke_result_t<F&>> {
+  co_await sched.schedule();
+  co_return fn();
+}
+
+inline auto CancelToken::cancelled() const -> bool {
+  return flag_ != nullptr && flag_->load(std::memory_order::relaxed);
+}
+
+inline auto CancelToken::check() const -> Result<void> {
+  ERROR_IF(cancelled(), ErrC::Cancelled, "The operation was cancelled.");
+  return Result<void>::create();
+}
+
+END_NAMESPACE(n19);
+#endif //N19_SCHEDULER_HPP
@@ -0,0 +1,126 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Core/Stats.hpp>
+#include <Core/Panic.hpp>
+#include <IO/Fmt.hpp>
+#include <IO/Console.hpp>
+#include <algorithm>
+#include <mutex>
+BEGIN_NAMESPACE(n19::stats);
+
+#ifndef N19_DISABLE_STATS
+
+struct Registry_ {
+  std::mutex lock_;
+  std::vector<std::string_view> names_;
+  std::vector<Slab_*> live_;
+  std::array<uint64_t, max_counters_> retired_{};
+};
+
+static auto registry_() -> Registry_& {
+  static Registry_ registry;
+  return registry;
+}
+
+///
+/// Owns a thread's slab, and folds it into the
+/// retired totals when the thread goes away.
+struct SlabOwner_ {
+  ~SlabOwner_() {
+    auto& registry = registry_();
+    std::lock_guard guard(registry.lock_);
+    for(size_t i = 0; i < max_counters_; i++) {
+      registry.retired_[i] += slab_.values_[i].load(std::memory_order_relaxed);
+    }
+
+    std::erase(registry.live_, &slab_);
+    stats::slab_ = nullptr;
+  }
+
+  Slab_ slab_;
+};
+
+auto attach_slab_() -> Slab_* {
+  thread_local SlabOwner_ owner;
+  auto& registry = registry_();
+  std::lock_guard guard(registry.lock_);
+  registry.live_.push_back(&owner.slab_);
+  slab_ = &owner.slab_;
+  return slab_;
+}
+
+Counter::Counter(const std::string_view name) : name_(name) {
+  auto& registry = registry_();
+  std::lock_guard guard(registry.lock_);
+  if(registry.names_.size() >= max_counters_) {
+    PANIC("stats: too many counters, raise max_counters_.");
+  }
+
+  index_ = static_cast<uint32_t>(registry.names_.size());
+  registry.names_.push_back(name);
+}
+
+auto snapshot() -> std::vector<std::pair<std::string_view, uint64_t>> {
+  auto& registry = registry_();
+  std::lock_guard guard(registry.lock_);
+  std::vector<std::pair<std::string_view, uint64_t>> out;
+  for(size_t i = 0; i < registry.names_.size(); i++) {
+    uint64_t total = registry.retired_[i];
+    for(const Slab_* slab : registry.live_) {
+      total += slab->values_[i].load(std::memory_order_relaxed);
+    }
+
+    out.emplace_back(registry.names_[i], total);
+  }
+
+  std::ranges::sort(out);
+  std::vector<std::pair<std::string_view, uint64_t>> merged;
+  for(const auto& [name, value] : out) {
+    if(!merged.empty() && merged.back().first == name) merged.back().second += value;
+    else merged.emplace_back(name, value);
+  }
+
+  return merged;
+}
+
+#else
+
+auto snapshot() -> std::vector<std::pair<std::string_view, uint64_t>> {
+  return {};
+}
+
+#endif
+
+auto print(OStream& stream) -> void {
+  const auto counters = snapshot();
+  if(counters.empty()) {
+    stream << "No statistics were collected.\n";
+    return;
+  }
+
+  size_t width = 0;
+  for(const auto& [name, _] : counters) {
+    width = std::max(width, name.size());
+  }
+
+  stream << Con::Bold << "---- Statistics\n" << Con::Reset;
+  for(const auto& [name, value] : counters) {
+    stream << name << std::string(width - name.size() + 2, ' ') << fmt("{:>12}\n", value);
+  }
+}
+
+auto print_json(OStream& stream) -> void {
+  const auto counters = snapshot();
+  stream << "{";
+  for(size_t i = 0; i < counters.size(); i++) {
+    stream << (i == 0 ? "\n" : ",\n");
+    stream << fmt("  \"{}\": {}", counters[i].first, counters[i].second);
+  }
+
+  stream << (counters.empty() ? "}\n" : "\n}\n");
+}
+
+END_NAMESPACE(n19::stats);
@@ -0,0 +1,88 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_STATS_HPP
+#define N19_STATS_HPP
+#include <Core/Platform.hpp>
+#include <Core/ClassTraits.hpp>
+#include <IO/Stream.hpp>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Named counters, for explaining where time went: tokens lexed,
+// peeks, entities inserted and so on. Declare one per thing counted,
+// at namespace scope, and bump it wherever it happens:
+//
+//   static stats::Counter peeks_{"lexer.peeks"};
+//   ...
+//   peeks_.add();
+//
+// Increments go to a per-thread slab without any atomics read-
+// modify-write or locking, and are merged into the totals when the
+// thread exits. snapshot() adds up the totals and every live thread.
+//
+// Defining N19_DISABLE_STATS (the N19_STATS CMake option) turns
+// Counter into an empty, constant-initialized object and add() into
+// nothing, so the instrumentation can stay in hot paths.
+
+BEGIN_NAMESPACE(n19::stats);
+
+/// Plenty: each counter costs 8 bytes per thread.
+inline constexpr size_t max_counters_ = 512;
+
+#ifndef N19_DISABLE_STATS
+
+struct Slab_ {
+  std::array<std::atomic<uint64_t>, max_counters_> values_{};
+};
+
+inline thread_local Slab_* slab_ = nullptr;
+auto attach_slab_() -> Slab_*;
+
+class Counter {
+  N19_MAKE_NONCOPYABLE(Counter);
+  N19_MAKE_NONMOVABLE(Counter);
+public:
+  FORCEINLINE_ auto add(const uint64_t amount = 1) const -> void {
+    Slab_* slab = slab_ ? slab_ : attach_slab_();
+    auto& value = slab->values_[index_];
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+  }
+
+  explicit Counter(std::string_view name);
+  ~Counter() = default;
+
+  std::string_view name_;
+  uint32_t index_ = 0;
+};
+
+#else
+
+class Counter {
+  N19_MAKE_NONCOPYABLE(Counter);
+  N19_MAKE_NONMOVABLE(Counter);
+public:
+  FORCEINLINE_ auto add(const uint64_t = 1) const -> void {}
+  constexpr explicit Counter(std::string_view) {}
+  constexpr ~Counter() = default;
+};
+
+#endif
+
+/// Every counter with its current total, sorted by name.
+/// Counters sharing a name are reported as one.
+auto snapshot() -> std::vector<std::pair<std::string_view, uint64_t>>;
+
+/// Aligned "name  value" lines, or a flat JSON object.
+auto print(OStream& stream) -> void;
+auto print_json(OStream& stream) -> void;
+
+END_NAMESPACE(n19::stats);
+#endif //N19_STATS_HPP
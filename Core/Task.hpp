@@ -0,0 +1,212 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_TASK_HPP
+#define N19_TASK_HPP
+#include <Core/Platform.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Panic.hpp>
+#include <Core/Maybe.hpp>
+#include <Core/Result.hpp>
+#include <coroutine>
+#include <type_traits>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// n19::Task<T> is a lazily started coroutine producing a T.
+// Nothing runs until the task is co_await-ed, at which point it runs
+// on the awaiting thread until it suspends itself (usually by hopping
+// onto a Scheduler); whoever finishes it resumes the awaiter.
+//
+// Errors travel the same way they do everywhere else: a Task<Result<T>>
+// can co_await a Result<U>, which either hands back the U or finishes
+// the task right there with the error, the coroutine version of TRY().
+//
+//   auto load(sys::String name) -> Task<Result<size_t>> {
+//     auto bytes = co_await co_await sys::File::read_all_async(name);
+//     co_return bytes.size();
+//   }
+//
+// Coroutine parameters outlive the caller's arguments, so take them
+// by value: a reference parameter dangles as soon as the task suspends.
+
+template<typename T = void>
+class Task;
+
+namespace detail_ {
+template<typename T>
+inline constexpr bool IsResult_ = false;
+
+template<typename T, typename E>
+inline constexpr bool IsResult_<Result_<T, E>> = true;
+
+struct TaskFinalAwaiter_ {
+  auto await_ready() const noexcept -> bool { return false; }
+  auto await_resume() const noexcept -> void {}
+
+  template<typename P>
+  auto await_suspend(std::coroutine_handle<P> handle) noexcept -> std::coroutine_handle<> {
+    handle.promise().finished_ = true;
+    return handle.promise().continuation_;
+  }
+};
+
+/// Finishes the awaiting task early with the error,
+/// or resumes it right away with the value.
+template<typename T, typename E>
+struct TaskResultAwaiter_ {
+  auto await_ready() const noexcept -> bool { return result_.has_value(); }
+  auto await_resume() -> T { return result_.release_value(); }
+
+  template<typename P>
+  auto await_suspend(std::coroutine_handle<P> handle) -> std::coroutine_handle<> {
+    handle.promise().value_.emplace(result_.release_error());
+    handle.promise().finished_ = true;
+    return handle.promise().continuation_;
+  }
+
+  Result_<T, E> result_;
+};
+
+class TaskPromiseBase_ {
+public:
+  auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+  auto final_suspend() const noexcept -> TaskFinalAwaiter_ { return {}; }
+  auto unhandled_exception() const noexcept -> void {
+    PANIC("Unhandled exception inside of a Task.");
+  }
+
+  template<typename A> requires(!IsResult_<std::remove_cvref_t<A>>)
+  auto await_transform(A&& awaitable) const noexcept -> A&& {
+    return std::forward<A>(awaitable);
+  }
+
+  std::coroutine_handle<> continuation_ = std::noop_coroutine();
+  bool finished_ = false;
+};
+
+template<typename T>
+class TaskPromise_ : public TaskPromiseBase_ {
+public:
+  using TaskPromiseBase_::await_transform;
+  auto get_return_object() noexcept -> Task<T>;
+
+  template<typename U> requires std::constructible_from<T, U>
+  auto return_value(U&& value) -> void {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  template<typename U, typename E> requires IsResult_<T>
+  auto await_transform(Result_<U, E> result) -> TaskResultAwaiter_<U, E> {
+    return TaskResultAwaiter_<U, E>{std::move(result)};
+  }
+
+  Maybe<T> value_;
+};
+
+template<>
+class TaskPromise_<void> : public TaskPromiseBase_ {
+public:
+  auto get_return_object() noexcept -> Task<void>;
+  auto return_void() const noexcept -> void {}
+};
+
+/// A coroutine nobody waits on, it
+/// starts eagerly and frees itself.
+struct Detached_ {
+  struct promise_type {
+    auto get_return_object() const noexcept -> Detached_ { return {}; }
+    auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() const noexcept -> std::suspend_never { return {}; }
+    auto return_void() const noexcept -> void {}
+    auto unhandled_exception() const noexcept -> void {
+      PANIC("Unhandled exception inside of a detached coroutine.");
+    }
+  };
+};
+} // namespace detail_
+
+template<typename T>
+class Task {
+  N19_MAKE_NONCOPYABLE(Task);
+public:
+  using promise_type = detail_::TaskPromise_<T>;
+  using Handle       = std::coroutine_handle<promise_type>;
+
+  struct Awaiter {
+    auto await_ready() const noexcept -> bool { return handle_.promise().finished_; }
+    auto await_resume() -> T;
+    auto await_suspend(std::coroutine_handle<> awaiting) noexcept -> std::coroutine_handle<> {
+      handle_.promise().continuation_ = awaiting;
+      return handle_;
+    }
+
+    Handle handle_;
+  };
+
+  auto operator co_await() const noexcept -> Awaiter;
+  NODISCARD_ auto done() const -> bool;
+
+  auto operator=(Task&& other) noexcept -> Task&;
+  Task(Task&& other) noexcept;
+  explicit Task(Handle handle) : handle_(handle) {}
+  Task() = default;
+ ~Task();
+private:
+  Handle handle_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+FORCEINLINE_ auto detail_::TaskPromise_<T>::get_return_object() noexcept -> Task<T> {
+  return Task<T>{std::coroutine_handle<TaskPromise_>::from_promise(*this)};
+}
+
+inline auto detail_::TaskPromise_<void>::get_return_object() noexcept -> Task<void> {
+  return Task<void>{std::coroutine_handle<TaskPromise_>::from_promise(*this)};
+}
+
+template<typename T>
+FORCEINLINE_ auto Task<T>::Awaiter::await_resume() -> T {
+  if constexpr(!std::is_void_v<T>) {
+    ASSERT(handle_.promise().value_.has_value(), "Task result was already taken.");
+    return handle_.promise().value_.release_value();
+  }
+}
+
+template<typename T>
+FORCEINLINE_ auto Task<T>::operator co_await() const noexcept -> Awaiter {
+  ASSERT(handle_, "co_await on an empty Task.");
+  return Awaiter{handle_};
+}
+
+template<typename T>
+FORCEINLINE_ auto Task<T>::done() const -> bool {
+  return handle_ && handle_.promise().finished_;
+}
+
+template<typename T>
+FORCEINLINE_ auto Task<T>::operator=(Task&& other) noexcept -> Task& {
+  if(this != &other) {
+    if(handle_) handle_.destroy();
+    handle_ = std::exchange(other.handle_, nullptr);
+  }
+
+  return *this;
+}
+
+template<typename T>
+FORCEINLINE_ Task<T>::Task(Task&& other) noexcept
+: handle_(std::exchange(other.handle_, nullptr)) {}
+
+template<typename T>
+FORCEINLINE_ Task<T>::~Task() {
+  if(handle_) handle_.destroy();
+}
+
+END_NAMESPACE(n19);
+#endif //N19_TASK_HPP
@@ -0,0 +1,507 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/Analyses.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <Frontend/CallGraph.hpp>
+#include <Frontend/AstVisitor.hpp>
+#include <Core/Murmur3.hpp>
+#include <limits>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+static auto opens_scope_(const AstNode& node) -> bool {
+  switch(node.type_) {
+  case AstNode::Type::If:         FALLTHROUGH_;
+  case AstNode::Type::Else:       FALLTHROUGH_;
+  case AstNode::Type::While:      FALLTHROUGH_;
+  case AstNode::Type::For:        FALLTHROUGH_;
+  case AstNode::Type::ScopeBlock: FALLTHROUGH_;
+  case AstNode::Type::Case:       FALLTHROUGH_;
+  case AstNode::Type::Default:    FALLTHROUGH_;
+  case AstNode::Type::Where:      FALLTHROUGH_;
+  case AstNode::Type::Otherwise:  return true;
+  default:                        return false;
+  }
+}
+
+static auto is_assignment_(const AstBinExpr& bin) -> bool {
+  return bin.op_type_ == TokenType::ValueAssignment
+    || bin.op_cat_.isa(TokenCategory::ArithAssignOp)
+    || bin.op_cat_.isa(TokenCategory::BitwiseAssignOp);
+}
+
+static auto var_key_(const AstNode* name) -> Maybe<std::string> {
+  return name ? callee_key(*name) : Maybe<std::string>{Nothing};
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static auto scan_scopes_(ScopeInfo& info, AstNode& node, uint32_t scope) -> void {
+  if(opens_scope_(node)) {
+    const auto parent = scope;
+    scope = static_cast<uint32_t>(info.scopes_.size());
+
+    auto& created   = info.scopes_.emplace_back();
+    created.owner_  = &node;
+    created.parent_ = parent;
+    created.depth_  = info.scopes_[parent].depth_ + 1;
+    info.index_[&node] = scope;
+  }
+
+  if(node.type_ == AstNode::Type::Vardecl) {
+    info.scopes_[scope].decls_.emplace_back(static_cast<AstVardecl*>(&node));
+    return;
+  }
+
+  ast_for_each_child(node, [&](AstNode* child, AstNode::Ptr<>*) {
+    scan_scopes_(info, *child, scope);
+  });
+}
+
+auto ScopeInfo::compute(AstProcDecl& proc) -> ScopeInfo {
+  ScopeInfo info;
+  info.scopes_.emplace_back().owner_ = &proc;
+  info.index_[&proc] = 0;
+
+  for(auto& decl : proc.arg_decls_) if(decl) scan_scopes_(info, *decl, 0);
+  for(auto& stmt : proc.body_)      if(stmt) scan_scopes_(info, *stmt, 0);
+  return info;
+}
+
+auto ScopeInfo::scope_of(const AstNode* owner) const -> Maybe<uint32_t> {
+  const auto found = index_.find(owner);
+  if(found == index_.end()) return Nothing;
+  return found->second;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static auto scan_use_def_(UseDefInfo& info, AstNode& node) -> void {
+  switch(node.type_) {
+  case AstNode::Type::Vardecl: {
+    auto& var = static_cast<AstVardecl&>(node);
+    if(auto key = var_key_(var.name_.get()); key.has_value()) {
+      info.chains_[*key].defs_.emplace_back(&node);
+    }
+    return;                          /// The name isn't a use, and
+  }                                  /// the type can't refer to a variable.
+  case AstNode::Type::BinExpr: {
+    auto& bin = static_cast<AstBinExpr&>(node);
+    if(!is_assignment_(bin)) break;
+
+    auto key = var_key_(bin.left_.get());
+    if(!key.has_value()) break;      /// e.g. assigning through a subscript.
+
+    auto& chain = info.chains_[*key];
+    chain.defs_.emplace_back(&node);
+    if(bin.op_type_ != TokenType::ValueAssignment) {
+      chain.uses_.emplace_back(&node);
+    }
+
+    if(bin.right_) scan_use_def_(info, *bin.right_);
+    return;
+  }
+  case AstNode::Type::UnaryExpr: {
+    auto& un = static_cast<AstUnaryExpr&>(node);
+    if(un.op_type_ != TokenType::Inc && un.op_type_ != TokenType::Dec) break;
+
+    auto key = var_key_(un.operand_.get());
+    if(!key.has_value()) break;
+
+    auto& chain = info.chains_[*key];
+    chain.defs_.emplace_back(&node);
+    chain.uses_.emplace_back(&node);
+    return;
+  }
+  case AstNode::Type::EntityRef:      FALLTHROUGH_;
+  case AstNode::Type::EntityRefThunk: {
+    if(auto key = callee_key(node); key.has_value()) {
+      info.chains_[*key].uses_.emplace_back(&node);
+    }
+    return;
+  }
+  default: break;
+  }
+
+  ast_for_each_child(node, [&](AstNode* child, AstNode::Ptr<>*) {
+    scan_use_def_(info, *child);
+  });
+}
+
+auto UseDefInfo::compute(AstProcDecl& proc) -> UseDefInfo {
+  UseDefInfo info;
+  for(auto& decl : proc.arg_decls_) if(decl) scan_use_def_(info, *decl);
+  for(auto& stmt : proc.body_)      if(stmt) scan_use_def_(info, *stmt);
+  return info;
+}
+
+auto UseDefInfo::find(const std::string_view key) const -> const Chain* {
+  const auto found = chains_.find(std::string(key));
+  return found == chains_.end() ? nullptr : &found->second;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+  class CfgBuilder_ {
+  public:
+    static constexpr uint32_t none_ = std::numeric_limits<uint32_t>::max();
+
+    auto block() -> uint32_t {
+      graph_.blocks_.emplace_back();
+      return static_cast<uint32_t>(graph_.blocks_.size() - 1);
+    }
+
+    auto edge(const uint32_t from, const uint32_t to) -> void {
+      if(to == none_) return;
+      graph_.blocks_[from].succs_.emplace_back(to);
+      graph_.blocks_[to].preds_.emplace_back(from);
+    }
+
+    auto add(const uint32_t at, AstNode& stmt) -> void {
+      graph_.blocks_[at].stmts_.emplace_back(&stmt);
+      graph_.block_of_[&stmt] = at;
+    }
+
+    auto list(AstNode::Children<>& stmts, uint32_t cur) -> uint32_t {
+      for(auto& child : stmts) if(child) cur = stmt(*child, cur);
+      return cur;
+    }
+
+    auto stmt(AstNode& node, uint32_t cur) -> uint32_t;
+
+    explicit CfgBuilder_(ControlFlowGraph& graph) : graph_(graph) {}
+  private:
+    struct Targets_ {
+      uint32_t break_    = none_;
+      uint32_t continue_ = none_;
+    };
+
+    /// Anything following an unconditional jump goes into a
+    /// fresh block with no predecessors, i.e. an unreachable one.
+    auto jump(const uint32_t cur, const uint32_t to) -> uint32_t {
+      edge(cur, to);
+      return block();
+    }
+
+    ControlFlowGraph& graph_;
+    std::vector<Targets_> targets_;
+  };
+}
+
+auto CfgBuilder_::stmt(AstNode& node, const uint32_t cur) -> uint32_t {
+  const auto brk  = targets_.empty() ? none_ : targets_.back().break_;
+  const auto cont = targets_.empty() ? none_ : targets_.back().continue_;
+
+  switch(node.type_) {
+  case AstNode::Type::Return:
+    add(cur, node);
+    return jump(cur, ControlFlowGraph::exit_);
+  case AstNode::Type::Break:
+    add(cur, node);
+    return jump(cur, brk);
+  case AstNode::Type::Continue:
+    add(cur, node);
+    return jump(cur, cont);
+  case AstNode::Type::ScopeBlock:
+    add(cur, node);
+    return list(static_cast<AstScopeBlock&>(node).children_, cur);
+
+  case AstNode::Type::Branch: {
+    auto& branch = static_cast<AstBranch&>(node);
+    const auto join = block();
+    add(cur, node);
+
+    if(branch.if_) {
+      const auto arm = block();
+      edge(cur, arm);
+      edge(list(branch.if_->body_, arm), join);
+    }
+    if(branch.else_) {
+      const auto arm = block();
+      edge(cur, arm);
+      edge(list(branch.else_->body_, arm), join);
+    } else {
+      edge(cur, join);
+    }
+
+    return join;
+  }
+
+  case AstNode::Type::ConstBranch: {
+    auto& branch = static_cast<AstConstBranch&>(node);
+    const auto join = block();
+    add(cur, node);
+
+    if(branch.where_) {
+      const auto arm = block();
+      edge(cur, arm);
+      edge(list(branch.where_->body_, arm), join);
+    }
+    if(branch.otherwise_) {
+      const auto arm = block();
+      edge(cur, arm);
+      edge(list(branch.otherwise_->body_, arm), join);
+    } else {
+      edge(cur, join);
+    }
+
+    return join;
+  }
+
+  case AstNode::Type::While: {
+    auto& loop = static_cast<AstWhile&>(node);
+    const auto head  = block();
+    const auto body  = block();
+    const auto after = block();
+
+    ///
+    /// A do-while is entered at its body, and its condition may
+    /// never be reached (the body returns): the loop itself is
+    /// reachable exactly when the block it starts from is.
+    add(loop.is_dowhile ? cur : head, node);
+    edge(cur, loop.is_dowhile ? body : head);
+    edge(head, body);
+    edge(head, after);
+
+    targets_.push_back({after, head});
+    edge(list(loop.body_, body), head);
+    targets_.pop_back();
+    return after;
+  }
+
+  case AstNode::Type::For: {
+    auto& loop = static_cast<AstFor&>(node);
+    const auto head   = block();
+    const auto body   = block();
+    const auto update = block();
+    const auto after  = block();
+    add(head, node);
+
+    edge(cur, head);
+    edge(head, body);
+    edge(update, head);
+    if(loop.cond_) {                 /// No condition: the only
+      edge(head, after);             /// way out is a break.
+    }
+
+    targets_.push_back({after, update});
+    edge(loop.body_ ? stmt(*loop.body_, body) : body, update);
+    targets_.pop_back();
+    return after;
+  }
+
+  case AstNode::Type::Switch: {
+    auto& sw = static_cast<AstSwitch&>(node);
+    const auto join = block();
+    add(cur, node);
+
+    targets_.push_back({join, cont});
+    uint32_t falling = none_;        /// End of the previous case, if
+    for(auto& c : sw.cases_) {       /// it falls through into this one.
+      if(!c) continue;
+      const auto arm = block();
+      edge(cur, arm);
+      if(falling != none_) edge(falling, arm);
+
+      const auto end = list(c->children_, arm);
+      if(c->is_fallthrough) {
+        falling = end;
+      } else {
+        falling = none_;
+        edge(end, join);
+      }
+    }
+
+    if(sw.dflt_) {
+      const auto arm = block();
+      edge(cur, arm);
+      if(falling != none_) edge(falling, arm);
+      edge(list(sw.dflt_->children_, arm), join);
+    } else {
+      edge(cur, join);
+      if(falling != none_) edge(falling, join);
+    }
+
+    targets_.pop_back();
+    return join;
+  }
+
+  default:
+    add(cur, node);
+    return cur;
+  }
+}
+
+auto ControlFlowGraph::compute(AstProcDecl& proc) -> ControlFlowGraph {
+  ControlFlowGraph graph;
+  CfgBuilder_ builder(graph);
+
+  const auto entry = builder.block();
+  const auto exit  = builder.block();
+  ASSERT(entry == entry_ && exit == exit_);
+
+  builder.edge(builder.list(proc.body_, entry), exit);
+
+  std::vector<uint32_t> worklist{entry_};
+  graph.blocks_[entry_].reachable_ = true;
+  while(!worklist.empty()) {
+    const auto current = worklist.back();
+    worklist.pop_back();
+    for(const auto succ : graph.blocks_[current].succs_) {
+      if(graph.blocks_[succ].reachable_) continue;
+      graph.blocks_[succ].reachable_ = true;
+      worklist.emplace_back(succ);
+    }
+  }
+
+  return graph;
+}
+
+auto ControlFlowGraph::is_reachable(const AstNode* stmt) const -> bool {
+  const auto found = block_of_.find(stmt);
+  if(found == block_of_.end()) return true;
+  return blocks_[found->second].reachable_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static constexpr uint32_t expr_seed_ = 0x5ad0e5u;
+
+static auto hash_mix_(const uint64_t hash, const uint64_t value) -> uint64_t {
+  return murmur3_fmix64(hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2)));
+}
+
+static auto hash_expr_(const ExprDag& dag, const ExprDag::Node& node) -> uint64_t {
+  const std::u8string_view text{reinterpret_cast<const char8_t*>(node.text_.data()), node.text_.size()};
+  uint64_t hash = murmur3_fmix64(static_cast<uint64_t>(node.type_) + 1);
+  hash = hash_mix_(hash, static_cast<uint64_t>(node.op_.value) << 8 | node.flags_);
+  hash = hash_mix_(hash, node.entity_);
+  hash = hash_mix_(hash, murmur3_x86_32(text, expr_seed_));
+  hash = hash_mix_(hash, node.lhs_ == ExprDag::none_ ? 0 : dag.nodes_[node.lhs_].hash_);
+  hash = hash_mix_(hash, node.rhs_ == ExprDag::none_ ? 0 : dag.nodes_[node.rhs_].hash_);
+  return hash;
+}
+
+static auto same_expr_(const ExprDag::Node& lhs, const ExprDag::Node& rhs) -> bool {
+  return lhs.type_ == rhs.type_
+    && lhs.op_     == rhs.op_
+    && lhs.flags_  == rhs.flags_
+    && lhs.entity_ == rhs.entity_
+    && lhs.lhs_    == rhs.lhs_
+    && lhs.rhs_    == rhs.rhs_
+    && lhs.text_   == rhs.text_;
+}
+
+auto ExprDag::intern(const AstNode& expr) -> ID {
+  if(const auto found = ids_.find(&expr); found != ids_.end()) {
+    return found->second;
+  }
+
+  Node node;
+  node.type_ = expr.type_;
+  bool pure  = true;
+  const auto operand = [&](const AstNode::Ptr<>& ptr) -> ID {
+    const ID id = ptr ? intern(*ptr) : none_;
+    pure = pure && id != none_;
+    return id;
+  };
+
+  switch(expr.type_) {
+  case AstNode::Type::ScalarLiteral: {
+    const auto& lit = static_cast<const AstScalarLiteral&>(expr);
+    node.flags_ = lit.scalar_type_;
+    node.text_  = lit.value_;
+    break;
+  }
+  case AstNode::Type::EntityRef:
+    node.entity_ = static_cast<const AstEntityRef&>(expr).id_;
+    break;
+  case AstNode::Type::EntityRefThunk:
+    node.text_ = static_cast<const AstEntityRefThunk&>(expr).name_;
+    break;
+  case AstNode::Type::BinExpr: {
+    const auto& bin = static_cast<const AstBinExpr&>(expr);
+    node.op_  = bin.op_type_;
+    node.lhs_ = operand(bin.left_);
+    node.rhs_ = operand(bin.right_);
+    pure = pure && !is_assignment_(bin);
+    break;
+  }
+  case AstNode::Type::UnaryExpr: {
+    const auto& un = static_cast<const AstUnaryExpr&>(expr);
+    node.op_    = un.op_type_;
+    node.flags_ = un.is_postfix_;
+    node.lhs_   = operand(un.operand_);
+    pure = pure && un.op_type_ != TokenType::Inc && un.op_type_ != TokenType::Dec;
+    break;
+  }
+  case AstNode::Type::Subscript: {
+    const auto& sub = static_cast<const AstSubscript&>(expr);
+    node.lhs_ = operand(sub.operand_);
+    node.rhs_ = operand(sub.value_);
+    break;
+  }
+  default:
+    return none_;                    /// Not an expression we know
+  }                                  /// how to compare, don't memoize.
+
+  if(!pure) {
+    ids_.emplace(&expr, none_);
+    return none_;
+  }
+
+  node.hash_ = hash_expr_(*this, node);
+  const auto [begin, end] = index_.equal_range(node.hash_);
+  for(auto it = begin; it != end; ++it) {
+    if(same_expr_(nodes_[it->second], node)) {
+      ids_.emplace(&expr, it->second);
+      return it->second;
+    }
+  }
+
+  const auto id = static_cast<ID>(nodes_.size());
+  index_.emplace(node.hash_, id);
+  nodes_.emplace_back(std::move(node));
+  ids_.emplace(&expr, id);
+  return id;
+}
+
+auto ExprDag::id_of(const AstNode* expr) const -> ID {
+  const auto found = ids_.find(expr);
+  return found == ids_.end() ? none_ : found->second;
+}
+
+/// Interns maximal pure expressions whole, and looks inside
+/// of everything else for the pure expressions it contains.
+/// Names in declarations are left out, they aren't values.
+struct ExprDagBuilder_ final : AstVisitor<ExprDagBuilder_> {
+  auto enter(AstNode& node) -> AstWalk {
+    return dag_.intern(node) == ExprDag::none_ ? AstWalk::Continue : AstWalk::Skip;
+  }
+
+  auto enter(AstProcDecl& proc) -> AstWalk {
+    for(auto& stmt : proc.body_) {
+      if(stmt && !traverse(*stmt)) return AstWalk::Stop;
+    }
+
+    return AstWalk::Skip;
+  }
+
+  auto enter(AstVardecl&) -> AstWalk { return AstWalk::Skip; }
+
+  explicit ExprDagBuilder_(ExprDag& dag) : dag_(dag) {}
+  ExprDag& dag_;
+};
+
+auto ExprDag::compute(AstProcDecl& proc) -> ExprDag {
+  ExprDag dag;
+  ExprDagBuilder_ builder(dag);
+  builder.traverse(proc);
+  return dag;
+}
+
+END_NAMESPACE(n19);
@@ -0,0 +1,125 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_ANALYSES_HPP
+#define N19_ANALYSES_HPP
+#include <Frontend/AstNodes.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Maybe.hpp>
+#include <unordered_map>
+#include <string_view>
+#include <string>
+#include <vector>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Per-procedure analyses, computed over the AST of a single
+// AstProcDecl. None of them own any nodes: they hold raw pointers into
+// the procedure, so any pass that changes the procedure has to say
+// which of them survived (see AnalysisCache in PassManager.hpp).
+
+///
+/// The lexical scopes of a procedure. Scope 0 belongs to the
+/// procedure itself and holds its parameters.
+struct ScopeInfo {
+  struct Scope {
+    AstNode* owner_  = nullptr;       /// The node that opens the scope.
+    uint32_t parent_ = 0;             /// The root scope is its own parent.
+    uint32_t depth_  = 0;             ///
+    std::vector<AstVardecl*> decls_;  /// Declared directly within this scope.
+  };
+
+  static auto compute(AstProcDecl& proc) -> ScopeInfo;
+  auto scope_of(const AstNode* owner) const -> Maybe<uint32_t>;
+
+  std::vector<Scope> scopes_;
+  std::unordered_map<const AstNode*, uint32_t> index_;
+};
+
+///
+/// Every definition and use of each variable in a procedure, keyed
+/// by callee_key() of the variable's name. Definitions are the
+/// AstVardecl itself, assignments (the AstBinExpr) and ++/-- (the
+/// AstUnaryExpr). Compound assignments and ++/-- count as uses too.
+struct UseDefInfo {
+  struct Chain {
+    std::vector<AstNode*> defs_;
+    std::vector<AstNode*> uses_;
+  };
+
+  static auto compute(AstProcDecl& proc) -> UseDefInfo;
+  auto find(std::string_view key) const -> const Chain*;
+
+  std::unordered_map<std::string, Chain> chains_;
+};
+
+///
+/// A statement level control flow graph. Block 0 is the entry,
+/// block 1 the exit. Compound statements (branches, loops, switches)
+/// live in the block that evaluates their condition.
+struct ControlFlowGraph {
+  static constexpr uint32_t entry_ = 0;
+  static constexpr uint32_t exit_  = 1;
+
+  struct Block {
+    std::vector<AstNode*> stmts_;
+    std::vector<uint32_t> succs_;
+    std::vector<uint32_t> preds_;
+    bool reachable_ = false;
+  };
+
+  static auto compute(AstProcDecl& proc) -> ControlFlowGraph;
+  auto is_reachable(const AstNode* stmt) const -> bool;
+
+  std::vector<Block> blocks_;
+  std::unordered_map<const AstNode*, uint32_t> block_of_;
+};
+
+///
+/// The pure expressions of a procedure, hash-consed: every
+/// structurally distinct expression is stored once, however often
+/// and wherever it appears, so two expressions have the same ID
+/// exactly when they're spelled the same over the same entities.
+/// That's all an ID promises. Nothing here knows about stores, so
+/// "x + 1" before and after an assignment to x shares one ID, and
+/// callers have to check nothing they read was written in between
+/// before treating equal IDs as equal values.
+///
+/// Nodes are keyed by a Murmur3 hash of their fields and their
+/// operands' hashes. Operands are interned first, so confirming a
+/// hash match only compares operand IDs, never whole subtrees.
+///
+/// Nodes hold no positions or parents; ids_ is the side table that
+/// maps each occurrence in the AST to its node.
+struct ExprDag {
+  using ID = uint32_t;
+  static constexpr ID none_ = UINT32_MAX;
+
+  struct Node {
+    AstNode::Type type_ = AstNode::Type::Node;
+    TokenType op_       = TokenType::None;          /// BinExpr and UnaryExpr.
+    uint8_t flags_      = 0;                        /// Literal kind, or is_postfix_.
+    Entity::ID entity_  = N19_INVALID_ENTITY_ID;    /// EntityRef.
+    std::string text_;                              /// Literal value or thunk name.
+    ID lhs_ = none_;                                /// Operand, or the subscripted value.
+    ID rhs_ = none_;                                /// Right operand, or the index.
+    uint64_t hash_ = 0;
+  };
+
+  static auto compute(AstProcDecl& proc) -> ExprDag;
+
+  /// none_ for anything that isn't a pure expression
+  /// (calls, assignments, ++/--) or that contains one.
+  auto intern(const AstNode& expr) -> ID;
+  auto id_of(const AstNode* expr) const -> ID;
+
+  std::vector<Node> nodes_;
+  std::unordered_multimap<uint64_t, ID> index_;
+  std::unordered_map<const AstNode*, ID> ids_;
+};
+
+END_NAMESPACE(n19);
+#endif //N19_ANALYSES_HPP
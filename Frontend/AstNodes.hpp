@@ -8,11 +8,16 @@
 #include <Core/Platform.hpp>
 #include <Core/Maybe.hpp>
 #include <Core/Result.hpp>
+#include <Core/Panic.hpp>
 #include <IO/Console.hpp>
 #include <Core/Concepts.hpp>
 #include <Frontend/Token.hpp>
 #include <Frontend/Entity.hpp>
 #include <Sys/String.hpp>
+#include <Sys/MappedFile.hpp>
+#include <Core/Stats.hpp>
+#include <algorithm>
+#include <iterator>
 #include <vector>
 #include <memory>
 
@@ -48,6 +53,7 @@
   ASTNODE_X(Defer)             \
   ASTNODE_X(DeferIf)           \
   ASTNODE_X(Subscript)         \
+  ASTNODE_X(Embed)             \
 
 BEGIN_NAMESPACE(n19);
 
@@ -156,7 +162,30 @@ public:
 
 class AstAggregateLiteral final : public AstNode {
 public:
+  ///
+  /// Large aggregates made up of nothing but integer, float or
+  /// boolean literals of one kind (data tables, mostly) are kept
+  /// here as plain arrays instead of a node per element. When
+  /// packed_ is set, children_ is empty.
+  struct Packed {
+    struct LineStart {
+      uint32_t index_;                       /// First element on this line.
+      uint32_t line_;
+    };
+
+    decltype(AstScalarLiteral::scalar_type_) kind_ = AstScalarLiteral::None;
+    bool has_negatives_ = false;             /// ints_ holds two's complement values.
+    std::vector<uint64_t> ints_;             /// IntLit and BoolLit elements.
+    std::vector<double> floats_;             /// FloatLit elements.
+    std::vector<uint32_t> pos_;              /// File offset of every element.
+    std::vector<LineStart> lines_;           /// One entry per line the elements span.
+
+    auto size() const -> size_t { return pos_.size(); }
+    auto line_of(size_t index) const -> uint32_t;
+  };
+
   AstNode::Children<> children_;
+  std::unique_ptr<Packed> packed_;
 
   auto print(uint32_t depth,
     OStream& stream,
@@ -167,6 +196,12 @@ public:
   AstAggregateLiteral() = default;
 };
 
+inline auto AstAggregateLiteral::Packed::line_of(const size_t index) const -> uint32_t {
+  ASSERT(!lines_.empty() && index < size());
+  auto after = std::ranges::upper_bound(lines_, index, {}, &LineStart::index_);
+  return std::prev(after)->line_;
+}
+
 class AstEntityRef final : public AstNode {
 public:
   Entity::ID id_= N19_INVALID_ENTITY_ID;
@@ -247,6 +282,7 @@ public:
 };
 
 class AstNamespace final : public AstNode {
+public:
   AstNode::Children<> body_;
 
   auto print(uint32_t depth,
@@ -426,9 +462,21 @@ public:
 
 class AstProcDecl final : public AstNode {
 public:
+  ///
+  /// Where the body is, when the parser skipped over it instead
+  /// of building body_. It's parsed later by parse_bodies().
+  struct LazyBody {
+    std::shared_ptr<const std::vector<char8_t>> src_;
+    uint32_t begin_ = 0;   // The opening brace.
+    uint32_t end_   = 0;   // Just past the closing brace.
+    uint32_t line_  = 1;   // Line of the opening brace.
+    Entity::ID namespace_ = N19_ROOT_ENTITY_ID;
+  };
+
   AstNode::Ptr<> name_ = nullptr; // EntityRef or EntityRefThunk
   AstNode::Children<> arg_decls_; // The parameter declarations (if any)
   AstNode::Children<> body_;      // The body of the procedure
+  std::unique_ptr<LazyBody> lazy_body_; // Null unless the body is unparsed
 
   auto print(uint32_t depth,
     OStream& stream,
@@ -517,8 +565,36 @@ public:
   AstSubscript() = default;
 };
 
+///
+/// @embed("path"): a constant byte array holding the contents of a
+/// file. The bytes are never copied; the node shares the mapping,
+/// and anything that consumes it reads straight from mapping_.
+class AstEmbed final : public AstNode {
+public:
+  std::shared_ptr<const sys::MappedFile> mapping_ = nullptr;
+
+  auto bytes() const -> Bytes {
+    return mapping_ ? mapping_->bytes() : Bytes{};
+  }
+
+  auto print(uint32_t depth,
+    OStream& stream,
+    const Maybe<std::string> &alias
+  ) const -> void override;
+
+  ~AstEmbed() override = default;
+  AstEmbed() = default;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Nodes created so far, indexed by AstNode::Type.
+#define ASTNODE_X(NAME) stats::Counter{"ast.nodes." #NAME},
+inline stats::Counter ast_node_stats_[] = {
+  N19_ASTNODE_TYPE_LIST
+};
+#undef ASTNODE_X
+
 template<typename T>
 auto AstNode::create(
   const size_t pos,
@@ -532,15 +608,18 @@ auto AstNode::create(
   ptr->line_   = line;
   ptr->file_   = file;
 
-  #define ASTNODE_X(NAME)              \
-  if constexpr(IsSame<T, Ast##NAME>) { \
-    ptr->type_ = Type::NAME;           \
+  /// Note: go through AstNode, some nodes (AstVardecl)
+  /// have a member of their own that's named type_.
+  #define ASTNODE_X(NAME)                                 \
+  if constexpr(IsSame<T, Ast##NAME>) {                    \
+    static_cast<AstNode*>(ptr.get())->type_ = Type::NAME; \
   }
 
   N19_ASTNODE_TYPE_LIST
   #undef ASTNODE_X
 
   if(parent != nullptr) ptr->parent_ = parent;
+  ast_node_stats_[static_cast<size_t>(static_cast<AstNode*>(ptr.get())->type_)].add();
   return ptr;
 }
 
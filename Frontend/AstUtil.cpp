@@ -0,0 +1,284 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/AstUtil.hpp>
+#include <Frontend/AstVisitor.hpp>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+template<typename T>
+static auto clone_as_(const AstNode& node, AstNode* parent) -> AstNode::Ptr<T> {
+  return AstNode::create<T>(node.pos_, node.line_, parent, node.file_);
+}
+
+template<typename T>
+static auto clone_typed_(const AstNode::Ptr<T>& ptr, AstNode* parent) -> AstNode::Ptr<T> {
+  if(!ptr) return nullptr;
+  auto copy = ast_clone(*ptr, parent);
+  return AstNode::Ptr<T>{ static_cast<T*>(copy.release()) };
+}
+
+static auto clone_opt_(const AstNode::Ptr<>& ptr, AstNode* parent) -> AstNode::Ptr<> {
+  return ptr ? ast_clone(*ptr, parent) : nullptr;
+}
+
+static auto clone_list_(const AstNode::Children<>& from, AstNode::Children<>& to, AstNode* parent) -> void {
+  to.reserve(from.size());
+  for(const auto& child : from) to.emplace_back(clone_opt_(child, parent));
+}
+
+auto ast_clone(const AstNode& node, AstNode* parent) -> AstNode::Ptr<> {
+  switch(node.type_) {
+  case AstNode::Type::Vardecl: {
+    const auto& from = static_cast<const AstVardecl&>(node);
+    auto copy   = clone_as_<AstVardecl>(node, parent);
+    copy->name_ = clone_opt_(from.name_, copy.get());
+    copy->type_ = clone_opt_(from.type_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::ProcDecl: {
+    const auto& from = static_cast<const AstProcDecl&>(node);
+    auto copy   = clone_as_<AstProcDecl>(node, parent);
+    copy->name_ = clone_opt_(from.name_, copy.get());
+    clone_list_(from.arg_decls_, copy->arg_decls_, copy.get());
+    clone_list_(from.body_, copy->body_, copy.get());
+    if(from.lazy_body_) {
+      copy->lazy_body_ = std::make_unique<AstProcDecl::LazyBody>(*from.lazy_body_);
+    }
+    return copy;
+  }
+  case AstNode::Type::EntityRef: {
+    auto copy = clone_as_<AstEntityRef>(node, parent);
+    copy->id_ = static_cast<const AstEntityRef&>(node).id_;
+    return copy;
+  }
+  case AstNode::Type::EntityRefThunk: {
+    auto copy   = clone_as_<AstEntityRefThunk>(node, parent);
+    copy->name_ = static_cast<const AstEntityRefThunk&>(node).name_;
+    return copy;
+  }
+  case AstNode::Type::QualifiedRef: {
+    auto copy = clone_as_<AstQualifiedRef>(node, parent);
+    copy->descriptor_ = static_cast<const AstQualifiedRef&>(node).descriptor_;
+    return copy;
+  }
+  case AstNode::Type::QualifiedRefThunk: {
+    auto copy = clone_as_<AstQualifiedRefThunk>(node, parent);
+    copy->descriptor_ = static_cast<const AstQualifiedRefThunk&>(node).descriptor_;
+    return copy;
+  }
+  case AstNode::Type::ScalarLiteral: {
+    const auto& from = static_cast<const AstScalarLiteral&>(node);
+    auto copy = clone_as_<AstScalarLiteral>(node, parent);
+    copy->value_       = from.value_;
+    copy->scalar_type_ = from.scalar_type_;
+    return copy;
+  }
+  case AstNode::Type::AggregateLiteral: {
+    const auto& from = static_cast<const AstAggregateLiteral&>(node);
+    auto copy = clone_as_<AstAggregateLiteral>(node, parent);
+    clone_list_(from.children_, copy->children_, copy.get());
+    if(from.packed_) copy->packed_ = std::make_unique<AstAggregateLiteral::Packed>(*from.packed_);
+    return copy;
+  }
+  case AstNode::Type::BinExpr: {
+    const auto& from = static_cast<const AstBinExpr&>(node);
+    auto copy = clone_as_<AstBinExpr>(node, parent);
+    copy->op_type_ = from.op_type_;
+    copy->op_cat_  = from.op_cat_;
+    copy->left_    = clone_opt_(from.left_, copy.get());
+    copy->right_   = clone_opt_(from.right_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::UnaryExpr: {
+    const auto& from = static_cast<const AstUnaryExpr&>(node);
+    auto copy = clone_as_<AstUnaryExpr>(node, parent);
+    copy->op_type_    = from.op_type_;
+    copy->op_cat_     = from.op_cat_;
+    copy->is_postfix_ = from.is_postfix_;
+    copy->operand_    = clone_opt_(from.operand_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Branch: {
+    const auto& from = static_cast<const AstBranch&>(node);
+    auto copy   = clone_as_<AstBranch>(node, parent);
+    copy->if_   = clone_typed_(from.if_, copy.get());
+    copy->else_ = clone_typed_(from.else_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::If: {
+    const auto& from = static_cast<const AstIf&>(node);
+    auto copy = clone_as_<AstIf>(node, parent);
+    copy->condition_ = clone_opt_(from.condition_, copy.get());
+    clone_list_(from.body_, copy->body_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Else: {
+    auto copy = clone_as_<AstElse>(node, parent);
+    clone_list_(static_cast<const AstElse&>(node).body_, copy->body_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Switch: {
+    const auto& from = static_cast<const AstSwitch&>(node);
+    auto copy = clone_as_<AstSwitch>(node, parent);
+    copy->target_ = clone_opt_(from.target_, copy.get());
+    copy->dflt_   = clone_typed_(from.dflt_, copy.get());
+    for(const auto& c : from.cases_) copy->cases_.emplace_back(clone_typed_(c, copy.get()));
+    return copy;
+  }
+  case AstNode::Type::Case: {
+    const auto& from = static_cast<const AstCase&>(node);
+    auto copy = clone_as_<AstCase>(node, parent);
+    copy->is_fallthrough = from.is_fallthrough;
+    copy->value_ = clone_opt_(from.value_, copy.get());
+    clone_list_(from.children_, copy->children_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Default: {
+    auto copy = clone_as_<AstDefault>(node, parent);
+    clone_list_(static_cast<const AstDefault&>(node).children_, copy->children_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::For: {
+    const auto& from = static_cast<const AstFor&>(node);
+    auto copy = clone_as_<AstFor>(node, parent);
+    copy->body_   = clone_opt_(from.body_, copy.get());
+    copy->init_   = clone_opt_(from.init_, copy.get());
+    copy->update_ = clone_opt_(from.update_, copy.get());
+    copy->cond_   = clone_opt_(from.cond_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::While: {
+    const auto& from = static_cast<const AstWhile&>(node);
+    auto copy = clone_as_<AstWhile>(node, parent);
+    copy->cond_      = clone_opt_(from.cond_, copy.get());
+    copy->is_dowhile = from.is_dowhile;
+    clone_list_(from.body_, copy->body_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::ConstBranch: {
+    const auto& from = static_cast<const AstConstBranch&>(node);
+    auto copy = clone_as_<AstConstBranch>(node, parent);
+    copy->where_     = clone_typed_(from.where_, copy.get());
+    copy->otherwise_ = clone_typed_(from.otherwise_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Where: {
+    const auto& from = static_cast<const AstWhere&>(node);
+    auto copy = clone_as_<AstWhere>(node, parent);
+    copy->condition_ = clone_opt_(from.condition_, copy.get());
+    clone_list_(from.body_, copy->body_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Otherwise: {
+    auto copy = clone_as_<AstOtherwise>(node, parent);
+    clone_list_(static_cast<const AstOtherwise&>(node).body_, copy->body_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::ScopeBlock: {
+    auto copy = clone_as_<AstScopeBlock>(node, parent);
+    clone_list_(static_cast<const AstScopeBlock&>(node).children_, copy->children_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Namespace: {
+    auto copy = clone_as_<AstNamespace>(node, parent);
+    clone_list_(static_cast<const AstNamespace&>(node).body_, copy->body_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Call: {
+    const auto& from = static_cast<const AstCall&>(node);
+    auto copy = clone_as_<AstCall>(node, parent);
+    copy->target_ = clone_opt_(from.target_, copy.get());
+    clone_list_(from.arguments_, copy->arguments_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Break:    return clone_as_<AstBreak>(node, parent);
+  case AstNode::Type::Continue: return clone_as_<AstContinue>(node, parent);
+  case AstNode::Type::Return: {
+    auto copy = clone_as_<AstReturn>(node, parent);
+    copy->value_ = clone_opt_(static_cast<const AstReturn&>(node).value_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Defer: {
+    auto copy = clone_as_<AstDefer>(node, parent);
+    copy->call_ = clone_opt_(static_cast<const AstDefer&>(node).call_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::DeferIf: {
+    const auto& from = static_cast<const AstDeferIf&>(node);
+    auto copy = clone_as_<AstDeferIf>(node, parent);
+    copy->call_      = clone_opt_(from.call_, copy.get());
+    copy->condition_ = clone_opt_(from.condition_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Subscript: {
+    const auto& from = static_cast<const AstSubscript&>(node);
+    auto copy = clone_as_<AstSubscript>(node, parent);
+    copy->operand_ = clone_opt_(from.operand_, copy.get());
+    copy->value_   = clone_opt_(from.value_, copy.get());
+    return copy;
+  }
+  case AstNode::Type::Embed: {
+    auto copy = clone_as_<AstEmbed>(node, parent);
+    copy->mapping_ = static_cast<const AstEmbed&>(node).mapping_;
+    return copy;
+  }
+  default: break;
+  }
+
+  UNREACHABLE_ASSERTION;
+  return nullptr;
+}
+
+struct SizeVisitor_ final : AstVisitor<SizeVisitor_> {
+  auto enter(AstNode&) -> void { ++size_; }
+  size_t size_ = 0;
+};
+
+auto ast_size(AstNode& node) -> size_t {
+  SizeVisitor_ visitor;
+  visitor.traverse(node);
+  return visitor.size_;
+}
+
+auto ast_is_pure(AstNode& node) -> bool {
+  switch(node.type_) {
+  case AstNode::Type::EntityRef:         FALLTHROUGH_;
+  case AstNode::Type::EntityRefThunk:    FALLTHROUGH_;
+  case AstNode::Type::QualifiedRef:      FALLTHROUGH_;
+  case AstNode::Type::QualifiedRefThunk: FALLTHROUGH_;
+  case AstNode::Type::ScalarLiteral:     FALLTHROUGH_;
+  case AstNode::Type::Embed:             return true;
+  case AstNode::Type::AggregateLiteral:  FALLTHROUGH_;
+  case AstNode::Type::Subscript:         break;
+  case AstNode::Type::BinExpr: {
+    const auto& bin = static_cast<AstBinExpr&>(node);
+    if(bin.op_type_ == TokenType::ValueAssignment
+      || bin.op_cat_.isa(TokenCategory::ArithAssignOp)
+      || bin.op_cat_.isa(TokenCategory::BitwiseAssignOp)) {
+      return false;
+    }
+    break;
+  }
+  case AstNode::Type::UnaryExpr: {
+    const auto& un = static_cast<AstUnaryExpr&>(node);
+    if(un.op_type_ == TokenType::Inc || un.op_type_ == TokenType::Dec) {
+      return false;
+    }
+    break;
+  }
+  default:
+    return false;                    /// Calls, and anything that
+  }                                  /// isn't an expression.
+
+  bool pure = true;
+  ast_for_each_child(node, [&](AstNode* child, AstNode::Ptr<>*) {
+    pure = pure && ast_is_pure(*child);
+  });
+
+  return pure;
+}
+
+END_NAMESPACE(n19);
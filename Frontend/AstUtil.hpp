@@ -0,0 +1,150 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_ASTUTIL_HPP
+#define N19_ASTUTIL_HPP
+#include <Frontend/AstNodes.hpp>
+#include <Core/Panic.hpp>
+#include <Core/Concepts.hpp>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///
+/// Calls cb(child, slot) for every non-null child of "node", in source order.
+/// "slot" is the owning pointer the child lives in, which allows callers to
+/// replace the child. It's nullptr when the child is held through a
+/// typed pointer (e.g. AstBranch::if_), since those can't hold arbitrary nodes.
+template<typename F>
+auto ast_for_each_child(AstNode& node, F&& cb) -> void;
+
+/// The same, for a node whose type is already known.
+template<typename T, typename F>
+auto ast_for_each_child_of(T& node, F&& cb) -> void;
+
+///
+/// Calls cb(list) for each statement list directly owned by "node"
+/// (procedure bodies, branch arms, loop bodies, case bodies, blocks).
+/// Nested lists are not visited: recurse from within the callback.
+template<typename F>
+auto ast_for_each_list(AstNode& node, F&& cb) -> void;
+
+///
+/// Whether evaluating an expression can be skipped entirely: it
+/// doesn't call anything, assign to anything, or increment anything.
+auto ast_is_pure(AstNode& node) -> bool;
+
+///
+/// Deep copies a subtree. The copy's root has its parent set to "parent".
+auto ast_clone(const AstNode& node, AstNode* parent = nullptr) -> AstNode::Ptr<>;
+
+///
+/// The amount of nodes in a subtree, including its root.
+auto ast_size(AstNode& node) -> size_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename T, typename F>
+auto ast_for_each_child_of(T& n, F&& cb) -> void {
+  const auto slot = [&](AstNode::Ptr<>& ptr) {
+    if(ptr) cb(ptr.get(), &ptr);
+  };
+
+  const auto typed = [&]<typename U>(AstNode::Ptr<U>& ptr) {
+    if(ptr) cb(static_cast<AstNode*>(ptr.get()), static_cast<AstNode::Ptr<>*>(nullptr));
+  };
+
+  const auto list = [&](AstNode::Children<>& children) {
+    for(auto& child : children) slot(child);
+  };
+
+  if constexpr(IsSame<T, AstVardecl>) {
+    slot(n.name_); slot(n.type_);
+  } else if constexpr(IsSame<T, AstProcDecl>) {
+    slot(n.name_); list(n.arg_decls_); list(n.body_);
+  } else if constexpr(IsSame<T, AstAggregateLiteral>) {
+    list(n.children_);
+  } else if constexpr(IsSame<T, AstBinExpr>) {
+    slot(n.left_); slot(n.right_);
+  } else if constexpr(IsSame<T, AstUnaryExpr>) {
+    slot(n.operand_);
+  } else if constexpr(IsSame<T, AstBranch>) {
+    typed(n.if_); typed(n.else_);
+  } else if constexpr(IsSame<T, AstIf>) {
+    slot(n.condition_); list(n.body_);
+  } else if constexpr(IsSame<T, AstElse>) {
+    list(n.body_);
+  } else if constexpr(IsSame<T, AstSwitch>) {
+    slot(n.target_);
+    for(auto& c : n.cases_) typed(c);
+    typed(n.dflt_);
+  } else if constexpr(IsSame<T, AstCase>) {
+    slot(n.value_); list(n.children_);
+  } else if constexpr(IsSame<T, AstDefault>) {
+    list(n.children_);
+  } else if constexpr(IsSame<T, AstFor>) {
+    slot(n.init_); slot(n.cond_); slot(n.update_); slot(n.body_);
+  } else if constexpr(IsSame<T, AstWhile>) {
+    slot(n.cond_); list(n.body_);
+  } else if constexpr(IsSame<T, AstConstBranch>) {
+    typed(n.where_); typed(n.otherwise_);
+  } else if constexpr(IsSame<T, AstWhere>) {
+    slot(n.condition_); list(n.body_);
+  } else if constexpr(IsSame<T, AstOtherwise>) {
+    list(n.body_);
+  } else if constexpr(IsSame<T, AstScopeBlock>) {
+    list(n.children_);
+  } else if constexpr(IsSame<T, AstNamespace>) {
+    list(n.body_);
+  } else if constexpr(IsSame<T, AstCall>) {
+    slot(n.target_); list(n.arguments_);
+  } else if constexpr(IsSame<T, AstReturn>) {
+    slot(n.value_);
+  } else if constexpr(IsSame<T, AstDefer>) {
+    slot(n.call_);
+  } else if constexpr(IsSame<T, AstDeferIf>) {
+    slot(n.condition_); slot(n.call_);
+  } else if constexpr(IsSame<T, AstSubscript>) {
+    slot(n.operand_); slot(n.value_);
+  } else {
+    /// A node type with children of its own needs a branch above.
+    static_assert(AnyOf<T, AstNode, AstEntityRef, AstEntityRefThunk,
+      AstQualifiedRef, AstQualifiedRefThunk, AstScalarLiteral,
+      AstEmbed, AstBreak, AstContinue>, "Unhandled AST node type.");
+  }
+}
+
+template<typename F>
+auto ast_for_each_child(AstNode& node, F&& cb) -> void {
+  switch(node.type_) {
+  #define ASTNODE_X(NAME)                                           \
+  case AstNode::Type::NAME:                                         \
+    ast_for_each_child_of(static_cast<Ast##NAME&>(node), cb);       \
+    break;
+
+  N19_ASTNODE_TYPE_LIST
+  #undef ASTNODE_X
+  default: UNREACHABLE_ASSERTION;
+  }
+}
+
+template<typename F>
+auto ast_for_each_list(AstNode& node, F&& cb) -> void {
+  switch(node.type_) {
+  case AstNode::Type::ProcDecl:   cb(static_cast<AstProcDecl&>(node).body_);       break;
+  case AstNode::Type::If:         cb(static_cast<AstIf&>(node).body_);             break;
+  case AstNode::Type::Else:       cb(static_cast<AstElse&>(node).body_);           break;
+  case AstNode::Type::While:      cb(static_cast<AstWhile&>(node).body_);          break;
+  case AstNode::Type::Case:       cb(static_cast<AstCase&>(node).children_);       break;
+  case AstNode::Type::Default:    cb(static_cast<AstDefault&>(node).children_);    break;
+  case AstNode::Type::Where:      cb(static_cast<AstWhere&>(node).body_);          break;
+  case AstNode::Type::Otherwise:  cb(static_cast<AstOtherwise&>(node).body_);      break;
+  case AstNode::Type::ScopeBlock: cb(static_cast<AstScopeBlock&>(node).children_); break;
+  case AstNode::Type::Namespace:  cb(static_cast<AstNamespace&>(node).body_);      break;
+  default: break;
+  }
+}
+
+END_NAMESPACE(n19);
+#endif //N19_ASTUTIL_HPP
@@ -0,0 +1,117 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_ASTVISITOR_HPP
+#define N19_ASTVISITOR_HPP
+#include <Frontend/AstNodes.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <Core/Platform.hpp>
+#include <Core/Panic.hpp>
+#include <type_traits>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// n19::AstVisitor<Derived> walks a subtree in source order without
+// any virtual calls. The derived class defines hooks for the node
+// types it cares about, and nothing else:
+//
+//   struct CountCalls : AstVisitor<CountCalls> {
+//     auto enter(AstCall&) -> void { ++calls_; }          // pre-order
+//     auto leave(AstProcDecl&) -> AstWalk { ... }         // post-order
+//     size_t calls_ = 0;
+//   };
+//
+// A hook taking AstNode& sees every node that has no more specific
+// hook. Hooks return AstWalk, or void for AstWalk::Continue, and must
+// be public. There is exactly one switch on AstNode::type_ per node,
+// generated from N19_ASTNODE_TYPE_LIST; past it the node's type is
+// static, so the hooks and the child iteration can be inlined.
+
+enum class AstWalk : uint8_t {
+  Continue,   /// Visit the node's children, then move on.
+  Skip,       /// Leave the children alone. Still calls leave().
+  Stop,       /// End the whole traversal right away.
+};
+
+template<typename Derived>
+class AstVisitor {
+public:
+  /// False if a hook stopped the traversal.
+  auto traverse(AstNode& node) -> bool;
+
+  /// Only the children, for hooks that want to walk them
+  /// at a point of their own choosing (and then Skip).
+  template<typename T>
+  auto traverse_children(T& node) -> bool;
+
+  template<typename T>
+  auto traverse_as(T& node) -> bool;
+private:
+  FORCEINLINE_ auto derived_() -> Derived& { return static_cast<Derived&>(*this); }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail_ {
+template<typename F>
+FORCEINLINE_ auto ast_walk_of_(F&& hook) -> AstWalk {
+  if constexpr(std::is_void_v<decltype(hook())>) {
+    hook();
+    return AstWalk::Continue;
+  } else {
+    return hook();
+  }
+}
+} // namespace detail_
+
+template<typename Derived>
+auto AstVisitor<Derived>::traverse(AstNode& node) -> bool {
+  switch(node.type_) {
+  #define ASTNODE_X(NAME)                                      \
+  case AstNode::Type::NAME:                                    \
+    return traverse_as(static_cast<Ast##NAME&>(node));
+
+  N19_ASTNODE_TYPE_LIST
+  #undef ASTNODE_X
+  default: UNREACHABLE_ASSERTION;
+  }
+
+  return false;
+}
+
+template<typename Derived>
+template<typename T>
+FORCEINLINE_ auto AstVisitor<Derived>::traverse_as(T& node) -> bool {
+  AstWalk walk = AstWalk::Continue;
+  if constexpr(requires { derived_().enter(node); }) {
+    walk = detail_::ast_walk_of_([&] { return derived_().enter(node); });
+    if(walk == AstWalk::Stop) return false;
+  }
+
+  if(walk == AstWalk::Continue && !traverse_children(node)) {
+    return false;
+  }
+
+  if constexpr(requires { derived_().leave(node); }) {
+    return detail_::ast_walk_of_([&] { return derived_().leave(node); }) != AstWalk::Stop;
+  }
+
+  return true;
+}
+
+template<typename Derived>
+template<typename T>
+FORCEINLINE_ auto AstVisitor<Derived>::traverse_children(T& node) -> bool {
+  bool going = true;
+  ast_for_each_child_of(node, [&](AstNode* child, AstNode::Ptr<>*) {
+    if(going) going = traverse(*child);
+  });
+
+  return going;
+}
+
+END_NAMESPACE(n19);
+#endif //N19_ASTVISITOR_HPP
@@ -0,0 +1,110 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/BuildScheduler.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <queue>
+BEGIN_NAMESPACE(n19);
+
+/// Throughput assumed when nothing has been recorded yet.
+/// Only the ratios between jobs matter for the ordering.
+static constexpr double default_ms_per_byte_ = 1.0 / 1024.0;
+
+auto BuildStats::key_(const sys::String& input) -> std::string {
+  std::error_code ec;
+  auto path = std::filesystem::absolute(input, ec);
+  if(ec) path = input;
+
+  const auto utf8 = path.lexically_normal().generic_u8string();
+  return std::string(utf8.begin(), utf8.end());
+}
+
+auto BuildStats::load(const sys::String& path) -> BuildStats {
+  BuildStats stats;
+  std::ifstream in{std::filesystem::path(path)};
+
+  size_t bytes = 0;
+  double ms    = 0.0;
+  std::string name;
+  while(in >> bytes >> ms && std::getline(in >> std::ws, name)) {
+    if(ms >= 0.0 && !name.empty()) stats.entries_[name] = Entry{bytes, ms};
+  }
+
+  return stats;
+}
+
+auto BuildStats::save(const sys::String& path) const -> Result<void> {
+  const std::filesystem::path target{path};
+  auto temp = target;
+  temp += _nstr(".tmp");
+
+  std::ofstream out{temp, std::ios::trunc};
+  for(const auto& [name, entry] : entries_) {
+    out << entry.bytes_ << ' ' << entry.ms_ << ' ' << name << '\n';
+  }
+
+  out.close();
+  std::error_code ec;
+  if(out.fail()) {
+    std::filesystem::remove(temp, ec);
+    return Error{ErrC::FileIO, "Could not write the build statistics file."};
+  }
+
+  std::filesystem::rename(temp, target, ec);
+  if(ec) {
+    std::filesystem::remove(temp, ec);
+    return Error{ErrC::FileIO, "Could not replace the build statistics file."};
+  }
+
+  return Result<void>::create();
+}
+
+auto BuildStats::record(const sys::String& input, const size_t bytes, const double ms) -> void {
+  entries_[key_(input)] = Entry{bytes, ms};
+}
+
+auto BuildStats::estimate(const sys::String& input, const size_t bytes) const -> double {
+  /// Same file as before: scale its last time by how much it grew.
+  if(const auto it = entries_.find(key_(input)); it != entries_.end() && it->second.bytes_ != 0) {
+    return it->second.ms_ * static_cast<double>(bytes) / static_cast<double>(it->second.bytes_);
+  }
+
+  /// A new file: assume it compiles as fast as everything else did.
+  size_t total_bytes = 0;
+  double total_ms    = 0.0;
+  for(const auto& [name, entry] : entries_) {
+    total_bytes += entry.bytes_;
+    total_ms    += entry.ms_;
+  }
+
+  const double rate = total_bytes ? total_ms / static_cast<double>(total_bytes) : default_ms_per_byte_;
+  return rate * static_cast<double>(bytes);
+}
+
+auto BuildScheduler::order(std::vector<CompileJob>& jobs) -> void {
+  std::ranges::stable_sort(jobs, std::greater{}, &CompileJob::predicted_ms_);
+}
+
+auto BuildScheduler::predict_makespan(const std::span<const CompileJob> jobs, const size_t workers) -> double {
+  std::priority_queue<double, std::vector<double>, std::greater<>> finish;
+  for(size_t i = 0; i < std::max<size_t>(workers, 1); i++) {
+    finish.push(0.0);
+  }
+
+  double makespan = 0.0;
+  for(const auto& job : jobs) {
+    const double done = finish.top() + job.predicted_ms_;
+    finish.pop();
+    finish.push(done);
+    makespan = std::max(makespan, done);
+  }
+
+  return makespan;
+}
+
+END_NAMESPACE(n19);
@@ -0,0 +1,68 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_BUILDSCHEDULER_HPP
+#define N19_BUILDSCHEDULER_HPP
+#include <Core/Result.hpp>
+#include <Sys/String.hpp>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///
+/// How long inputs took to compile last time, kept in a small
+/// text file between runs: one "<bytes> <milliseconds> <path>"
+/// line per input. Only used to guess how long the next
+/// compilation will take, so a missing or damaged file is
+/// treated as having no history at all. Nothing is kept unless
+/// a file is given with --schedule-stats.
+class BuildStats {
+public:
+  static auto load(const sys::String& path) -> BuildStats;
+
+  /// Writes a temporary file next to path and renames it over
+  /// path, so concurrent builds never see a half written file.
+  auto save(const sys::String& path) const -> Result<void>;
+
+  auto record(const sys::String& input, size_t bytes, double ms) -> void;
+  auto estimate(const sys::String& input, size_t bytes) const -> double;
+
+  struct Entry {
+    size_t bytes_ = 0;
+    double ms_    = 0.0;
+  };
+
+  std::unordered_map<std::string, Entry> entries_;
+private:
+  static auto key_(const sys::String& input) -> std::string;
+};
+
+struct CompileJob {
+  sys::String input_;
+  sys::String output_;
+  size_t bytes_        = 0;
+  double predicted_ms_ = 0.0;
+  double actual_ms_    = 0.0;
+  bool ok_             = false;
+};
+
+///
+/// Longest processing time first: the most expensive jobs are
+/// started first, so the one huge input doesn't get picked up
+/// last and leave every other worker idle while it finishes.
+class BuildScheduler {
+public:
+  static auto order(std::vector<CompileJob>& jobs) -> void;
+
+  /// The makespan LPT would give with the predicted costs,
+  /// handing each job to whichever worker frees up first.
+  static auto predict_makespan(std::span<const CompileJob> jobs, size_t workers) -> double;
+};
+
+END_NAMESPACE(n19);
+#endif //N19_BUILDSCHEDULER_HPP
@@ -0,0 +1,209 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/CallGraph.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <IO/Console.hpp>
+#include <IO/Fmt.hpp>
+#include <algorithm>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+///
+/// Static frequency estimates: a loop body is assumed
+/// to run a handful of times, each arm of a conditional about
+/// half of the time. Good enough to rank call sites.
+static constexpr double loop_weight_   = 8.0;
+static constexpr double branch_weight_ = 0.5;
+
+static auto weight_of_(const AstNode& node) -> double {
+  switch(node.type_) {
+  case AstNode::Type::For:       FALLTHROUGH_;
+  case AstNode::Type::While:     return loop_weight_;
+  case AstNode::Type::If:        FALLTHROUGH_;
+  case AstNode::Type::Else:      FALLTHROUGH_;
+  case AstNode::Type::Case:      FALLTHROUGH_;
+  case AstNode::Type::Default:   FALLTHROUGH_;
+  case AstNode::Type::Where:     FALLTHROUGH_;
+  case AstNode::Type::Otherwise: return branch_weight_;
+  default:                       return 1.0;
+  }
+}
+
+auto callee_key(const AstNode& node) -> Maybe<std::string> {
+  switch(node.type_) {
+  case AstNode::Type::EntityRef:
+    return fmt("#{}", static_cast<const AstEntityRef&>(node).id_);
+  case AstNode::Type::EntityRefThunk:
+    return static_cast<const AstEntityRefThunk&>(node).name_;
+  default:
+    return Nothing;
+  }
+}
+
+auto CallGraph::build(AstNode::Children<>& decls) -> CallGraph {
+  CallGraph graph;
+  graph.collect_(decls);
+
+  for(uint32_t i = 0; i < graph.nodes_.size(); i++) {
+    graph.rescan(i);
+  }
+
+  graph.compute_sccs_();
+  return graph;
+}
+
+auto CallGraph::collect_(AstNode::Children<>& decls) -> void {
+  for(auto& decl : decls) {
+    if(!decl) continue;
+    if(decl->type_ == AstNode::Type::Namespace) {
+      collect_(static_cast<AstNamespace&>(*decl).body_);
+      continue;
+    } if(decl->type_ != AstNode::Type::ProcDecl) {
+      continue;
+    }
+
+    auto& proc = static_cast<AstProcDecl&>(*decl);
+    auto key   = proc.name_ ? callee_key(*proc.name_) : Maybe<std::string>{Nothing};
+    if(!key.has_value() || index_.contains(*key)) continue;
+
+    index_[*key] = static_cast<uint32_t>(nodes_.size());
+    auto& node   = nodes_.emplace_back();
+    node.proc_   = &proc;
+    node.name_   = std::move(*key);
+  }
+}
+
+auto CallGraph::rescan(const uint32_t index) -> void {
+  ASSERT(index < nodes_.size());
+  auto& node = nodes_[index];
+  node.sites_.clear();
+  node.unresolved_ = 0;
+  node.size_ = ast_size(*node.proc_);
+
+  for(auto& stmt : node.proc_->body_) {
+    if(stmt) scan_(node, *stmt, &stmt, 1.0);
+  }
+}
+
+auto CallGraph::scan_(Node& node, AstNode& ast, AstNode::Ptr<>* slot, const double freq) -> void {
+  if(ast.type_ == AstNode::Type::ProcDecl) {
+    return;                        /// Nested procedures are separate nodes.
+  }
+
+  const double child_freq = freq * weight_of_(ast);
+  ast_for_each_child(ast, [&](AstNode* child, AstNode::Ptr<>* child_slot) {
+    scan_(node, *child, child_slot, child_freq);
+  });
+
+  if(ast.type_ != AstNode::Type::Call) {
+    return;
+  }
+
+  ///
+  /// Sites are recorded after their arguments, so that inlining
+  /// them in order never invalidates the slot of a later site.
+  auto& call = static_cast<AstCall&>(ast);
+  auto key   = call.target_ ? callee_key(*call.target_) : Maybe<std::string>{Nothing};
+  auto it    = key.has_value() ? index_.find(*key) : index_.end();
+
+  if(it == index_.end() || slot == nullptr) {
+    ++node.unresolved_;
+    return;
+  }
+
+  node.sites_.emplace_back(Site{&call, slot, it->second, freq});
+}
+
+auto CallGraph::compute_sccs_() -> void {
+  ///
+  /// Iterative Tarjan. SCCs are emitted in reverse topological
+  /// order, which is exactly the bottom-up order we want.
+  constexpr uint32_t unvisited = UINT32_MAX;
+  const auto count = static_cast<uint32_t>(nodes_.size());
+
+  std::vector<uint32_t> order(count, unvisited);
+  std::vector<uint32_t> low(count, 0);
+  std::vector<bool> on_stack(count, false);
+  std::vector<uint32_t> stack;
+  std::vector<std::pair<uint32_t, size_t>> work;  /// (node, next site)
+  uint32_t counter = 0;
+
+  sccs_.clear();
+  for(uint32_t root = 0; root < count; root++) {
+    if(order[root] != unvisited) continue;
+    work.emplace_back(root, 0);
+
+    while(!work.empty()) {
+      auto& [curr, next] = work.back();
+      if(next == 0 && order[curr] == unvisited) {
+        order[curr] = low[curr] = counter++;
+        stack.emplace_back(curr);
+        on_stack[curr] = true;
+      }
+
+      const auto& sites = nodes_[curr].sites_;
+      if(next < sites.size()) {
+        const uint32_t callee = sites[next++].callee_;
+        if(order[callee] == unvisited) {
+          work.emplace_back(callee, 0);
+        } else if(on_stack[callee]) {
+          low[curr] = std::min(low[curr], order[callee]);
+        }
+        continue;
+      }
+
+      if(low[curr] == order[curr]) {
+        auto& scc = sccs_.emplace_back();
+        uint32_t member = 0;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          on_stack[member] = false;
+          nodes_[member].scc_ = static_cast<uint32_t>(sccs_.size() - 1);
+          scc.emplace_back(member);
+        } while(member != curr);
+      }
+
+      const uint32_t finished = curr;
+      work.pop_back();
+      if(!work.empty()) {
+        const uint32_t caller = work.back().first;
+        low[caller] = std::min(low[caller], low[finished]);
+      }
+    }
+  }
+}
+
+auto CallGraph::find(const std::string_view name) const -> Maybe<uint32_t> {
+  const auto it = index_.find(std::string{name});
+  if(it == index_.end()) return Nothing;
+  return it->second;
+}
+
+auto CallGraph::dump(OStream& stream) const -> void {
+  for(size_t i = 0; i < sccs_.size(); i++) {
+    stream << Con::Bold << fmt("SCC {}", i) << Con::Reset;
+    if(sccs_[i].size() > 1) stream << " (recursive)";
+    stream << "\n";
+
+    for(const uint32_t member : sccs_[i]) {
+      const auto& node = nodes_[member];
+      stream
+        << "  "
+        << Con::MagentaFG << node.name_ << Con::Reset
+        << fmt(" size={} unresolved={}\n", node.size_, node.unresolved_);
+
+      for(const auto& site : node.sites_) {
+        stream
+          << "    -> "
+          << nodes_[site.callee_].name_
+          << fmt(" freq={:.2f} line={}\n", site.freq_, site.call_->line_);
+      }
+    }
+  }
+}
+
+END_NAMESPACE(n19);
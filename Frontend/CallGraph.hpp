@@ -0,0 +1,70 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_CALLGRAPH_HPP
+#define N19_CALLGRAPH_HPP
+#include <Frontend/AstNodes.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Maybe.hpp>
+#include <IO/Stream.hpp>
+#include <unordered_map>
+#include <string_view>
+#include <string>
+#include <vector>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///
+/// The call graph of a module, built from the bodies of
+/// every AstProcDecl and the AstCall nodes within them.
+/// Procedures are identified by callee_key(), so a call only
+/// becomes an edge if its target names a procedure in the module.
+class CallGraph {
+  N19_MAKE_NONCOPYABLE(CallGraph);
+  N19_MAKE_DEFAULT_MOVE_CONSTRUCTIBLE(CallGraph);
+public:
+  struct Site {
+    AstCall* call_        = nullptr;  /// The call expression.
+    AstNode::Ptr<>* slot_ = nullptr;  /// The pointer that owns the call.
+    uint32_t callee_      = 0;        /// Index of the callee node.
+    double freq_          = 1.0;      /// Estimated executions per caller invocation.
+  };
+
+  struct Node {
+    AstProcDecl* proc_ = nullptr;
+    std::string name_;
+    std::vector<Site> sites_;         /// Resolved calls, innermost first.
+    size_t unresolved_ = 0;           /// Calls to targets outside of the module.
+    size_t size_       = 0;           /// Amount of AST nodes in the declaration.
+    uint32_t scc_      = 0;           /// Index into sccs_.
+  };
+
+  static auto build(AstNode::Children<>& decls) -> CallGraph;
+
+  /// Re-scans a single procedure after its body was changed.
+  auto rescan(uint32_t node) -> void;
+  auto find(std::string_view name) const -> Maybe<uint32_t>;
+  auto dump(OStream& stream) const -> void;
+
+  std::vector<Node> nodes_;
+  std::vector<std::vector<uint32_t>> sccs_;  /// Bottom-up: callees come before callers.
+  std::unordered_map<std::string, uint32_t> index_;
+
+  ~CallGraph() = default;
+  CallGraph() = default;
+private:
+  auto collect_(AstNode::Children<>& decls) -> void;
+  auto scan_(Node& node, AstNode& ast, AstNode::Ptr<>* slot, double freq) -> void;
+  auto compute_sccs_() -> void;
+};
+
+///
+/// Identifies the procedure named by a declaration's name
+/// or a call's target. Resolved references are keyed by entity
+/// ID, unresolved ones by their name.
+auto callee_key(const AstNode& node) -> Maybe<std::string>;
+
+END_NAMESPACE(n19);
+#endif //N19_CALLGRAPH_HPP
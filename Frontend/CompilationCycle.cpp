@@ -4,92 +4,139 @@
 */
 
 #include <Frontend/CompilationCycle.hpp>
+#include <Frontend/CompilerInstance.hpp>
+#include <Frontend/BuildScheduler.hpp>
 #include <Frontend/FrontendContext.hpp>
-#include <Frontend/Parser.hpp>
-#include <IO/Console.hpp>
 #include <Core/Panic.hpp>
 #include <Core/Defer.hpp>
+#include <Core/FastExit.hpp>
+#include <Sys/File.hpp>
+#include <Sys/Time.hpp>
+#include <Sys/Topology.hpp>
+#include <IO/Fmt.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 BEGIN_NAMESPACE(n19);
 
+static auto input_size_(const sys::String& input) -> size_t {
+  auto file = sys::File::open(input, false, sys::File::Read);
+  if(!file.has_value()) return 0;   /// compile() reports this one.
+
+  DEFER({ file->close(); });
+  return file->size().value_or(0);
+}
+
 bool begin_global_compilation_cycles() {
   [[maybe_unused]] auto& inputs  = Context::the().inputs_;
   [[maybe_unused]] auto& outputs = Context::the().outputs_;
-  
+
   ASSERT(inputs.size() == outputs.size());
   ASSERT(!outputs.empty() && !inputs.empty());
-  
-  /// Note: only handle a single output file for now.
-  /// Ignore any additional passed ones. Parallel compilation
-  /// is an undecided issue.
-
-  [[maybe_unused]] auto& in  = inputs[0];
-  [[maybe_unused]] auto& out = outputs[0];
-
-  auto ref = sys::File::open(in, false, sys::File::Read);
-  if (!ref.has_value()) {
-    errs()
-      << Con::RedFG
-      << "Error:"
-      << Con::Reset
-      << " Could not open input file "
-      << in
-      << ".\n"
-      << ref.error().msg
-      << "\n";
-    return false;
+
+  const auto flags   = Context::the().flags_;
+  const bool verbose = flags & Context::Verbose;
+
+  ///
+  /// Estimate what every input is going to cost, and
+  /// start with the most expensive ones.
+  const auto& stats_path = Context::the().schedule_stats_;
+  auto stats = stats_path.empty() ? BuildStats{} : BuildStats::load(stats_path);
+  std::vector<CompileJob> jobs(inputs.size());
+  for(size_t i = 0; i < inputs.size(); i++) {
+    jobs[i].input_        = inputs[i];
+    jobs[i].output_       = outputs[i];
+    jobs[i].bytes_        = input_size_(inputs[i]);
+    jobs[i].predicted_ms_ = stats.estimate(inputs[i], jobs[i].bytes_);
   }
 
-  DEFER_IF(!ref->is_invalid(), {
-    ref->close();
-  });
+  BuildScheduler::order(jobs);
+  const size_t cpus    = sys::CpuTopology::the().size();
+  const size_t workers = std::clamp<size_t>(cpus, 1, jobs.size());
+  const double predicted_makespan = BuildScheduler::predict_makespan(jobs, workers);
 
-  auto lxr = Lexer::create_shared(*ref);
-  if (!lxr) {
-    errs()
-      << Con::RedFG
-      << "Error:"
-      << Con::Reset
-      << " Could not open input file "
-      << in
-      << ".\n"
-      << lxr.error().msg
-      << "\n";
-    return false;
+  ///
+  /// With several jobs in flight, each one's output is held back
+  /// and written out whole when it finishes. The CPUs are split
+  /// between the jobs so that their parsers don't oversubscribe.
+  std::vector<std::unique_ptr<CompilerInstance>> instances(jobs.size());
+  std::atomic<size_t> next = 0;
+  std::mutex console;
+
+  const auto work = [&] {
+    for(size_t i = next++; i < jobs.size(); i = next++) {
+      auto& job      = jobs[i];
+      auto& instance = instances[i];
+      instance = std::make_unique<CompilerInstance>();
+      instance->flags_         = flags;
+      instance->opt_level_     = Context::the().opt_level_;
+      instance->input_         = job.input_;
+      instance->output_        = job.output_;
+      instance->parse_threads_ = workers > 1 ? std::max<size_t>(1, cpus / workers) : 0;
+
+      StringOStream out, err;
+      if(workers > 1) {
+        instance->out_ = &out;
+        instance->err_ = &err;
+      }
+
+      sys::Stopwatch watch;
+      job.ok_        = instance->compile();
+      job.actual_ms_ = watch.elapsed_ms();
+
+      if(workers > 1) {
+        std::scoped_lock lock(console);
+        outs() << out.str_;
+        errs() << err.str_;
+      }
+    }
+  };
+
+  sys::Stopwatch makespan;
+  std::vector<std::thread> pool;
+  for(size_t w = 1; w < workers; w++) {
+    pool.emplace_back(work);
   }
 
-  ErrorCollector errors;
-#ifdef N19_WIN32
-  EntityTable tbl(std::filesystem::absolute(ref->path()).wstring());
-#else
-  EntityTable tbl(std::filesystem::absolute(ref->path()).string());
-#endif
-  
-  ParseContext ctx(errs(), errors, *(*lxr), tbl);
-
-  if (!parse(ctx)) 
-    return false;
-
-  if (Context::the().flags_ & Context::DumpAST) {
-    for (const auto& decl : ctx.toplevel_decls_) {
-      decl->print(0, outs(), Nothing);
+  work();
+  for(auto& thread : pool) thread.join();
+  const double actual_makespan = makespan.elapsed_ms();
+
+  /// With fast exit enabled, the AST, the entity table and the lexer
+  /// outlive this function and are never destroyed: the process
+  /// leaves through FastExit::exit() once the driver is done.
+  if(FastExit::get().enabled_) {
+    for(auto& instance : instances) {
+      FastExit::get().retain(std::move(instance));
     }
-    outs() << "\n";
   }
-  
-  if (Context::the().flags_ & Context::DumpEnts) {
+
+  for(const auto& job : jobs) {
+    if(job.ok_) stats.record(job.input_, job.bytes_, job.actual_ms_);
+  }
+
+  if(!stats_path.empty()) (void)stats.save(stats_path);
+  if(verbose) {
+    for(const auto& job : jobs) {
+      outs()
+        << Con::Bold
+        << job.input_
+        << Con::Reset
+        << fmt(": {} bytes, predicted {:.2f} ms, took {:.2f} ms\n",
+          job.bytes_, job.predicted_ms_, job.actual_ms_);
+    }
+
     outs()
       << Con::Bold
-      << "---- Pre Check Phase Entity Table\n"
-      << Con::Reset;
-    ctx.entities.dump(outs());
-    ctx.entities.dump_structures(outs());
+      << "Makespan"
+      << Con::Reset
+      << fmt(": predicted {:.2f} ms, took {:.2f} ms on {} worker(s)\n",
+        predicted_makespan, actual_makespan, workers);
   }
-  
-  /// TODO: once the rest of the compiler is finished, 
-  /// handle other compilation tasks like checking, codegen, 
-  /// etc here.
 
-  return true;
+  return std::ranges::all_of(jobs, &CompileJob::ok_);
 }
 
 END_NAMESPACE(n19);
@@ -0,0 +1,154 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/CompilerInstance.hpp>
+#include <Frontend/ParseContext.hpp>
+#include <Frontend/Parser.hpp>
+#include <Frontend/ModuleInterface.hpp>
+#include <Frontend/PassManager.hpp>
+#include <Frontend/FlightRecorder.hpp>
+#include <Core/Defer.hpp>
+#include <Sys/File.hpp>
+#include <filesystem>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+auto CompilerInstance::compile() -> bool {
+  auto ref = sys::File::open(input_, false, sys::File::Read);
+  if (!ref.has_value()) {
+    *err_
+      << Con::RedFG
+      << "Error:"
+      << Con::Reset
+      << " Could not open input file "
+      << input_
+      << ".\n"
+      << ref.error().msg
+      << "\n";
+    return false;
+  }
+
+  DEFER_IF(!ref->is_invalid(), {
+    ref->close();
+  });
+
+  auto lxr = Lexer::create_shared(*ref);
+  if (!lxr) {
+    *err_
+      << Con::RedFG
+      << "Error:"
+      << Con::Reset
+      << " Could not open input file "
+      << input_
+      << ".\n"
+      << lxr.error().msg
+      << "\n";
+    return false;
+  }
+
+  lxr_ = lxr.release_value();
+#ifdef N19_WIN32
+  return run_(std::filesystem::absolute(ref->path()).wstring());
+#else
+  return run_(std::filesystem::absolute(ref->path()).string());
+#endif
+}
+
+auto CompilerInstance::compile_source(std::vector<char8_t>&& src, const sys::String& name) -> bool {
+  if (src.empty()) {
+    *err_
+      << Con::RedFG
+      << "Error:"
+      << Con::Reset
+      << " Input "
+      << name
+      << " is empty.\n";
+    return false;
+  }
+
+  lxr_ = MUST(Lexer::create_shared(std::move(src)));
+  lxr_->file_name_ = name;
+  return run_(name);
+}
+
+auto CompilerInstance::run_(const sys::String& name) -> bool {
+  entities_ = std::make_unique<EntityTable>(EntityTable::builtins(), name);
+  decls_.clear();
+
+  flight::file(name);
+  flight::phase(flight::Parse);
+  ParseContext ctx(*err_, errors_, *lxr_, *entities_);
+  ctx.threads_ = parse_threads_;
+  ctx.pin_workers_ = !(flags_ & Context::NoPin);
+
+  /// Declaration-only runs (entity dumps, interfaces) never
+  /// look inside a procedure, so its body is skipped over.
+  const bool decls_only = flags_ & Context::DeclOnly;
+  ctx.lazy_bodies_ = decls_only;
+
+  const bool parsed = parse(ctx);
+  decls_ = std::move(ctx.toplevel_decls_);
+  if (!parsed) {
+    return false;
+  }
+
+  if (!decls_only) {
+    flight::phase(flight::Optimize);
+    const bool remarks = flags_ & Context::OptRmrks;
+    auto passes = PassManager::for_level(opt_level_, remarks ? out_ : nullptr);
+    passes.pin_workers_ = !(flags_ & Context::NoPin);
+    passes.run(decls_);
+
+    if (flags_ & Context::TimePass) {
+      passes.dump_timings(*out_);
+    }
+  }
+
+  if (flags_ & (Context::DumpAST | Context::DumpEnts)) {
+    flight::phase(flight::Dump);
+  }
+
+  if (flags_ & Context::DumpAST) {
+    for (const auto& decl : decls_) {
+      decl->print(0, *out_, Nothing);
+    }
+    *out_ << "\n";
+  }
+
+  if (flags_ & Context::DumpEnts) {
+    *out_
+      << Con::Bold
+      << "---- Pre Check Phase Entity Table\n"
+      << Con::Reset;
+    entities_->dump(*out_);
+    entities_->dump_structures(*out_);
+  }
+
+  if (flags_ & Context::EmitIntf) {
+    flight::phase(flight::Interface);
+    const auto iface_path = ModuleInterface::path_for(name);
+    auto written = ModuleInterface::write(*entities_, iface_path);
+    if (!written.has_value()) {
+      *err_
+        << Con::RedFG
+        << "Error:"
+        << Con::Reset
+        << " Could not write module interface "
+        << iface_path
+        << ".\n"
+        << written.error().msg
+        << "\n";
+      return false;
+    }
+  }
+
+  /// TODO: once the rest of the compiler is finished,
+  /// handle other compilation tasks like checking, codegen,
+  /// etc here.
+
+  return true;
+}
+
+END_NAMESPACE(n19);
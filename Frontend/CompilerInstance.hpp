@@ -0,0 +1,64 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_COMPILERINSTANCE_HPP
+#define N19_COMPILERINSTANCE_HPP
+#include <Frontend/FrontendContext.hpp>
+#include <Frontend/ErrorCollector.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Frontend/AstNodes.hpp>
+#include <Frontend/Lexer.hpp>
+#include <Core/ClassTraits.hpp>
+#include <IO/Console.hpp>
+#include <IO/Stream.hpp>
+#include <Sys/String.hpp>
+#include <type_traits>
+#include <memory>
+#include <vector>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///
+/// One compilation, with everything it needs carried along instead
+/// of read from Context::the(): its flags, its input, where output
+/// goes, and the entity table and AST it produces. Instances don't
+/// share any state, so a host process can run as many of them as it
+/// likes, on as many threads as it likes. The default sinks are the
+/// global console streams, which aren't synchronized: give every
+/// instance that runs concurrently its own.
+class CompilerInstance {
+  N19_MAKE_NONCOPYABLE(CompilerInstance);
+  N19_MAKE_NONMOVABLE(CompilerInstance);
+public:
+  /// Compiles input_. Returns false if the input couldn't be
+  /// read, or if it didn't make it through a compilation phase.
+  auto compile() -> bool;
+
+  /// Compiles source that's already in memory. name is only
+  /// used to label diagnostics and entities.
+  auto compile_source(std::vector<char8_t>&& src, const sys::String& name) -> bool;
+
+  std::underlying_type_t<Context::Flags> flags_{};
+  int64_t opt_level_ = 0;
+  size_t parse_threads_ = 0;        /// Zero: one per hardware thread.
+
+  sys::String input_;
+  sys::String output_;
+  OStream* out_ = &outs();          /// Dumps, remarks and timings.
+  OStream* err_ = &errs();          /// Diagnostics.
+
+  ErrorCollector errors_;
+  std::unique_ptr<EntityTable> entities_;
+  AstNode::Children<> decls_;
+  std::shared_ptr<Lexer> lxr_;
+
+ ~CompilerInstance() = default;
+  CompilerInstance() = default;
+private:
+  auto run_(const sys::String& name) -> bool;
+};
+
+END_NAMESPACE(n19);
+#endif //N19_COMPILERINSTANCE_HPP
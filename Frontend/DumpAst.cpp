@@ -4,7 +4,9 @@
 */
 
 #include <Frontend/AstNodes.hpp>
+#include <algorithm>
 #include <cctype>
+#include <string_view>
 BEGIN_NAMESPACE(n19);
 
 auto AstNode::print_(
@@ -280,6 +282,12 @@ auto AstProcDecl::print(
       << fmt("\"{}\" ", *alias)
       << Con::Reset;
 
+  if(lazy_body_)
+    stream
+      << Con::WhiteFG
+      << "body = unparsed"
+      << Con::Reset;
+
   stream << '\n';
   name_->print(depth + 1, stream, "ProcDecl.Name");
 
@@ -437,6 +445,57 @@ auto AstSubscript::print(
   value_->print(depth + 1, stream, "Subscript.Value");
 }
 
+auto AstEmbed::print(
+  const uint32_t depth,
+  OStream& stream,
+  const Maybe<std::string> &alias ) const -> void
+{
+  print_(depth, stream, "Embed");
+  if(alias.has_value())
+    stream
+      << Con::GreenFG
+      << fmt("\"{}\" ", *alias)
+      << Con::Reset;
+
+  const auto data = bytes();
+  stream
+    << Con::BlueFG
+    << data.size()
+    << " bytes"
+    << Con::Reset
+    << '\n';
+
+  ///
+  /// Rows of 16, formatted right out of the mapping. Only the
+  /// first few: embedded files can be hundreds of megabytes.
+  constexpr std::string_view digits = "0123456789abcdef";
+  constexpr size_t max_dumped = 64;
+  const size_t dumped = std::min(data.size(), max_dumped);
+  char line[16 * 3];
+  for(size_t row = 0; row < dumped; row += 16) {
+    for(uint32_t i = 0; i <= depth; i++)
+      stream << "  |";
+    stream << "  ";
+
+    const size_t end = std::min(row + 16, dumped);
+    size_t len = 0;
+    for(size_t i = row; i < end; i++) {
+      const auto byte = static_cast<uint8_t>(data[i]);
+      line[len++] = digits[byte >> 4];
+      line[len++] = digits[byte & 0xF];
+      line[len++] = ' ';
+    }
+
+    stream << std::string_view(line, len) << '\n';
+  }
+
+  if(dumped < data.size()) {
+    for(uint32_t i = 0; i <= depth; i++)
+      stream << "  |";
+    stream << fmt("  ... {} more bytes\n", data.size() - dumped);
+  }
+}
+
 auto AstBinExpr::print(
   const uint32_t depth,
   OStream& stream,
@@ -566,6 +625,18 @@ auto AstAggregateLiteral::print(
       << fmt("\"{}\" ", *alias)
       << Con::Reset;
 
+  if(packed_) {
+    stream
+      << Con::BlueFG
+      << "packed = "
+      << packed_->size()
+      << (packed_->kind_ == AstScalarLiteral::FloatLit ? " x float" :
+          packed_->kind_ == AstScalarLiteral::BoolLit  ? " x bool"  : " x int")
+      << Con::Reset
+      << '\n';
+    return;
+  }
+
   stream << '\n';
   for(const auto& child : children_)
     child->print(depth + 1, stream, Nothing);
@@ -4,9 +4,16 @@
 */
 
 #include <Frontend/EntityTable.hpp>
+#include <Frontend/ModuleInterface.hpp>
 #include <algorithm>
+#include <type_traits>
+#include <unordered_set>
+#include <tuple>
 BEGIN_NAMESPACE(n19);
 
+static stats::Counter symlink_hops_{"entities.symlink_hops"};
+static stats::Counter lookups_{"entities.lookups"};
+
 EntityTable::EntityTable(const sys::String& name) {
   /// Initialize the root entity.
   root_         = std::make_shared<RootEntity>();
@@ -44,16 +51,68 @@ EntityTable::EntityTable(const sys::String& name) {
   curr_id_ = BuiltinType::AfterLastID;
 }
 
+EntityTable::EntityTable(std::shared_ptr<const EntityTable> base, const sys::String& name)
+  : root_(base->root_), base_(std::move(base))
+{
+  curr_id_ = base_->curr_id_;
+  if(!name.empty()) {
+    own(N19_ROOT_ENTITY_ID)->file_ = name;
+  }
+}
+
+auto EntityTable::builtins() -> std::shared_ptr<const EntityTable> {
+  static const auto base = std::make_shared<const EntityTable>(sys::String{});
+  return base;
+}
+
+static auto clone_(const Entity& entity) -> Entity::Ptr<> {
+  switch(entity.type_) {
+  #define X(NAME)                                                \
+  case EntityType::NAME:                                         \
+    if constexpr(!std::is_abstract_v<NAME>) {                    \
+      return std::make_shared<NAME>(static_cast<const NAME&>(entity)); \
+    }                                                            \
+    break;
+
+  N19_ENTITY_TYPE_LIST
+  #undef X
+  default: break;
+  }
+
+  UNREACHABLE_ASSERTION;
+  return nullptr;
+}
+
+auto EntityTable::own(const Entity::ID id) -> Entity::Ptr<> {
+  const auto guard = guard_();
+  if(const auto it = map_.find(id); it != map_.end()) {
+    return it->second;
+  }
+
+  const Entity::Ptr<>* slot = slot_(id);
+  ASSERT(slot != nullptr && *slot != nullptr);
+  auto copy = clone_(**slot);
+  map_[id] = copy;
+
+  if(id == N19_ROOT_ENTITY_ID) {
+    root_ = Entity::cast<RootEntity>(copy);
+  }
+
+  return copy;
+}
+
 auto EntityTable::resolve_link(Entity::Ptr<SymLink> ptr) const -> Entity::Ptr<> {
   ASSERT(ptr);
+  const auto guard = guard_();
   Entity::Ptr<> curr;
   Entity::Ptr<SymLink> next = ptr;
 
   do {
     ASSERT(next->link_ != N19_INVALID_ENTITY_ID);
     ASSERT(exists(next->link_));
-    curr = map_.at(next->link_);
+    curr = *slot_(next->link_);
     next = Entity::try_cast<SymLink>(curr);
+    symlink_hops_.add();
   } while(next);
 
   return curr;
@@ -61,24 +120,203 @@ auto EntityTable::resolve_link(Entity::Ptr<SymLink> ptr) const -> Entity::Ptr<>
 
 auto EntityTable::exists(const Entity::ID id) const -> bool {
   ASSERT(id != N19_INVALID_ENTITY_ID);
-  return map_.contains(id);
+  const auto guard = guard_();
+  return slot_(id) != nullptr;
 }
 
 auto EntityTable::find(const Entity::ID id) const -> Entity::Ptr<> {
   ASSERT(exists(id));
-  auto ptr  = map_.at(id);
+  const auto guard = guard_();
+  auto ptr  = *slot_(id);
   auto link = Entity::try_cast<SymLink>(ptr);
   if(link) return resolve_link(link);
   return ptr;
 }
 
+auto EntityTable::find_direct(const Entity::ID id) const -> Entity::Ptr<> {
+  const auto guard = guard_();
+  const auto slot  = slot_(id);
+  return slot != nullptr ? *slot : nullptr;
+}
+
+auto EntityTable::lookup_local(const std::string_view name) const -> Entity::Ptr<> {
+  constexpr std::string_view sep = "::";
+  if(!name.starts_with(sep)) return nullptr;
+  if(name == sep) return root_;
+
+  const auto guard = guard_();
+  Entity::Ptr<> curr = root_;
+  std::string_view rest = name.substr(sep.size());
+  while(curr != nullptr && !rest.empty()) {
+    const size_t end = rest.find(sep);
+    const std::string_view part = rest.substr(0, end);
+    rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end + sep.size());
+
+    Entity::Ptr<> next = nullptr;
+    for(const Entity::ID child : curr->chldrn_) {
+      const auto slot = slot_(child);
+      if(slot != nullptr && (*slot)->lname_ == part) {
+        next = *slot;
+        break;
+      }
+    }
+
+    curr = std::move(next);
+  }
+
+  return curr;
+}
+
+auto EntityTable::lookup(const std::string_view name) -> Entity::Ptr<> {
+  const auto guard = guard_();
+  lookups_.add();
+  if(auto local = lookup_local(name)) {
+    return local;                     /// Declared here, or already imported.
+  }
+
+  for(const auto& iface : imports_) { /// Materialize it from the first
+    auto ent = iface->resolve(*this, name);
+    if(ent.has_value() && ent.value() != nullptr) return ent.value();
+  }                                   /// interface that exports the name.
+                                      /// A corrupt one exports nothing.
+
+  return nullptr;
+}
+
+auto EntityTable::entities_of(const sys::String& file) const -> std::vector<Entity::ID> {
+  const auto guard = guard_();
+  std::vector<Entity::ID> out;
+  for(const EntityTable* layer = this; layer != nullptr; layer = layer->base_.get()) {
+    const auto it = layer->file_index_.find(file);
+    if(it == layer->file_index_.end()) continue;
+    for(const Entity::ID id : layer->file_entities_[it->second]) {
+      const auto slot = slot_(id);
+      if(slot != nullptr && (*slot)->file_ == file) out.emplace_back(id);
+    }
+  }
+
+  /// A reused ID can be listed twice for the same file.
+  std::ranges::sort(out);
+  const auto [first, last] = std::ranges::unique(out);
+  out.erase(first, last);
+  return out;
+}
+
+auto EntityTable::remove_file(const sys::String& file) -> size_t {
+  const auto guard = guard_();
+  auto roots = entities_of(file);
+  if(const auto it = file_index_.find(file); it != file_index_.end()) {
+    file_entities_[it->second].clear();
+  }
+
+  return remove_(std::move(roots));
+}
+
+auto EntityTable::remove(const Entity::ID id) -> size_t {
+  const auto guard = guard_();
+  return remove_({id});
+}
+
+auto EntityTable::remove_(std::vector<Entity::ID>&& roots) -> size_t {
+  /// Everything going away: the roots, and whatever
+  /// is below them, whichever file declared it.
+  std::unordered_set<Entity::ID> doomed;
+  std::vector<Entity::ID> order;
+  while(!roots.empty()) {
+    const Entity::ID id = roots.back();
+    roots.pop_back();
+
+    const auto slot = slot_(id);
+    if(id < BuiltinType::AfterLastID || slot == nullptr) continue;
+    if(!doomed.insert(id).second) continue;
+    order.emplace_back(id);
+    roots.insert(roots.end(), (*slot)->chldrn_.begin(), (*slot)->chldrn_.end());
+  }
+
+  /// One pass over each surviving parent's children,
+  /// however many of them are being removed.
+  std::unordered_set<Entity::ID> parents;
+  for(const Entity::ID id : order) {
+    const Entity::ID parent = (*slot_(id))->parent_;
+    if(!doomed.contains(parent) && slot_(parent) != nullptr) parents.insert(parent);
+  }
+
+  for(const Entity::ID parent : parents) {
+    std::erase_if(own(parent)->chldrn_, [&](const Entity::ID child) { return doomed.contains(child); });
+  }
+
+  /// Entities the base can still see are shadowed
+  /// with a tombstone, the rest are just dropped.
+  for(const Entity::ID id : order) {
+    if(base_ != nullptr && base_->slot_(id) != nullptr) map_[id] = nullptr;
+    else map_.erase(id);
+    free_ids_.emplace_back(id);
+  }
+
+  /// Imports cache the IDs they materialized records
+  /// as, which mustn't outlive the entities.
+  for(const auto& iface : imports_) {
+    iface->forget(doomed);
+  }
+
+  return order.size();
+}
+
+auto EntityTable::reserve_ids(const Entity::ID count) -> IdRange {
+  const auto guard = guard_();
+  const IdRange range{ curr_id_, curr_id_ + count };
+  curr_id_ += count;
+  return range;
+}
+
+auto EntityTable::set_concurrent(const bool concurrent) -> void {
+  if(concurrent_ == concurrent) return;
+  concurrent_ = concurrent;
+
+  ///
+  /// Threads append to shared parents (the root, most of the
+  /// time) in whatever order they get there. Remember where each
+  /// parent's children end for now, everything after that is new.
+  if(concurrent) {
+    for(const auto& [id, entity] : map_) {   /// Tombstones too: their IDs may be
+      settled_.emplace(id, entity != nullptr   /// reused by entities with none yet.
+        ? entity->chldrn_.size() : 0);
+    }
+    return;
+  }
+
+  ///
+  /// The new children all come from the one file being parsed,
+  /// sort them by where they're declared in it. Not by ID: freed
+  /// IDs get reused, so they don't follow declaration order. Anything
+  /// a thread appended to is in this layer, owned on the way.
+  const auto declared = [&](const Entity::ID id) {
+    const auto& child = *slot_(id);
+    return std::tuple{child->line_, child->pos_, id};
+  };
+
+  for(auto& [id, entity] : map_) {
+    if(entity == nullptr) continue;
+    const auto it = settled_.find(id);
+    const auto base = base_ != nullptr ? base_->slot_(id) : nullptr;
+    const size_t settled = it != settled_.end() ? it->second
+      : base != nullptr && *base != nullptr ? (*base)->chldrn_.size() : 0;
+
+    auto& children = entity->chldrn_;
+    const auto first = children.begin() + static_cast<ptrdiff_t>(std::min(settled, children.size()));
+    std::ranges::sort(first, children.end(), {}, declared);
+  }
+
+  settled_.clear();
+}
+
 auto EntityTable::dump(OStream& stream) -> void {
   root_->print(0, stream, *this);
 }
 
 auto EntityTable::dump_structures(OStream& stream) -> void {
-  for(auto &[id, entity] : map_) {
-    if(entity->type_ != EntityType::Struct) continue;
+  for_each([&](const Entity::Ptr<>& entity) {
+    if(entity->type_ != EntityType::Struct) return;
     auto ptr = Entity::cast<Struct>(entity);
     stream
       << "-- "
@@ -118,7 +356,7 @@ auto EntityTable::dump_structures(OStream& stream) -> void {
 
       stream << "\n";
     }
-  }
+  });
 
   stream << "\n";
 }
@@ -10,15 +10,45 @@
 #include <IO/Fmt.hpp>
 #include <Core/Panic.hpp>
 #include <Core/Result.hpp>
+#include <Core/Stats.hpp>
+#include <Frontend/FlightRecorder.hpp>
 #include <unordered_map>
+#include <vector>
+#include <string_view>
 #include <print>
 #include <utility>
+#include <mutex>
 BEGIN_NAMESPACE(n19);
+class ModuleInterface;
 
 class EntityTable {
   N19_MAKE_NONCOPYABLE(EntityTable);
   N19_MAKE_NONMOVABLE(EntityTable);
 public:
+  ///
+  /// A block of IDs handed out ahead of time. While an IdScope
+  /// is alive, entities inserted into its table on that thread take
+  /// their IDs from the block, so the IDs don't depend on how threads
+  /// interleave. Other tables touched on the thread aren't affected.
+  struct IdRange {
+    Entity::ID next_ = N19_INVALID_ENTITY_ID;
+    Entity::ID end_  = N19_INVALID_ENTITY_ID;
+  };
+
+  class IdScope {
+    N19_MAKE_NONCOPYABLE(IdScope);
+    N19_MAKE_NONMOVABLE(IdScope);
+    friend class EntityTable;
+  public:
+    IdScope(const EntityTable& table, IdRange& range)
+      : table_(&table), range_(&range), prev_(active_ids_) { active_ids_ = this; }
+   ~IdScope() { active_ids_ = prev_; }
+  private:
+    const EntityTable* table_;
+    IdRange* range_;
+    IdScope* prev_;
+  };
+
   template<typename T, typename ...Args>
   auto insert(
     Entity::ID parent_id,
@@ -39,23 +69,96 @@ public:
     Args&&... args
   ) -> Entity::Ptr<T>;
 
+  ///
+  /// Copy-on-write access for forked tables: entities that still
+  /// belong to the base are copied into this table first, so the
+  /// base is never modified. Use it before changing any entity
+  /// that wasn't inserted into this table.
+  auto own(Entity::ID id) -> Entity::Ptr<>;
+
+  /// Root and builtins, built once and shared by every fork.
+  static auto builtins() -> std::shared_ptr<const EntityTable>;
+
+  template<typename F>
+  auto for_each(F&& fn) const -> void;
+
+  ///
+  /// Removes entities along with everything below them, unlinking
+  /// each from its parent's children. Their IDs are tombstoned and
+  /// handed out again by later inserts, so anything still referring
+  /// to them has to be rebuilt too. Both return how many entities
+  /// went away, and cost time in that number, not the table's size.
+  auto remove_file(const sys::String& file) -> size_t;
+  auto remove(Entity::ID id) -> size_t;
+
+  /// Every visible entity the file inserted, in no particular order.
+  auto entities_of(const sys::String& file) const -> std::vector<Entity::ID>;
+
   auto resolve_link(Entity::Ptr<SymLink> ptr) const -> Entity::Ptr<>;
   auto exists(Entity::ID id) const -> bool;
   auto find(Entity::ID id)   const -> Entity::Ptr<>;
+  auto find_direct(Entity::ID id) const -> Entity::Ptr<>;
+  auto lookup(std::string_view name) -> Entity::Ptr<>;
+  auto lookup_local(std::string_view name) const -> Entity::Ptr<>;
   auto dump(OStream& stream = outs()) -> void;
   auto dump_structures(OStream& stream = outs()) -> void;
+  auto reserve_ids(Entity::ID count) -> IdRange;
+  auto set_concurrent(bool concurrent) -> void;
 
+  /// Only the entities in this table's own layer: anything
+  /// inserted or owned here. The rest is in base_.
   std::unordered_map<Entity::ID, Entity::Ptr<>> map_;
   std::shared_ptr<RootEntity> root_ = nullptr;
+  std::vector<std::shared_ptr<ModuleInterface>> imports_;
 
   ~EntityTable() = default;
   explicit EntityTable(const sys::String& name);
+
+  ///
+  /// Forks a table off an immutable base in O(1): nothing is
+  /// copied until it's modified. A non-empty name becomes the
+  /// root's file, which means owning the root right away.
+  explicit EntityTable(std::shared_ptr<const EntityTable> base, const sys::String& name = {});
 private:
+  auto next_id_() -> Entity::ID;
+  auto guard_() const -> std::unique_lock<std::recursive_mutex>;
+  auto slot_(Entity::ID id) const -> const Entity::Ptr<>*;
+  auto track_(Entity::ID id, const sys::String& file) -> void;
+  auto remove_(std::vector<Entity::ID>&& roots) -> size_t;
+
+  std::shared_ptr<const EntityTable> base_;
+
+  /// Entities inserted per file, by interned file index. May hold
+  /// IDs that were removed since, or reused by some other file:
+  /// remove_file() checks each against the entity's file_.
+  std::unordered_map<sys::String, uint32_t> file_index_;
+  std::vector<std::vector<Entity::ID>> file_entities_;
+  std::vector<Entity::ID> free_ids_;
+  std::unordered_map<Entity::ID, size_t> settled_; /// Children each parent had before set_concurrent(true).
   Entity::ID curr_id_ = 1;
+  bool concurrent_    = false;
+  mutable std::recursive_mutex lock_;
+  static thread_local inline IdScope* active_ids_ = nullptr;   /// Innermost first.
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Entities inserted so far, indexed by EntityType.
+#define X(NAME) stats::Counter{"entities." #NAME},
+inline stats::Counter entity_stats_[] = {
+  N19_ENTITY_TYPE_LIST
+};
+#undef X
+
+/// The EntityType of T, so inserting never has to look it up.
+template<typename T>
+inline constexpr EntityType entity_type_of_ = [] {
+  #define X(NAME) if constexpr(IsSame<T, NAME>) return EntityType::NAME; else
+  N19_ENTITY_TYPE_LIST
+  #undef X
+  return EntityType::None;
+}();
+
 template<typename T, typename ...Args>
 auto EntityTable::insert(
   const Entity::Ptr<> parent,
@@ -65,10 +168,12 @@ auto EntityTable::insert(
   const std::string& lname,
   Args&&... args ) -> Entity::Ptr<T>
 {
+  static_assert(entity_type_of_<T> != EntityType::None);
   ASSERT(parent != nullptr);
   ASSERT(line != 0);
 
-  const auto id     = curr_id_;
+  const auto guard  = guard_();
+  const auto id     = next_id_();
   map_[id]          = std::make_shared<T>(std::forward(args)...);
   map_[id]->file_   = file;
   map_[id]->id_     = id;
@@ -76,18 +181,13 @@ auto EntityTable::insert(
   map_[id]->lname_  = lname;
   map_[id]->pos_    = pos;
   map_[id]->line_   = line;
+  track_(id, file);
   map_[id]->name_   = parent->id_ == N19_ROOT_ENTITY_ID
     ? fmt("::{}", lname) : parent->name_ + fmt("::{}", lname);
 
-  #define X(NAME)                       \
-  if constexpr(IsSame<T, NAME>) {       \
-    map_[id]->type_ = EntityType::NAME; \
-  }
-
-  N19_ENTITY_TYPE_LIST
-  #undef X
-
-  ++curr_id_;
+  map_[id]->type_ = entity_type_of_<T>;
+  entity_stats_[static_cast<size_t>(entity_type_of_<T>)].add();
+  flight::entity(static_cast<uint16_t>(entity_type_of_<T>), id, parent->id_);
   return Entity::cast<T>(map_[id]);
 }
 
@@ -100,11 +200,13 @@ auto EntityTable::insert(
   const std::string& lname,
   Args&&... args ) -> Entity::Ptr<T>
 {
+  static_assert(entity_type_of_<T> != EntityType::None);
   ASSERT(exists(parent_id));
   ASSERT(line != 0);
 
-  const auto id = curr_id_;
-  const auto parent = find(parent_id);
+  const auto guard  = guard_();
+  const auto id     = next_id_();
+  const auto parent = own(find(parent_id)->id_);
 
   map_[id]          = std::make_shared<T>(std::forward(args)...);
   map_[id]->file_   = file;
@@ -113,20 +215,65 @@ auto EntityTable::insert(
   map_[id]->lname_  = lname;
   map_[id]->pos_    = pos;
   map_[id]->line_   = line;
+  track_(id, file);
   map_[id]->name_   = parent->id_ == N19_ROOT_ENTITY_ID
     ? fmt("::{}", lname) : parent->name_ + fmt("::{}", lname);
 
-  #define X(NAME)                       \
-  if constexpr(IsSame<T, NAME>) {       \
-    map_[id]->type_ = EntityType::NAME; \
+  map_[id]->type_ = entity_type_of_<T>;
+  entity_stats_[static_cast<size_t>(entity_type_of_<T>)].add();
+  flight::entity(static_cast<uint16_t>(entity_type_of_<T>), id, parent->id_);
+  parent->chldrn_.emplace_back(id);
+  return Entity::cast<T>(map_[id]);
+}
+
+FORCEINLINE_ auto EntityTable::track_(const Entity::ID id, const sys::String& file) -> void {
+  const auto [it, added] = file_index_.try_emplace(file, static_cast<uint32_t>(file_entities_.size()));
+  if(added) file_entities_.emplace_back();
+  file_entities_[it->second].emplace_back(id);
+}
+
+///
+/// Calls fn(const Entity::Ptr<>&) for every entity visible
+/// from this table, own layer first, in no particular order.
+template<typename F>
+auto EntityTable::for_each(F&& fn) const -> void {
+  const auto guard = guard_();
+  for(const EntityTable* layer = this; layer != nullptr; layer = layer->base_.get()) {
+    for(const auto& entry : layer->map_) {
+      if(slot_(entry.first) == &entry.second) fn(entry.second);
+    }
   }
+}
 
-  N19_ENTITY_TYPE_LIST
-  #undef X
+FORCEINLINE_ auto EntityTable::slot_(const Entity::ID id) const -> const Entity::Ptr<>* {
+  for(const EntityTable* layer = this; layer != nullptr; layer = layer->base_.get()) {
+    const auto it = layer->map_.find(id);
+    if(it != layer->map_.end()) return it->second != nullptr ? &it->second : nullptr;
+  }
 
-  parent->chldrn_.emplace_back(id);
-  ++curr_id_;
-  return Entity::cast<T>(map_[id]);
+  return nullptr;
+}
+
+FORCEINLINE_ auto EntityTable::next_id_() -> Entity::ID {
+  for(IdScope* scope = active_ids_; scope != nullptr; scope = scope->prev_) {
+    if(scope->table_ != this) continue;
+    if(scope->range_->next_ < scope->range_->end_) return scope->range_->next_++;
+    break;
+  }
+
+  if(!free_ids_.empty()) {
+    const Entity::ID id = free_ids_.back();
+    free_ids_.pop_back();
+    return id;
+  }
+
+  return curr_id_++;
+}
+
+FORCEINLINE_ auto EntityTable::guard_() const -> std::unique_lock<std::recursive_mutex> {
+  return concurrent_
+    ? std::unique_lock{lock_}
+    : std::unique_lock<std::recursive_mutex>{};
 }
 
 END_NAMESPACE(n19);
@@ -12,9 +12,12 @@
 #include <IO/Console.hpp>
 #include <Frontend/ErrorCollector.hpp>
 #include <Frontend/Lexer.hpp>
+#include <Core/Stats.hpp>
 #include <algorithm>
 #include <cctype>
 
+static n19::stats::Counter rendered_{"diagnostics.rendered"};
+
 auto n19::ErrorCollector::store_error(
   const std::string& msg,
   const sys::String& file_name,
@@ -54,6 +57,14 @@ auto n19::ErrorCollector::store_error_or_warning(
   return *this;
 }
 
+auto n19::ErrorCollector::merge(const ErrorCollector& other) -> ErrorCollector& {
+  for(const auto& [file_name, locations] : other.errs_) {
+    for(const auto& err : locations) store_error_or_warning(file_name, err);
+  }
+
+  return *this;
+}
+
 auto n19::ErrorCollector::display_error(
   const std::string& msg,
   const Lexer &lxr,
@@ -116,13 +127,14 @@ auto n19::ErrorCollector::display_error(
 auto n19::ErrorCollector::display_error(
   const std::string& msg,
   const sys::String& fname,
-  const std::vector<char8_t>& buff,
+  const std::span<const char8_t> buff,
   OStream& stream,
   size_t pos,
   const uint32_t line,
   const bool is_warn ) -> void
 {
   ASSERT(!buff.empty());
+  rendered_.add();
   std::string before;        /// The bytes that appear before "pos"
   std::string after;         /// The byte at "pos", and the ones after it.
   std::string filler;        /// The squiggly lines and pointy arrow.
@@ -13,6 +13,7 @@
 #include <Sys/String.hpp>
 #include <string>
 #include <vector>
+#include <span>
 #include <cstdint>
 #include <unordered_map>
 
@@ -41,7 +42,7 @@ public:
   static auto display_error(
     const std::string& msg,
     const sys::String& fname,
-    const std::vector<char8_t>& buff,
+    std::span<const char8_t> buff,
     OStream& stream,
     const size_t pos,
     const uint32_t line,
@@ -82,6 +83,7 @@ public:
     const ErrorLocation& err
   ) -> ErrorCollector&;
 
+  auto merge(const ErrorCollector& other) -> ErrorCollector&;
   auto emit(OStream& stream) const -> Result<void>;
   auto has_errors()  const -> bool;
 
@@ -0,0 +1,195 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/FlightRecorder.hpp>
+#include <Frontend/Token.hpp>
+#include <Frontend/Entity.hpp>
+#include <Core/Panic.hpp>
+#include <IO/Fmt.hpp>
+#include <IO/Console.hpp>
+#include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+BEGIN_NAMESPACE(n19::flight);
+
+static constexpr std::string_view phase_names_[] = {
+#define X(UNUSED, NAME) NAME,
+  N19_FLIGHT_PHASE_LIST
+#undef X
+};
+
+static constexpr std::string_view entity_names_[] = {
+#define X(NAME) #NAME,
+  N19_ENTITY_TYPE_LIST
+#undef X
+};
+
+auto Ring_::snapshot() const -> std::vector<Event> {
+  const size_t next  = next_.load(std::memory_order_acquire);
+  const size_t first = next > ring_size_ ? next - ring_size_ : 0;
+  std::vector<Event> out;
+  out.reserve(next - first);
+  for(size_t i = first; i != next; i++) {
+    const auto& slot = events_[i & (ring_size_ - 1)];
+    const Words_ words{slot[0].load(std::memory_order_relaxed), slot[1].load(std::memory_order_relaxed)};
+    out.emplace_back(std::bit_cast<Event>(words));
+  }
+
+  return out;
+}
+
+#ifndef N19_DISABLE_FLIGHT_RECORDER
+
+struct Owner_ {
+  ~Owner_();
+  Ring_ ring_;
+  uint32_t thread_ = 0;     /// In the order threads first recorded something.
+};
+
+struct Registry_ {
+  std::mutex lock_;
+  std::vector<Owner_*> live_;
+  std::vector<sys::String> files_;
+  std::unordered_map<sys::String, uint32_t> file_index_;
+  std::vector<std::string> notes_;
+  std::unordered_map<std::string, uint32_t> note_index_;
+  uint32_t threads_ = 0;
+};
+
+static thread_local Owner_* self_ = nullptr;
+
+static auto registry_() -> Registry_& {
+  static Registry_ registry;
+  return registry;
+}
+
+Owner_::~Owner_() {
+  auto& registry = registry_();
+  std::lock_guard guard(registry.lock_);
+  std::erase(registry.live_, this);
+  flight::ring_ = nullptr;
+  self_ = nullptr;
+}
+
+auto attach_ring_() -> Ring_* {
+  static std::once_flag hooked;
+  std::call_once(hooked, [] {
+    PanicHandler::get().add_callback([](PanicHandler&) {
+      auto stream = OStream::from_stdout();
+      dump(stream);
+      stream.flush();
+    });
+  });
+
+  thread_local Owner_ owner;
+  auto& registry = registry_();
+  std::lock_guard guard(registry.lock_);
+  owner.thread_ = registry.threads_++;
+  registry.live_.push_back(&owner);
+  self_ = &owner;
+  ring_ = &owner.ring_;
+  return ring_;
+}
+
+auto intern_file_(const sys::String& name) -> uint32_t {
+  auto& registry = registry_();
+  std::lock_guard guard(registry.lock_);
+  const auto [it, added] = registry.file_index_.try_emplace(name, static_cast<uint32_t>(registry.files_.size()));
+  if(added) registry.files_.emplace_back(name);
+  return it->second;
+}
+
+auto intern_note_(const std::string_view text) -> uint32_t {
+  /// Notes come from a handful of names, so each thread
+  /// only has to take the lock the first time it sees one.
+  thread_local std::unordered_map<std::string_view, uint32_t> seen;
+  if(const auto it = seen.find(text); it != seen.end()) return it->second;
+
+  auto& registry = registry_();
+  std::lock_guard guard(registry.lock_);
+  const auto [it, added] = registry.note_index_.try_emplace(std::string(text), static_cast<uint32_t>(registry.notes_.size()));
+  if(added) registry.notes_.emplace_back(text);
+  seen.emplace(text, it->second);
+  return it->second;
+}
+
+/// registry is null when it couldn't be locked.
+static auto describe_(OStream& stream, const Event& event, const Registry_* registry) -> void {
+  switch(event.kind_) {
+  case Event::Phase:
+    stream << fmt("phase     {}", event.tag_ < std::size(phase_names_) ? phase_names_[event.tag_] : "?");
+    break;
+  case Event::File:
+    stream << "file      ";
+    if(registry != nullptr && event.a_ < registry->files_.size()) stream << registry->files_[event.a_];
+    else stream << fmt("#{}", event.a_);
+    break;
+  case Event::Token:
+    stream << fmt("token     {} at line {}, offset {}",
+      TokenType{static_cast<TokenType::Value>(event.tag_)}.to_string(),
+      event.b_,
+      event.a_);
+    break;
+  case Event::Entity:
+    stream << fmt("entity    {} #{} under #{}",
+      event.tag_ < std::size(entity_names_) ? entity_names_[event.tag_] : "?",
+      event.a_,
+      event.b_);
+    break;
+  case Event::Note:
+    stream << "note      ";
+    if(registry != nullptr && event.a_ < registry->notes_.size()) stream << registry->notes_[event.a_];
+    else stream << fmt("#{}", event.a_);
+    break;
+  default:
+    stream << "?";
+    break;
+  }
+}
+
+auto dump(OStream& stream, const size_t last) -> void {
+  ///
+  /// Don't wait on the lock: whoever panicked may be holding it.
+  /// Without it, only this thread's events can be printed.
+  auto& registry = registry_();
+  std::unique_lock guard(registry.lock_, std::try_to_lock);
+  std::vector<const Owner_*> owners;
+  if(guard.owns_lock()) owners.assign(registry.live_.begin(), registry.live_.end());
+  else if(self_ != nullptr) owners.push_back(self_);
+
+  std::ranges::stable_partition(owners, [](const Owner_* owner) { return owner == self_; });
+  const auto* names = guard.owns_lock() ? &registry : nullptr;
+
+  for(const Owner_* owner : owners) {
+    const auto events = owner->ring_.snapshot();
+    if(events.empty()) continue;
+
+    const size_t begin = events.size() > last ? events.size() - last : 0;
+    stream
+      << Con::Bold
+      << fmt("---- Flight Recorder: thread {}{}, last {} of {} events\n",
+        owner->thread_,
+        owner == self_ ? " (this thread)" : "",
+        events.size() - begin,
+        events.size())
+      << Con::Reset;
+
+    for(size_t i = begin; i < events.size(); i++) {
+      stream << "  ";
+      describe_(stream, events[i], names);
+      stream << "\n";
+    }
+  }
+}
+
+#else
+
+auto dump(OStream&, size_t) -> void {}
+
+#endif
+
+END_NAMESPACE(n19::flight);
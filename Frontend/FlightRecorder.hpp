@@ -0,0 +1,155 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_FLIGHTRECORDER_HPP
+#define N19_FLIGHTRECORDER_HPP
+#include <Core/Platform.hpp>
+#include <Core/ClassTraits.hpp>
+#include <IO/Stream.hpp>
+#include <Sys/String.hpp>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+#define N19_FLIGHT_PHASE_LIST              \
+  X(Parse,     "parse")                    \
+  X(Optimize,  "optimize")                 \
+  X(Dump,      "dump")                     \
+  X(Interface, "interface")                \
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The last few hundred things each thread did, kept so a PANIC or
+// ASSERT can say more than where it happened: which phase and file
+// it was in, the tokens it had just consumed, the entities it had
+// just inserted. Events are 16 bytes, written into a per-thread
+// ring that overwrites the oldest, so recording never blocks and
+// never allocates after a thread's first event.
+//
+// A token or entity costs a thread local load, two relaxed 8 byte
+// stores and a release store of the index. Other threads can read
+// the ring without a data race, and none of it is a read-modify-write:
+// on x86 it's all plain moves. Files and notes are interned
+// first: once per file under a lock, and through a per-thread table
+// for notes. The first event recorded registers a PanicHandler
+// callback that prints them, newest last.
+//
+// Defining N19_DISABLE_FLIGHT_RECORDER (the N19_FLIGHT_RECORDER
+// CMake option) compiles every record call away.
+
+BEGIN_NAMESPACE(n19::flight);
+
+struct Event {
+  enum Kind : uint8_t {
+    None,
+    Phase,                  /// tag_: the phase.
+    File,                   /// a_: interned file index.
+    Token,                  /// tag_: TokenType, a_: offset, b_: line.
+    Entity,                 /// tag_: EntityType, a_: its ID, b_: its parent.
+    Note,                   /// a_: interned note index.
+  };
+
+  Kind kind_    = None;
+  uint8_t pad_  = 0;
+  uint16_t tag_ = 0;
+  uint32_t a_   = 0;
+  uint64_t b_   = 0;
+};
+
+static_assert(sizeof(Event) == 16);
+
+enum Phase : uint16_t {
+#define X(NAME, UNUSED) NAME,
+  N19_FLIGHT_PHASE_LIST
+#undef X
+};
+
+/// Per thread. Has to be a power of two.
+inline constexpr size_t ring_size_   = 256;
+inline constexpr size_t dump_events_ = 64;
+static_assert((ring_size_ & (ring_size_ - 1)) == 0);
+
+///
+/// The last ring_size_ events of one thread. Only ever written
+/// to by the thread owning it, so the index is loaded and stored,
+/// never incremented atomically. Other threads read it while
+/// dumping: an event overwritten as they copy it can come out
+/// torn, but never as a data race.
+class Ring_ {
+public:
+  auto push(const Event& event) -> void;
+  auto snapshot() const -> std::vector<Event>;
+private:
+  using Words_ = std::array<uint64_t, 2>;
+  std::array<std::array<std::atomic<uint64_t>, 2>, ring_size_> events_{};
+  std::atomic<size_t> next_ = 0;
+};
+
+FORCEINLINE_ auto Ring_::push(const Event& event) -> void {
+  const size_t next  = next_.load(std::memory_order_relaxed);
+  const Words_ words = std::bit_cast<Words_>(event);
+  auto& slot = events_[next & (ring_size_ - 1)];
+  slot[0].store(words[0], std::memory_order_relaxed);
+  slot[1].store(words[1], std::memory_order_relaxed);
+  next_.store(next + 1, std::memory_order_release);
+}
+
+#ifndef N19_DISABLE_FLIGHT_RECORDER
+
+inline thread_local Ring_* ring_ = nullptr;
+auto attach_ring_() -> Ring_*;
+auto intern_file_(const sys::String& name) -> uint32_t;
+auto intern_note_(std::string_view text) -> uint32_t;
+
+FORCEINLINE_ auto record(const Event& event) -> void {
+  Ring_* ring = ring_ ? ring_ : attach_ring_();
+  ring->push(event);
+}
+
+FORCEINLINE_ auto phase(const Phase which) -> void {
+  record(Event{Event::Phase, 0, which, 0, 0});
+}
+
+FORCEINLINE_ auto token(const uint16_t type, const uint32_t pos, const uint32_t line) -> void {
+  record(Event{Event::Token, 0, type, pos, line});
+}
+
+FORCEINLINE_ auto entity(const uint16_t type, const uint32_t id, const uint32_t parent) -> void {
+  record(Event{Event::Entity, 0, type, id, parent});
+}
+
+/// The text has to outlive the process: a literal,
+/// or something like Pass::name(). Only its index is
+/// recorded, so dumping never reads through a pointer.
+inline auto note(const std::string_view text) -> void {
+  record(Event{Event::Note, 0, 0, intern_note_(text), 0});
+}
+
+/// Interns the name, under a lock: once per file, not per event.
+inline auto file(const sys::String& name) -> void {
+  record(Event{Event::File, 0, 0, intern_file_(name), 0});
+}
+
+#else
+
+FORCEINLINE_ auto record(const Event&) -> void {}
+FORCEINLINE_ auto phase(Phase) -> void {}
+FORCEINLINE_ auto token(uint16_t, uint32_t, uint32_t) -> void {}
+FORCEINLINE_ auto entity(uint16_t, uint32_t, uint32_t) -> void {}
+FORCEINLINE_ auto note(std::string_view) -> void {}
+FORCEINLINE_ auto file(const sys::String&) -> void {}
+
+#endif
+
+///
+/// Prints the last events of every thread that recorded any,
+/// the calling thread's first. Safe to call while panicking:
+/// other threads may still be writing, so theirs are best effort.
+auto dump(OStream& stream, size_t last = dump_events_) -> void;
+
+END_NAMESPACE(n19::flight);
+#endif //N19_FLIGHTRECORDER_HPP
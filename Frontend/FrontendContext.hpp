@@ -35,6 +35,11 @@ public:
     DumpIR   = 0x01 << 2, /// Dump internal IR repr
     DumpAST  = 0x01 << 3, /// Dump the AST
     DumpEnts = 0x01 << 4, /// Dump the entity table
+    EmitIntf = 0x01 << 5, /// Write a precompiled module interface
+    OptRmrks = 0x01 << 6, /// Report optimization decisions
+    TimePass = 0x01 << 7, /// Report how long each pass took
+    DeclOnly = 0x01 << 8, /// Skip procedure bodies, declarations only
+    NoPin    = 0x01 << 9, /// Never pin worker threads to CPUs
   };
 
   static auto get_version_info() -> VersionInfo;
@@ -49,6 +54,8 @@ public:
   }
 
   std::underlying_type_t<Flags> flags_{};
+  int64_t opt_level_ = 0;
+  sys::String schedule_stats_;   /// Empty: don't keep compile times.
   argp::PackType inputs_{};
   argp::PackType outputs_{};
 
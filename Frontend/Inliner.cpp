@@ -0,0 +1,253 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/Inliner.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <IO/Console.hpp>
+#include <IO/Fmt.hpp>
+#include <unordered_set>
+#include <unordered_map>
+#include <string>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+namespace {
+  struct Candidate_ {
+    AstNode* expr_ = nullptr;              /// The returned expression.
+    std::vector<std::string> params_;      /// Parameter keys, in order.
+  };
+}
+
+static auto as_candidate_(AstProcDecl& proc) -> Maybe<Candidate_> {
+  if(proc.body_.size() != 1 || !proc.body_[0]) return Nothing;
+  if(proc.body_[0]->type_ != AstNode::Type::Return) return Nothing;
+
+  auto& ret = static_cast<AstReturn&>(*proc.body_[0]);
+  if(!ret.value_) return Nothing;
+
+  Candidate_ out;
+  out.expr_ = ret.value_.get();
+  for(auto& decl : proc.arg_decls_) {
+    if(!decl || decl->type_ != AstNode::Type::Vardecl) return Nothing;
+    auto& var = static_cast<AstVardecl&>(*decl);
+    auto key  = var.name_ ? callee_key(*var.name_) : Maybe<std::string>{Nothing};
+    if(!key.has_value()) return Nothing;
+    out.params_.emplace_back(std::move(*key));
+  }
+
+  return out;
+}
+
+///
+/// Arguments that can be duplicated or dropped
+/// without changing the meaning of the program.
+static auto is_trivial_arg_(const AstNode& node) -> bool {
+  switch(node.type_) {
+  case AstNode::Type::EntityRef:      FALLTHROUGH_;
+  case AstNode::Type::EntityRefThunk: FALLTHROUGH_;
+  case AstNode::Type::ScalarLiteral:  return true;
+  default:                            return false;
+  }
+}
+
+static auto collect_refs_(AstNode& node, std::unordered_map<std::string, size_t>& out) -> void {
+  if(auto key = callee_key(node); key.has_value()) {
+    ++out[*key];
+  }
+
+  ast_for_each_child(node, [&](AstNode* child, AstNode::Ptr<>*) {
+    collect_refs_(*child, out);
+  });
+}
+
+static auto collect_locals_(AstNode& node, std::unordered_set<std::string>& out) -> void {
+  if(node.type_ == AstNode::Type::Vardecl) {
+    auto& var = static_cast<AstVardecl&>(node);
+    if(auto key = var.name_ ? callee_key(*var.name_) : Maybe<std::string>{Nothing}; key.has_value()) {
+      out.emplace(std::move(*key));
+    }
+  }
+
+  ast_for_each_child(node, [&](AstNode* child, AstNode::Ptr<>*) {
+    collect_locals_(*child, out);
+  });
+}
+
+static auto substitute_(
+  AstNode::Ptr<>& slot,
+  const std::unordered_map<std::string, AstNode*>& args ) -> void
+{
+  if(auto key = callee_key(*slot); key.has_value()) {
+    if(const auto it = args.find(*key); it != args.end()) {
+      AstNode* parent = slot->parent_;
+      slot = ast_clone(*it->second, parent);
+      return;
+    }
+  }
+
+  ast_for_each_child(*slot, [&](AstNode*, AstNode::Ptr<>* child_slot) {
+    if(child_slot) substitute_(*child_slot, args);
+  });
+}
+
+namespace {
+  class Inliner_ {
+  public:
+    auto run() -> void {
+      for(const auto& node : graph_.nodes_) stats_.size_before_ += node.size_;
+      budget_ = static_cast<size_t>(stats_.size_before_ * params_.growth_budget_);
+      total_  = stats_.size_before_;
+
+      for(const auto& scc : graph_.sccs_) {
+        for(const uint32_t caller : scc) process_caller_(caller);
+      }
+
+      stats_.size_after_ = total_;
+    }
+
+    Inliner_(AstNode::Children<>& decls, OStream* remarks, const InlineParams& params)
+    : graph_(CallGraph::build(decls)), remarks_(remarks), params_(params) {}
+
+    CallGraph graph_;
+    OStream* remarks_;
+    InlineParams params_;
+    InlineStats stats_;
+    size_t budget_ = 0;
+    size_t total_  = 0;
+  private:
+    auto process_caller_(const uint32_t caller) -> void {
+      auto& node = graph_.nodes_[caller];
+      std::unordered_set<std::string> locals;
+      collect_locals_(*node.proc_, locals);
+
+      bool changed = false;
+      for(const auto& site : node.sites_) {
+        changed |= try_inline_(caller, site, locals);
+      }
+
+      if(changed) {
+        graph_.rescan(caller);   /// Callers further up the graph need
+      }                          /// the new size of this procedure.
+    }
+
+    auto try_inline_(
+      const uint32_t caller,
+      const CallGraph::Site& site,
+      const std::unordered_set<std::string>& locals ) -> bool
+    {
+      const auto& callee = graph_.nodes_[site.callee_];
+      if(callee.scc_ == graph_.nodes_[caller].scc_) {
+        return missed_(caller, site, "callee is recursive with the caller");
+      }
+
+      auto candidate = as_candidate_(*callee.proc_);
+      if(!candidate.has_value()) {
+        return missed_(caller, site, "callee body is not a single return expression");
+      } if(candidate->params_.size() != site.call_->arguments_.size()) {
+        return missed_(caller, site, "argument count does not match the declaration");
+      }
+
+      ///
+      /// Cost model: small callees are always worth it, otherwise
+      /// weigh the callee size against a limit that grows for hot call
+      /// sites, and keep the whole module within its growth budget.
+      const size_t expr_size = ast_size(*candidate->expr_);
+      const size_t call_size = ast_size(*site.call_);
+      const bool is_hot      = site.freq_ >= params_.hot_freq_;
+      const auto threshold   = static_cast<size_t>(
+        params_.threshold_ * (is_hot ? params_.hot_multiplier_ : 1.0));
+
+      if(expr_size > params_.always_size_ && callee.size_ > threshold) {
+        return missed_(caller, site, fmt("callee too large ({} > {})", callee.size_, threshold));
+      } if(expr_size > call_size && total_ + (expr_size - call_size) > budget_) {
+        return missed_(caller, site, "module growth budget exhausted");
+      }
+
+      std::unordered_map<std::string, size_t> uses;
+      collect_refs_(*candidate->expr_, uses);
+
+      std::unordered_map<std::string, AstNode*> args;
+      for(size_t i = 0; i < candidate->params_.size(); i++) {
+        const auto& param = candidate->params_[i];
+        AstNode* arg      = site.call_->arguments_[i].get();
+        const auto count  = uses.contains(param) ? uses.at(param) : 0;
+
+        if(!arg) {
+          return missed_(caller, site, "missing argument");
+        } if(count != 1 && !is_trivial_arg_(*arg)) {
+          return missed_(caller, site, fmt("argument '{}' would be evaluated {} times", param, count));
+        }
+
+        args[param] = arg;
+        uses.erase(param);
+      }
+
+      ///
+      /// Whatever is left refers to something outside of the callee.
+      /// If the caller declares a local with the same name, the inlined
+      /// expression would silently bind to it instead.
+      for(const auto& [name, _] : uses) {
+        if(locals.contains(name)) {
+          return missed_(caller, site, fmt("'{}' would be captured by a local in the caller", name));
+        }
+      }
+
+      AstNode* parent   = site.call_->parent_;
+      auto replacement  = ast_clone(*candidate->expr_, parent);
+      substitute_(replacement, args);
+
+      const size_t new_size = ast_size(*replacement);
+      total_ = total_ + new_size - call_size;
+      remark_(caller, site, true, fmt("size={} freq={:.2f} threshold={}", callee.size_, site.freq_, threshold));
+
+      *site.slot_ = std::move(replacement);
+      ++stats_.inlined_;
+      return true;
+    }
+
+    auto missed_(const uint32_t caller, const CallGraph::Site& site, const std::string& why) -> bool {
+      ++stats_.missed_;
+      remark_(caller, site, false, why);
+      return false;
+    }
+
+    auto remark_(
+      const uint32_t caller,
+      const CallGraph::Site& site,
+      const bool inlined,
+      const std::string& detail ) -> void
+    {
+      if(remarks_ == nullptr) return;
+      auto& stream = *remarks_;
+      stream << site.call_->file_ << ":" << site.call_->line_ << ": ";
+
+      if(inlined) {
+        stream << Con::GreenFG << "remark:" << Con::Reset << " inlined '";
+      } else {
+        stream << Con::YellowFG << "missed:" << Con::Reset << " did not inline '";
+      }
+
+      stream
+        << graph_.nodes_[site.callee_].name_
+        << "' into '"
+        << graph_.nodes_[caller].name_
+        << "': "
+        << detail
+        << "\n";
+    }
+  };
+}
+
+auto inline_procedures(
+  AstNode::Children<>& decls,
+  OStream* remarks,
+  const InlineParams& params ) -> InlineStats
+{
+  Inliner_ inliner(decls, remarks, params);
+  inliner.run();
+  return inliner.stats_;
+}
+
+END_NAMESPACE(n19);
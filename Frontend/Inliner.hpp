@@ -0,0 +1,48 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_INLINER_HPP
+#define N19_INLINER_HPP
+#include <Frontend/AstNodes.hpp>
+#include <Frontend/CallGraph.hpp>
+#include <IO/Stream.hpp>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///
+/// Tuning knobs for the inliner's cost model. The size of a
+/// callee is measured in AST nodes, see ast_size().
+struct InlineParams {
+  size_t always_size_    = 8;     /// Callees this small are always inlined.
+  size_t threshold_      = 40;    /// Size limit for an ordinary call site.
+  double hot_freq_       = 4.0;   /// Call sites estimated to run at least this often...
+  double hot_multiplier_ = 3.0;   /// ...get their size limit multiplied by this.
+  double growth_budget_  = 1.5;   /// Module size limit, relative to its original size.
+};
+
+struct InlineStats {
+  size_t inlined_     = 0;
+  size_t missed_      = 0;
+  size_t size_before_ = 0;
+  size_t size_after_  = 0;
+};
+
+///
+/// Inlines calls to small procedures, visiting the call graph
+/// bottom-up so callees are already optimized when they're inlined.
+/// Calls within an SCC (recursion) are never inlined. When "remarks" is
+/// given, every decision is written to it, along with the reason.
+///
+/// Inlining happens at the AST level, so only procedures whose body
+/// is a single "return <expr>" are candidates: the call expression is
+/// replaced by a copy of <expr> with parameters substituted.
+auto inline_procedures(
+  AstNode::Children<>& decls,
+  OStream* remarks = nullptr,
+  const InlineParams& params = {}
+) -> InlineStats;
+
+END_NAMESPACE(n19);
+#endif //N19_INLINER_HPP
@@ -8,6 +8,7 @@
 #include <Frontend/Lexer.hpp>
 #include <Frontend/ErrorCollector.hpp>
 #include <Frontend/Keywords.hpp>
+#include <Frontend/FlightRecorder.hpp>
 #include <filesystem>
 #include <algorithm>
 #include <limits>
@@ -47,6 +48,7 @@ inline auto Lexer::token_hyphen_() -> Token {
     curr_tok.cat_ |= TokenCategory::BinaryOp;
     curr_tok.len_  = 2;
     consume_char_(2);
+    break;
   default: // '-'
     curr_tok.type_ = TokenType::Sub;
     curr_tok.cat_  = TokenCategory::BinaryOp;
@@ -451,7 +453,7 @@ FORCEINLINE_ auto Lexer::token_null_()  -> Token {
   curr_tok.type_ = TokenType::EndOfFile;
   curr_tok.cat_  = TokenCategory::NonCategorical;
   curr_tok.len_  = 0;
-  curr_tok.pos_  = src_.size() - 1;
+  curr_tok.pos_  = size_() - 1;
   return curr_tok;
 }
 
@@ -577,8 +579,9 @@ FORCEINLINE_ auto Lexer::token_comma_() -> Token {
 }
 
 auto Lexer::produce_impl_() -> Token {
-  if(index_ >= src_.size()) {
-    return Token::eof(src_.size() - 1, line_);
+  tokens_stat_.add();
+  if(index_ >= size_()) {
+    return Token::eof(size_() - 1, line_);
   }
 
   SWITCH_BEGIN:
@@ -811,7 +814,7 @@ inline auto Lexer::token_oct_lit_() -> Token {
 }
 
 inline auto Lexer::token_ambiguous_() -> Token {
-  ASSERT(index_ < src_.size());
+  ASSERT(index_ < size_());
   ASSERT(!is_reserved_byte(current_char_()));
 
   const char8_t next = peek_char_();
@@ -894,13 +897,13 @@ inline auto Lexer::skip_utf8_sequence_() -> bool {
   else if ((ch & 0xF8) == 0xF0) consume_char_(4); /// 4 byte codepoint.
   else return false;                              /// Something's wrong?
 
-  return index_ - 1 < src_.size();
+  return index_ - 1 < size_();
 }
 
 auto Lexer::create_shared(std::vector<char8_t>&& buf) -> Result<std::shared_ptr<Lexer>> {
   ASSERT(!buf.empty());
   auto lxr   = std::make_shared<Lexer>();
-  lxr->src_  = std::move(buf);
+  lxr->set_source(std::make_shared<const std::vector<char8_t>>(std::move(buf)));
   lxr->curr_ = lxr->produce_impl_();
   lxr->file_name_ = _nstr("<buffer>");
   return lxr;
@@ -930,13 +933,21 @@ auto Lexer::create_shared(sys::File& ref) -> Result<std::shared_ptr<Lexer>> {
   lxr->file_name_ = std::filesystem::absolute(ref.name_).string();
 #endif
 
-  lxr->src_.resize(fsize);
-  auto wbytes = as_writable_bytes(lxr->src_);
+  std::vector<char8_t> buf(fsize);
+  auto wbytes = as_writable_bytes(buf);
   TRY(ref.read_into(wbytes));
+  lxr->set_source(std::make_shared<const std::vector<char8_t>>(std::move(buf)));
   lxr->curr_ = lxr->produce_impl_();
   return lxr;
 }
 
+auto Lexer::set_source(std::shared_ptr<const std::vector<char8_t>> buf) -> void {
+  ASSERT(buf != nullptr);
+  stop_pipeline();
+  buf_ = std::move(buf);
+  src_ = *buf_;
+}
+
 auto Lexer::expect(const TokenCategory cat, const bool cons) -> Result<void> {
   if(!current().cat_.isa(cat)) {
     const auto errc = ErrC::BadToken;
@@ -959,18 +970,118 @@ auto Lexer::expect_type(const TokenType type, const bool cons) -> Result<void> {
   return Result<void>::create();
 }
 
+auto Lexer::skip_block() -> Result<void> {
+  ASSERT(curr_ == TokenType::LeftBrace);
+
+  ///
+  /// The lexer thread has been through the block already,
+  /// so count the braces in its tokens. Should it have stopped
+  /// on an illegal token, the raw bytes are walked instead.
+  if(pipe_) {
+    uint32_t depth = 1;
+    for(const Token* tok = pipe_->next(); tok != nullptr; tok = pipe_->next()) {
+      if(*tok == TokenType::EndOfFile) return Error(ErrC::BadToken, "Unterminated block.");
+      if(*tok == TokenType::Illegal)   break;
+      if(*tok == TokenType::LeftBrace) ++depth;
+      if(*tok == TokenType::RightBrace && --depth == 0) {
+        curr_ = next_piped_();
+        return Result<void>::create();
+      }
+    }
+
+    stop_pipeline();
+  }
+
+  this->index_ = curr_.pos_;
+  this->line_  = curr_.line_;
+
+  ///
+  /// Walks the raw bytes instead of producing tokens. Only
+  /// braces, newlines, comments and quotes matter here, so this
+  /// is a good deal cheaper than lexing the block properly.
+  uint32_t depth = 0;
+  while(index_ < size_()) {
+    switch(const char8_t ch = current_char_()) {
+    case u8'{':  ++depth; break;
+    case u8'\n': ++line_; break;
+    case u8'#':  skip_comment_(); continue;
+    case u8'}':
+      consume_char_(1);
+      if(--depth == 0) {
+        curr_ = produce_impl_();
+        return Result<void>::create();
+      }
+      continue;
+    case u8'"':  FALLTHROUGH_;
+    case u8'`':  FALLTHROUGH_;
+    case u8'\'':
+      consume_char_(1);
+      while(current_char_() != ch) {
+        if(current_char_() == u8'\0' || current_char_() == u8'\n') {
+          return Error(ErrC::BadToken, "Unterminated string inside of block.");
+        }
+        consume_char_(current_char_() == u8'\\' && peek_char_() == ch ? 2 : 1);
+      }
+      break;
+    default: break;
+    }
+
+    consume_char_(1);
+  }
+
+  return Error(ErrC::BadToken, "Unterminated block.");
+}
+
 auto Lexer::consume(const uint32_t amnt) -> const Token& {
   if(curr_ == TokenType::EndOfFile)
     return curr_;
 
   for(uint32_t i = 0; i < amnt; i++) {
-    curr_ = produce_impl_();
+    curr_ = pipe_ ? next_piped_() : produce_impl_();
+    flight::token(curr_.type_.value, curr_.pos_, curr_.line_);
     if(curr_ == TokenType::EndOfFile) break;
   }
   
   return curr_;
 }
 
+auto Lexer::advance_(const uint32_t amnt) -> const Token& {
+  if(curr_ == TokenType::EndOfFile)
+    return curr_;
+
+  for(uint32_t i = 0; i < amnt; i++) {
+    curr_ = pipe_ ? next_piped_() : produce_impl_();
+    if(curr_ == TokenType::EndOfFile) break;
+  }
+
+  return curr_;
+}
+
+auto Lexer::next_piped_() -> Token {
+  if(const Token* tok = pipe_->next()) return *tok;
+  stop_pipeline();
+  return produce_impl_();
+}
+
+auto Lexer::start_pipeline() -> void {
+  if(pipe_ || curr_ == TokenType::EndOfFile) return;
+  pipe_ = std::make_unique<TokenPipeline>(*this);
+}
+
+auto Lexer::stop_pipeline() -> void {
+  if(!pipe_) return;
+
+  /// Put the lexer right in front of the token the parser
+  /// hasn't had yet. Past the last one the lexer thread produced,
+  /// the thread already left index_ and line_ where they belong.
+  if(const Token* next = pipe_->stop()) {
+    this->index_ = next->pos_;
+    this->line_  = next->line_;
+  }
+
+  pipe_.reset();
+}
+
 auto Lexer::dump(OStream& stream) -> void {
   do {
     stream << curr_.format(*this);
@@ -982,7 +1093,7 @@ auto Lexer::dump(OStream& stream) -> void {
 }
 
 auto Lexer::reset(sys::File& ref) -> Result<void> {
-  src_.clear();
+  stop_pipeline();
   ref.seek(0, sys::FSeek::Beg);
 
   const auto fsize = TRY(ref.size());
@@ -992,8 +1103,8 @@ auto Lexer::reset(sys::File& ref) -> Result<void> {
     return Error(ErrC::InvalidArg, "File is empty");
   }
 
-  this->src_.resize(fsize);
-  auto wbytes = n19::as_writable_bytes(src_);
+  std::vector<char8_t> buf(fsize);
+  auto wbytes = n19::as_writable_bytes(buf);
 
 #ifdef N19_WIN32
   this->file_name_ = std::filesystem::absolute(ref.name_).wstring();
@@ -1004,8 +1115,10 @@ auto Lexer::reset(sys::File& ref) -> Result<void> {
   this->curr_  = Token(); /// Reset data members
   this->index_ = 0;       ///
   this->line_  = 1;
+  this->limit_ = UINT32_MAX;
 
   TRY(ref.read_into(wbytes));
+  set_source(std::make_shared<const std::vector<char8_t>>(std::move(buf)));
   this->curr_ = produce_impl_();
   return Result<void>::create();
 }
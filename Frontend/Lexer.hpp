@@ -13,13 +13,17 @@
 #include <Core/Maybe.hpp>
 #include <IO/Stream.hpp>
 #include <Frontend/Token.hpp>
+#include <Frontend/TokenPipeline.hpp>
+#include <Core/Stats.hpp>
 #include <Sys/String.hpp>
 #include <memory>
 #include <vector>
+#include <span>
 #include <array>
 #include <functional>
 #include <string_view>
 #include <cctype>
+#include <algorithm>
 #include <cstdint>
 
 #define UTF8_LEADING(CH) (static_cast<uint8_t>(CH) >= 0x80)
@@ -32,12 +36,24 @@ BEGIN_NAMESPACE(n19);
 class Lexer final : public std::enable_shared_from_this<Lexer> {
   N19_MAKE_NONCOPYABLE(Lexer);
   N19_MAKE_COMPARABLE_MEMBER(Lexer, file_name_);
+  friend class TokenPipeline;
 public:
   auto current() const        -> const Token&;
   auto consume(uint32_t amnt) -> const Token&;
   auto get_bytes() const      -> Bytes;
   auto dump(OStream& stream)  -> void;
   auto revert_before(const Token&) -> void;
+  auto seek(uint32_t pos, uint32_t line) -> const Token&;
+  auto skip_block() -> Result<void>;
+
+  /// Lex buf, which other lexers may be reading too. Nothing is
+  /// copied and nothing is lexed yet: seek() somewhere first.
+  auto set_source(std::shared_ptr<const std::vector<char8_t>> buf) -> void;
+
+  /// Moves lexing onto a thread of its own, see TokenPipeline.
+  /// Stopping is always safe, and leaves the lexer where it was.
+  auto start_pipeline() -> void;
+  auto stop_pipeline()  -> void;
 
   template<size_t sz_>
   auto batched_peek()         -> std::array<Token, sz_>;
@@ -55,6 +71,7 @@ public:
   Lexer() = default;
   ~Lexer() = default;
 private:
+  size_t size_() const;
   char8_t current_char_() const;
   void consume_char_(uint32_t);
   void advance_line_();
@@ -63,6 +80,8 @@ private:
   bool skip_chars_until_(std::function<bool(char8_t)> cb);
   bool skip_utf8_sequence_();
   char8_t peek_char_(uint32_t amnt = 1) const;
+  auto next_piped_() -> Token;
+  auto advance_(uint32_t amnt) -> const Token&;  /// consume(), for lookahead: not recorded.
 
   auto produce_impl_()    -> Token;
   auto token_hyphen_()    -> Token;
@@ -97,12 +116,20 @@ private:
   auto token_hex_lit_()   -> Token;
   auto token_num_lit_()   -> Token;
   auto token_oct_lit_()   -> Token;
+
+  static inline stats::Counter tokens_stat_{"lexer.tokens"};
+  static inline stats::Counter peeks_stat_{"lexer.peeks"};
+  static inline stats::Counter reverts_stat_{"lexer.reverts"};
+  static inline stats::Counter seeks_stat_{"lexer.seeks"};
 public:
-  std::vector<char8_t> src_;
+  std::shared_ptr<const std::vector<char8_t>> buf_; /// Owns the source, never written to.
+  std::span<const char8_t> src_;                    /// All of *buf_.
   Token curr_;
   sys::String file_name_;
   uint32_t index_  = 0;
   uint32_t line_   = 1;
+  uint32_t limit_  = UINT32_MAX; /// Lex as if the file ended here.
+  std::unique_ptr<TokenPipeline> pipe_; /// Last, so it's stopped first.
 };
 
 struct Keyword {
@@ -111,11 +138,17 @@ struct Keyword {
 };
 
 FORCEINLINE_ auto Lexer::peek(const uint32_t amnt) -> Token {
+  peeks_stat_.add();
+  if(pipe_ && amnt != 0 && curr_ != TokenType::EndOfFile) {
+    if(const Token* tok = pipe_->peek(amnt)) return *tok;
+    stop_pipeline();
+  }
+
   const uint32_t line_tmp  = this->line_;
   const size_t   index_tmp = this->index_;
   const Token    tok_tmp   = this->curr_;
 
-  consume(amnt);
+  advance_(amnt);
   const Token peeked = curr_;
 
   this->line_  = line_tmp;   /// Restore line
@@ -126,13 +159,27 @@ FORCEINLINE_ auto Lexer::peek(const uint32_t amnt) -> Token {
 
 template<size_t sz_>
 FORCEINLINE_ auto Lexer::batched_peek() -> std::array<Token, sz_> {
+  peeks_stat_.add();
+  if(pipe_) {
+    std::array<Token, sz_> toks{};
+    size_t count = 0;
+    for(; count < toks.size(); count++) {
+      const Token* tok = curr_ == TokenType::EndOfFile ? &curr_ : pipe_->peek(count + 1);
+      if(tok == nullptr) break;
+      toks[count] = *tok;
+    }
+
+    if(count == toks.size()) return toks;
+    stop_pipeline();
+  }
+
   const uint32_t line_tmp  = this->line_;
   const size_t   index_tmp = this->index_;
   const Token    tok_tmp   = this->curr_;
 
   std::array<Token, sz_> toks{};
   for(size_t i = 0; i < toks.size(); i++) {
-    toks[i] = consume(1);
+    toks[i] = advance_(1);
   }
 
   this->line_  = line_tmp;   /// Restore line
@@ -142,11 +189,35 @@ FORCEINLINE_ auto Lexer::batched_peek() -> std::array<Token, sz_> {
 }
 
 inline auto Lexer::revert_before(const Token& tok) -> void {
+  reverts_stat_.add();
+  if(pipe_ && !pipe_->rewind(tok)) stop_pipeline();
   this->curr_  = tok;
+  if(pipe_) return;
+
   this->line_  = tok.line_;
   this->index_ = tok.pos_;
 }
 
+///
+/// Restarts lexing at pos, which must be the start of a token
+/// (or of the whitespace in front of one) on the given line.
+inline auto Lexer::seek(const uint32_t pos, const uint32_t line) -> const Token& {
+  seeks_stat_.add();
+  if(pipe_) {
+    if(const Token* tok = pipe_->seek(pos, line)) return curr_ = *tok;
+    stop_pipeline();
+  }
+
+  this->index_ = pos;
+  this->line_  = line;
+  this->curr_  = produce_impl_();
+  return curr_;
+}
+
+inline auto Lexer::size_() const -> size_t {
+  return std::min<size_t>(src_.size(), limit_);
+}
+
 inline auto Lexer::skip_comment_() -> void {
   skip_chars_until_([](const char8_t ch) {
     return ch == '\n' || ch == '\0';
@@ -154,25 +225,25 @@ inline auto Lexer::skip_comment_() -> void {
 }
 
 inline auto Lexer::current_char_() const -> char8_t {
-  return index_ >= src_.size()
+  return index_ >= size_()
     ? u8'\0' : src_[index_];
 }
 
 inline auto Lexer::peek_char_(const uint32_t amnt) const -> char8_t {
-  return (index_ + amnt) >= src_.size()
+  return (index_ + amnt) >= size_()
     ? u8'\0' : src_[index_ + amnt];
 }
 
 inline auto Lexer::consume_char_(const uint32_t amnt) -> void {
-  if(index_ < src_.size()) index_ += amnt;
+  if(index_ < size_()) index_ += amnt;
 }
 
 inline auto Lexer::advance_line_() -> void {
-  if(index_ < src_.size()) ++line_;
+  if(index_ < size_()) ++line_;
 }
 
 inline auto Lexer::advance_consume_line_() -> void {
-  if(index_ < src_.size()) ++line_;
+  if(index_ < size_()) ++line_;
   consume_char_(1);
 }
 
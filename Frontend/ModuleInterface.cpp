@@ -0,0 +1,452 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/ModuleInterface.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Core/Murmur3.hpp>
+#include <Core/Try.hpp>
+#include <Sys/File.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+#include <bit>
+BEGIN_NAMESPACE(n19);
+
+static constexpr char iface_magic_[8]  = {'N','1','9','M','O','D','I','\0'};
+static constexpr uint32_t iface_seed_  = 0x6e313969;
+static constexpr uint32_t first_rec_   = BuiltinType::AfterLastID;
+
+static auto hash_name_(const std::string_view name) -> uint32_t {
+  return murmur3_x86_32(
+    std::u8string_view{reinterpret_cast<const char8_t*>(name.data()), name.size()},
+    iface_seed_);
+}
+
+///
+/// Only entities that another file could name are exported.
+/// Locals live in procedure bodies, and placeholders only
+/// exist until the table has been fully checked.
+static auto is_exported_(const Entity& ent) -> bool {
+  switch(ent.type_) {
+  case EntityType::Static:    FALLTHROUGH_;
+  case EntityType::Proc:      FALLTHROUGH_;
+  case EntityType::Struct:    FALLTHROUGH_;
+  case EntityType::Type:      FALLTHROUGH_;
+  case EntityType::SymLink:   FALLTHROUGH_;
+  case EntityType::AliasType: return true;
+  default:                    return false;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Writing
+
+namespace {
+  struct IfaceBuilder_ {
+    std::vector<const Entity*> order;
+    std::unordered_map<Entity::ID, uint32_t> index;
+    std::vector<detail_::IfaceRecord> records;
+    std::vector<uint32_t> extra;
+    std::string strings;
+
+    auto collect(const EntityTable& tbl, const Entity& ent) -> void {
+      for(const Entity::ID child_id : ent.chldrn_) {
+        const auto child = tbl.find_direct(child_id);
+        if(child == nullptr || !is_exported_(*child)) continue;
+        add(*child);
+
+        if(child->type_ == EntityType::Proc) {
+          const auto proc = Entity::cast<Proc>(child);
+          for(const Entity::ID param : proc->parameters_) {
+            if(const auto p = tbl.find_direct(param)) add(*p);
+          }
+          continue;               /// Don't descend into procedure bodies.
+        }
+
+        collect(tbl, *child);
+      }
+    }
+
+    auto add(const Entity& ent) -> void {
+      if(index.contains(ent.id_)) return;
+      index[ent.id_] = static_cast<uint32_t>(order.size());
+      order.emplace_back(&ent);
+    }
+
+    auto ref(const Entity::ID id) const -> uint32_t {
+      if(id == N19_INVALID_ENTITY_ID) return 0;
+      if(id < first_rec_) return id;
+      const auto it = index.find(id);
+      return it == index.end() ? 0 : it->second + first_rec_;
+    }
+
+    auto intern(const std::string_view str) -> uint32_t {
+      const auto off = static_cast<uint32_t>(strings.size());
+      strings.append(str);
+      return off;
+    }
+
+    auto quals(const EntityQualifierBase& q) -> void {
+      extra.emplace_back(static_cast<uint32_t>(q.flags_) | (q.ptr_depth_ << 8));
+      extra.emplace_back(static_cast<uint32_t>(q.arr_lengths_.size()));
+      extra.insert(extra.end(), q.arr_lengths_.begin(), q.arr_lengths_.end());
+    }
+
+    auto encode(const Entity::Ptr<>& ptr) -> void {
+      const Entity& ent = *ptr;
+      detail_::IfaceRecord rec{};
+      rec.name_off_  = intern(ent.name_);
+      rec.name_len_  = static_cast<uint32_t>(ent.name_.size());
+      rec.lname_off_ = static_cast<uint32_t>(ent.name_.size() - ent.lname_.size());
+      rec.parent_    = ref(ent.parent_);
+      rec.line_      = ent.line_;
+      rec.pos_       = static_cast<uint32_t>(ent.pos_);
+      rec.type_      = static_cast<uint32_t>(ent.type_);
+      rec.extra_off_ = static_cast<uint32_t>(extra.size());
+
+      switch(ent.type_) {
+      case EntityType::AliasType: {
+        const auto alias = Entity::cast<AliasType>(ptr);
+        rec.link_ = ref(alias->link_);
+        quals(alias->quals_);
+        break;
+      }
+      case EntityType::SymLink:
+        rec.link_ = ref(Entity::cast<SymLink>(ptr)->link_);
+        break;
+      case EntityType::Variable: {
+        const auto var = Entity::cast<Variable>(ptr);
+        rec.link_ = ref(var->type_);
+        quals(var->quals_);
+        break;
+      }
+      case EntityType::Proc: {
+        const auto proc = Entity::cast<Proc>(ptr);
+        rec.link_ = ref(proc->return_type_);
+        extra.emplace_back(static_cast<uint32_t>(proc->parameters_.size()));
+        for(const Entity::ID param : proc->parameters_) extra.emplace_back(ref(param));
+        break;
+      }
+      case EntityType::Struct: {
+        const auto strct = Entity::cast<Struct>(ptr);
+        extra.emplace_back(static_cast<uint32_t>(strct->members_.size()));
+        for(const auto& member : strct->members_) {
+          extra.emplace_back(intern(member.name_));
+          extra.emplace_back(static_cast<uint32_t>(member.name_.size()));
+          extra.emplace_back(ref(member.type_id_));
+          quals(member.quals_);
+        }
+        break;
+      }
+      default: break;
+      }
+
+      rec.extra_len_ = static_cast<uint32_t>(extra.size()) - rec.extra_off_;
+      records.emplace_back(rec);
+    }
+  };
+}
+
+auto ModuleInterface::write(const EntityTable& tbl, const sys::String& path) -> Result<void> {
+  IfaceBuilder_ builder;
+  builder.collect(tbl, *tbl.root_);
+  for(const Entity* ent : builder.order) {
+    builder.encode(tbl.find_direct(ent->id_));
+  }
+
+  const auto num_records = static_cast<uint32_t>(builder.records.size());
+  const auto num_buckets = std::bit_ceil(std::max<uint32_t>(num_records * 2, 8));
+  std::vector<uint32_t> buckets(num_buckets, 0);
+
+  for(uint32_t i = 0; i < num_records; i++) {
+    const auto& rec = builder.records[i];
+    const auto name = std::string_view{builder.strings}.substr(rec.name_off_, rec.name_len_);
+    uint32_t slot   = hash_name_(name) & (num_buckets - 1);
+    while(buckets[slot] != 0) {
+      slot = (slot + 1) & (num_buckets - 1);
+    }
+    buckets[slot] = i + 1;      /// Zero marks an empty bucket.
+  }
+
+  detail_::IfaceHeader header{};
+  std::memcpy(header.magic_, iface_magic_, sizeof(iface_magic_));
+  header.version_      = N19_MODULE_INTERFACE_VERSION;
+  header.num_records_  = num_records;
+  header.num_buckets_  = num_buckets;
+  header.num_extra_    = static_cast<uint32_t>(builder.extra.size());
+  header.records_off_  = sizeof(detail_::IfaceHeader);
+  header.buckets_off_  = header.records_off_ + num_records * sizeof(detail_::IfaceRecord);
+  header.extra_off_    = header.buckets_off_ + num_buckets * sizeof(uint32_t);
+  header.strings_off_  = header.extra_off_ + header.num_extra_ * sizeof(uint32_t);
+  header.strings_size_ = static_cast<uint32_t>(builder.strings.size());
+
+  ///
+  /// Other jobs may have the old interface mapped: write a new
+  /// file next to it and rename it over the old one, so they keep
+  /// reading the old contents instead of a truncated file.
+  const sys::String temp = path + _nstr(".tmp");
+  auto file = TRY(sys::File::create_trunc(temp, sys::File::Write));
+  const auto write_all = [&]() -> Result<void> {
+    TRY(file.write(std::as_bytes(std::span{&header, 1})));
+    TRY(file.write(as_bytes(builder.records)));
+    TRY(file.write(as_bytes(buckets)));
+    TRY(file.write(as_bytes(builder.extra)));
+    TRY(file.write(as_bytes(builder.strings)));
+    return Result<void>::create();
+  };
+
+  auto result = write_all();
+  file.close();
+
+  std::error_code ec;
+  if(!result.has_value()) {
+    std::filesystem::remove(std::filesystem::path(temp), ec);
+    return result;
+  }
+
+  std::filesystem::rename(std::filesystem::path(temp), std::filesystem::path(path), ec);
+  if(ec) {
+    std::filesystem::remove(std::filesystem::path(temp), ec);
+    return Error{ErrC::FileIO, "Could not replace the module interface."};
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reading
+
+auto ModuleInterface::open(const sys::String& path, const sys::String& source) -> Result<Ptr> {
+  auto iface     = std::make_shared<ModuleInterface>();
+  iface->file_   = TRY(sys::MappedFile::open(path));
+  iface->source_ = source;
+
+  const auto size = iface->file_.size();
+  const auto base = reinterpret_cast<const char*>(iface->file_.data());
+  ERROR_IF(size < sizeof(detail_::IfaceHeader), ErrC::InvalidArg, "Module interface is truncated.");
+
+  const auto* header = reinterpret_cast<const detail_::IfaceHeader*>(base);
+  ERROR_IF(std::memcmp(header->magic_, iface_magic_, sizeof(iface_magic_)) != 0,
+    ErrC::InvalidArg, "File is not a module interface.");
+  ERROR_IF(header->version_ != N19_MODULE_INTERFACE_VERSION,
+    ErrC::InvalidArg, "Module interface was written by a different compiler version.");
+
+  const auto in_bounds = [&](const uint64_t off, const uint64_t len) -> bool {
+    return off % alignof(uint32_t) == 0 && off + len <= size;
+  };
+
+  ERROR_IF(!in_bounds(header->records_off_, uint64_t{header->num_records_} * sizeof(detail_::IfaceRecord))
+    || !in_bounds(header->buckets_off_, uint64_t{header->num_buckets_} * sizeof(uint32_t))
+    || !in_bounds(header->extra_off_,   uint64_t{header->num_extra_} * sizeof(uint32_t))
+    || header->strings_off_ + uint64_t{header->strings_size_} > size
+    || !std::has_single_bit(header->num_buckets_),
+    ErrC::InvalidArg, "Module interface is corrupt.");
+
+  iface->header_  = header;
+  iface->records_ = reinterpret_cast<const detail_::IfaceRecord*>(base + header->records_off_);
+  iface->buckets_ = reinterpret_cast<const uint32_t*>(base + header->buckets_off_);
+  iface->extra_   = reinterpret_cast<const uint32_t*>(base + header->extra_off_);
+  iface->strings_ = base + header->strings_off_;
+  iface->ids_.resize(header->num_records_, N19_INVALID_ENTITY_ID);
+
+  return Result<Ptr>::create(std::move(iface));
+}
+
+auto ModuleInterface::path_for(const sys::String& source) -> sys::String {
+  std::filesystem::path path(source);
+  path += N19_MODULE_INTERFACE_EXT;
+  return path.native();
+}
+
+auto ModuleInterface::name_of_(const uint32_t record) const -> std::string_view {
+  const auto& rec = records_[record];
+  if(uint64_t{rec.name_off_} + rec.name_len_ > header_->strings_size_) return {};
+  return std::string_view{strings_ + rec.name_off_, rec.name_len_};
+}
+
+auto ModuleInterface::lookup(const std::string_view name) const -> Maybe<uint32_t> {
+  if(header_ == nullptr || header_->num_records_ == 0 || name.empty()) {
+    return Nothing;
+  }
+
+  const uint32_t mask = header_->num_buckets_ - 1;
+  uint32_t slot = hash_name_(name) & mask;
+  for(uint32_t probes = 0; probes <= mask; probes++) {
+    const uint32_t entry = buckets_[slot];
+    if(entry == 0 || entry > header_->num_records_) break;
+    if(name_of_(entry - 1) == name) return entry - 1;
+    slot = (slot + 1) & mask;
+  }
+
+  return Nothing;
+}
+
+auto ModuleInterface::decode_ref_(EntityTable& tbl, const uint32_t ref) -> Result<Entity::ID> {
+  if(ref == 0) return N19_INVALID_ENTITY_ID;
+  if(ref < first_rec_) return ref;
+  if(ref - first_rec_ >= header_->num_records_) return N19_INVALID_ENTITY_ID;
+  const auto ent = TRY(materialize(tbl, ref - first_rec_));
+  return ent ? ent->id_ : N19_INVALID_ENTITY_ID;
+}
+
+auto ModuleInterface::decode_quals_(const uint32_t*& word, const uint32_t* end) const
+-> Result<EntityQualifierBase> {
+  ERROR_IF(end - word < 2, ErrC::InvalidArg, "Module interface is corrupt.");
+  ERROR_IF(static_cast<uint64_t>(end - word - 2) < word[1], ErrC::InvalidArg, "Module interface is corrupt.");
+
+  EntityQualifierBase quals;
+  quals.flags_     = static_cast<uint8_t>(word[0] & 0xff);
+  quals.ptr_depth_ = word[0] >> 8;
+  quals.arr_lengths_.assign(word + 2, word + 2 + word[1]);
+  word += 2 + word[1];
+  return quals;
+}
+
+auto ModuleInterface::materialize(EntityTable& tbl, const uint32_t record) -> Result<Entity::Ptr<>> {
+  ASSERT(record < num_records());
+  if(ids_[record] != N19_INVALID_ENTITY_ID) {
+    return tbl.find_direct(ids_[record]);
+  }
+
+  const auto& rec  = records_[record];
+  const auto name  = name_of_(record);
+  const auto lname = std::string{name.substr(std::min<size_t>(rec.lname_off_, name.size()))};
+
+  ///
+  /// Namespaces are open: if the importer already declares one with
+  /// the same name, reuse it rather than creating a duplicate.
+  if(rec.type_ == static_cast<uint32_t>(EntityType::Static)) {
+    if(auto existing = tbl.lookup_local(name); existing != nullptr) {
+      ids_[record] = existing->id_;
+      return existing;
+    }
+  }
+
+  ///
+  /// Everything read from the extra pool is checked against the
+  /// record's own slice of it, and names against the string pool:
+  /// a corrupt interface fails instead of reading past the mapping.
+  ERROR_IF(uint64_t{rec.extra_off_} + rec.extra_len_ > header_->num_extra_,
+    ErrC::InvalidArg, "Module interface is corrupt.");
+
+  const Entity::ID parent = TRY(decode_ref_(tbl, rec.parent_));
+  if(parent == N19_INVALID_ENTITY_ID) return nullptr;
+
+  const size_t mark = inserted_.size();
+  Entity::Ptr<> ent;
+  const auto line = std::max<uint32_t>(rec.line_, 1);
+  switch(static_cast<EntityType>(rec.type_)) {
+  case EntityType::Static:    ent = tbl.insert<Static>(parent, rec.pos_, line, source_, lname);    break;
+  case EntityType::Proc:      ent = tbl.insert<Proc>(parent, rec.pos_, line, source_, lname);      break;
+  case EntityType::Struct:    ent = tbl.insert<Struct>(parent, rec.pos_, line, source_, lname);    break;
+  case EntityType::Type:      ent = tbl.insert<Type>(parent, rec.pos_, line, source_, lname);      break;
+  case EntityType::SymLink:   ent = tbl.insert<SymLink>(parent, rec.pos_, line, source_, lname);   break;
+  case EntityType::AliasType: ent = tbl.insert<AliasType>(parent, rec.pos_, line, source_, lname); break;
+  case EntityType::Variable:  ent = tbl.insert<Variable>(parent, rec.pos_, line, source_, lname);  break;
+  default: return nullptr;
+  }
+
+  ids_[record] = ent->id_;     /// Must be set before decoding any references,
+  ++materialized_;             /// self referential structs would recurse forever.
+  inserted_.emplace_back(ent->id_);
+
+  ///
+  /// Don't leave a half decoded entity behind for lookups to find:
+  /// take it out again, along with everything inserted while decoding
+  /// it (which may refer to it), and forget their records.
+  if(auto decoded = decode_(tbl, ent, rec); !decoded.has_value()) {
+    const std::vector<Entity::ID> doomed(inserted_.begin() + mark, inserted_.end());
+    for(auto id = doomed.rbegin(); id != doomed.rend(); ++id) {
+      tbl.remove(*id);
+    }
+
+    forget({doomed.begin(), doomed.end()});
+    return decoded.release_error();
+  }
+
+  return ent;
+}
+
+auto ModuleInterface::forget(const std::unordered_set<Entity::ID>& removed) -> void {
+  for(Entity::ID& id : ids_) {
+    if(removed.contains(id)) id = N19_INVALID_ENTITY_ID;
+  }
+
+  const size_t before = inserted_.size();
+  std::erase_if(inserted_, [&](const Entity::ID id) { return removed.contains(id); });
+  materialized_ -= before - inserted_.size();
+}
+
+auto ModuleInterface::decode_(EntityTable& tbl, const Entity::Ptr<>& ent, const detail_::IfaceRecord& rec)
+-> Result<void> {
+  const uint32_t* word = rec.extra_len_ != 0 ? extra_ + rec.extra_off_ : nullptr;
+  const uint32_t* end  = word ? word + rec.extra_len_ : nullptr;
+  const auto remaining = [&] { return static_cast<uint64_t>(end - word); };
+
+  switch(ent->type_) {
+  case EntityType::SymLink:
+    Entity::cast<SymLink>(ent)->link_ = TRY(decode_ref_(tbl, rec.link_));
+    break;
+  case EntityType::AliasType: {
+    auto alias = Entity::cast<AliasType>(ent);
+    alias->link_ = TRY(decode_ref_(tbl, rec.link_));
+    if(word) alias->quals_ = TRY(decode_quals_(word, end));
+    break;
+  }
+  case EntityType::Variable: {
+    auto var = Entity::cast<Variable>(ent);
+    var->type_ = TRY(decode_ref_(tbl, rec.link_));
+    if(word) var->quals_ = TRY(decode_quals_(word, end));
+    break;
+  }
+  case EntityType::Proc: {
+    auto proc = Entity::cast<Proc>(ent);
+    proc->return_type_ = TRY(decode_ref_(tbl, rec.link_));
+    if(!word) break;
+    const uint32_t count = *word++;
+    ERROR_IF(remaining() < count, ErrC::InvalidArg, "Module interface is corrupt.");
+    for(uint32_t i = 0; i < count; i++) {
+      proc->parameters_.emplace_back(TRY(decode_ref_(tbl, *word++)));
+    }
+    break;
+  }
+  case EntityType::Struct: {
+    auto strct = Entity::cast<Struct>(ent);
+    if(!word) break;
+    const uint32_t count = *word++;
+    for(uint32_t i = 0; i < count; i++) {
+      ERROR_IF(remaining() < 3, ErrC::InvalidArg, "Module interface is corrupt.");
+      ERROR_IF(uint64_t{word[0]} + word[1] > header_->strings_size_,
+        ErrC::InvalidArg, "Module interface is corrupt.");
+      auto& member    = strct->members_.emplace_back();
+      member.name_    = std::string{strings_ + word[0], word[1]};
+      member.type_id_ = TRY(decode_ref_(tbl, word[2]));
+      word += 3;
+      member.quals_   = TRY(decode_quals_(word, end));
+    }
+    break;
+  }
+  default: break;
+  }
+
+  return Result<void>::create();
+}
+
+auto ModuleInterface::materialize_all(EntityTable& tbl) -> Result<void> {
+  for(uint32_t record = 0; record < num_records(); record++) {
+    TRY(materialize(tbl, record));
+  }
+
+  return Result<void>::create();
+}
+
+auto ModuleInterface::resolve(EntityTable& tbl, const std::string_view name) -> Result<Entity::Ptr<>> {
+  const auto record = lookup(name);
+  if(!record.has_value()) return nullptr;
+  return materialize(tbl, *record);
+}
+
+END_NAMESPACE(n19);
@@ -0,0 +1,155 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_MODULEINTERFACE_HPP
+#define N19_MODULEINTERFACE_HPP
+#include <Frontend/Entity.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Result.hpp>
+#include <Core/Maybe.hpp>
+#include <Sys/MappedFile.hpp>
+#include <Sys/String.hpp>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#define N19_MODULE_INTERFACE_EXT     ".n19i"
+#define N19_MODULE_INTERFACE_VERSION 1
+BEGIN_NAMESPACE(n19);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Precompiled module interfaces.
+//
+// An interface file is a flat, position independent image of the
+// public part of an EntityTable (namespaces, procs, structs, aliases).
+// It's laid out so that it can be mapped and used in place:
+//
+// [ Header ][ Records... ][ Buckets... ][ Extra words... ][ Strings... ]
+//
+// Records are fixed size and stored in pre-order, so a parent always
+// comes before its children. References between entities are encoded as
+// "refs": zero is invalid, values below BuiltinType::AfterLastID are the
+// root or a builtin type, anything above that is a record index offset by
+// BuiltinType::AfterLastID. Buckets form an open addressing hash table
+// keyed on the fully qualified entity name.
+//
+// The parser materializes a whole interface as soon as it imports it,
+// so the importing EntityTable ends up holding the same declarations
+// it would have if the source had been parsed. Tables can also keep an
+// interface in imports_ and have EntityTable::lookup() pull in single
+// entities (and whatever they reference) only when they're asked for.
+
+namespace detail_ {
+  struct IfaceHeader {
+    char     magic_[8];      /// Always "N19MODI\0".
+    uint32_t version_;       /// N19_MODULE_INTERFACE_VERSION.
+    uint32_t num_records_;   /// Amount of records following the header.
+    uint32_t num_buckets_;   /// Hash table size, always a power of two.
+    uint32_t num_extra_;     /// Amount of 32 bit words in the extra pool.
+    uint32_t records_off_;   /// Byte offsets from the start of the file.
+    uint32_t buckets_off_;   ///
+    uint32_t extra_off_;     ///
+    uint32_t strings_off_;   ///
+    uint32_t strings_size_;  ///
+    uint32_t reserved_;      ///
+  };
+
+  struct IfaceRecord {
+    uint32_t name_off_;      /// Fully qualified name, in the string pool.
+    uint32_t name_len_;      ///
+    uint32_t lname_off_;     /// Where the local name begins within name_.
+    uint32_t parent_;        /// Ref to the parent entity.
+    uint32_t line_;          ///
+    uint32_t pos_;           ///
+    uint32_t type_;          /// EntityType.
+    uint32_t link_;          /// Aliased entity / return type / variable type.
+    uint32_t extra_off_;     /// Members, parameters or qualifiers.
+    uint32_t extra_len_;     /// In words.
+  };
+
+  static_assert(sizeof(IfaceHeader) == 48);
+  static_assert(sizeof(IfaceRecord) == 40);
+}
+
+class ModuleInterface {
+  N19_MAKE_NONCOPYABLE(ModuleInterface);
+  N19_MAKE_NONMOVABLE(ModuleInterface);
+public:
+  using Ptr = std::shared_ptr<ModuleInterface>;
+
+  /// Serializes the public subtree of a table to the given path.
+  /// The file is replaced in one go, never rewritten in place.
+  static auto write(
+    const EntityTable& tbl,
+    const sys::String& path
+  ) -> Result<void>;
+
+  /// Maps an interface file and validates its layout. Entities
+  /// materialized from it will have their file_ set to "source".
+  static auto open(
+    const sys::String& path,
+    const sys::String& source
+  ) -> Result<Ptr>;
+
+  /// Where the interface for a given source file lives.
+  static auto path_for(const sys::String& source) -> sys::String;
+
+  /// Returns the record index for a fully qualified name.
+  auto lookup(std::string_view name) const -> Maybe<uint32_t>;
+
+  /// Inserts the record (and its parents and
+  /// dependencies) into the table if it isn't there already.
+  /// Fails if the record's extra data runs out of bounds,
+  /// in which case nothing it inserted is left in the table.
+  auto materialize(EntityTable& tbl, uint32_t record) -> Result<Entity::Ptr<>>;
+
+  /// Materializes every record, parents before their children.
+  auto materialize_all(EntityTable& tbl) -> Result<void>;
+
+  /// Called by the table when it removes entities, their IDs can
+  /// be reused. Records they came from materialize again next time.
+  auto forget(const std::unordered_set<Entity::ID>& removed) -> void;
+
+  /// Same as lookup() followed by materialize().
+  /// Returns nullptr if the name isn't exported by this interface.
+  auto resolve(EntityTable& tbl, std::string_view name) -> Result<Entity::Ptr<>>;
+
+  NODISCARD_ auto num_records()  const -> size_t;
+  NODISCARD_ auto num_materialized() const -> size_t;
+
+  sys::String source_;
+
+ ~ModuleInterface() = default;
+  ModuleInterface() = default;
+private:
+  auto name_of_(uint32_t record) const -> std::string_view;
+  auto decode_ref_(EntityTable& tbl, uint32_t ref) -> Result<Entity::ID>;
+  auto decode_quals_(const uint32_t*& word, const uint32_t* end) const -> Result<EntityQualifierBase>;
+  auto decode_(EntityTable& tbl, const Entity::Ptr<>& ent, const detail_::IfaceRecord& rec) -> Result<void>;
+
+  sys::MappedFile file_;
+  const detail_::IfaceHeader* header_ = nullptr;
+  const detail_::IfaceRecord* records_ = nullptr;
+  const uint32_t* buckets_ = nullptr;
+  const uint32_t* extra_   = nullptr;
+  const char* strings_     = nullptr;
+
+  std::vector<Entity::ID> ids_;       /// Record index -> materialized ID.
+  std::vector<Entity::ID> inserted_;  /// In the order they were inserted.
+  size_t materialized_ = 0;
+};
+
+FORCEINLINE_ auto ModuleInterface::num_records() const -> size_t {
+  return header_ ? header_->num_records_ : 0;
+}
+
+FORCEINLINE_ auto ModuleInterface::num_materialized() const -> size_t {
+  return materialized_;
+}
+
+END_NAMESPACE(n19);
+#endif //N19_MODULEINTERFACE_HPP
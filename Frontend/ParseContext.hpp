@@ -6,12 +6,15 @@
 #ifndef N19_PARSECONTEXT_HPP
 #define N19_PARSECONTEXT_HPP
 #include <Core/Panic.hpp>
+#include <Core/Maybe.hpp>
 #include <Frontend/ErrorCollector.hpp>
 #include <Frontend/Lexer.hpp>
 #include <Frontend/EntityTable.hpp>
 #include <Frontend/AstNodes.hpp>
 #include <IO/Stream.hpp>
 #include <string>
+#include <vector>
+#include <memory>
 #include <cstdint>
 BEGIN_NAMESPACE(n19);
 
@@ -19,12 +22,39 @@ namespace detail_ {
   enum class IncludeState : uint8_t {
     Pending  = 0, /// File needs to be parsed.
     Finished = 1, /// File has already been parsed.
+    Embedded = 2, /// File is @embed-ed data, never parsed.
   };
 
   struct IncludedFile {
     std::string name_;
     IncludeState state_ = IncludeState::Pending;
   };
+
+  /// One toplevel declaration, as found by the pre-scan.
+  struct DeclRange {
+    Token first_;              /// The declaration's first token.
+    uint32_t end_    = 0;      /// File offset where the next one begins.
+    uint32_t idents_ = 0;      /// Identifiers inside, bounds the entities it can declare.
+  };
+
+  /// A type name a parser worker ran into. Looking it up
+  /// there would depend on what the other workers have
+  /// declared so far, so it's resolved after the merge.
+  struct DeferredType {
+    Entity::ID user_ = N19_INVALID_ENTITY_ID; /// The variable or procedure it's the type of.
+    std::string name_;
+    uint32_t pos_ = 0;                        /// Where it was named.
+  };
+
+  /// Everything parsing one DeclRange produced, kept aside
+  /// until it can be spliced into the main context in order.
+  struct RangeResult {
+    std::vector<AstNode::Ptr<>> decls_;
+    std::vector<IncludedFile> includes_;
+    ErrorCollector errors_;
+    Maybe<ErrorLocation> failure_;
+    std::vector<DeferredType> types_;
+  };
 }
 
 struct ParseContext {
@@ -38,6 +68,21 @@ struct ParseContext {
   std::vector<detail_::IncludedFile> includes_;
   std::vector<AstNode::Ptr<>> toplevel_decls_;
 
+  size_t threads_ = 0;                     /// Parser workers, zero: one per hardware thread.
+  bool pin_workers_ = true;                /// Pin them, when there's more than one NUMA node.
+  size_t parallel_min_bytes_ = 64 * 1024;  /// Smaller files aren't worth splitting up.
+  size_t pipeline_min_bytes_ = 32 * 1024;  /// Smaller files are lexed on the parser's thread.
+  size_t packed_min_elems_   = 64;         /// Smaller aggregates keep one node per element.
+  size_t embed_max_bytes_    = 256 << 20;  /// Largest file @embed will take.
+
+  /// Skip procedure bodies, recording where they are instead.
+  /// Each one keeps the lexer's buffer alive for parse_bodies().
+  bool lazy_bodies_ = false;
+
+  /// Set on parser workers, type names are recorded
+  /// here instead of being looked up right away.
+  std::vector<detail_::DeferredType>* deferred_types_ = nullptr;
+
   ParseContext(
     OStream& errstream,
     ErrorCollector& errors,
@@ -51,7 +96,7 @@ struct ParseContext {
     , entities(entities)
   {
     ASSERT(!lxr.src_.empty());
-    ASSERT(!entities.map_.empty());
+    ASSERT(entities.exists(N19_ROOT_ENTITY_ID));
   }
 
   bool on(TokenCategory cat) { return lxr.current().cat_.isa(cat); }
@@ -4,13 +4,27 @@
 */
 
 #include <Frontend/Parser.hpp>
+#include <Frontend/ModuleInterface.hpp>
 #include <Core/StringUtil.hpp>
+#include <Core/Defer.hpp>
 #include <Sys/File.hpp>
+#include <Sys/MappedFile.hpp>
+#include <Sys/Topology.hpp>
 #include <algorithm>
+#include <iterator>
 #include <utility>
 #include <filesystem>
+#include <atomic>
+#include <thread>
+#include <charconv>
+#include <climits>
+#include <cctype>
 BEGIN_NAMESPACE(n19::detail_);
 
+static stats::Counter toplevel_decls_{"parser.toplevel_decls"};
+static stats::Counter bodies_deferred_{"parser.bodies_deferred"};
+static stats::Counter bodies_parsed_late_{"parser.bodies_parsed_late"};
+
 auto is_node_toplevel_valid_(const AstNode::Ptr<> &ptr) -> bool {
   switch (ptr->type_) {
   case AstNode::Type::Namespace:         FALLTHROUGH_;
@@ -32,6 +46,7 @@ auto is_valid_subexpression_(const AstNode::Ptr<>& ptr) -> bool {
   case AstNode::Type::ScalarLiteral:     FALLTHROUGH_;
   case AstNode::Type::AggregateLiteral:  FALLTHROUGH_;
   case AstNode::Type::UnaryExpr:         FALLTHROUGH_;
+  case AstNode::Type::Embed:             FALLTHROUGH_;
   case AstNode::Type::Subscript:         return true;
   default:                               return false;
   }
@@ -142,52 +157,243 @@ auto parse_begin_(
 
 auto parse_impl_(ParseContext &ctx) -> bool {
   do {
+    if (!detail_::parse_file_(ctx)) {
+      return false;
+    }
+  } while (detail_::get_next_include_(ctx));
+
+  return true;
+}
+
+auto parse_file_(ParseContext& ctx) -> bool {
+  const size_t hardware = std::max<size_t>(1, sys::CpuTopology::the().size());
+  const size_t workers  = ctx.threads_ ? ctx.threads_ : hardware;
+
+  if (workers > 1
+    && ctx.lxr.src_.size() >= ctx.parallel_min_bytes_
+    && ctx.lxr.current() != TokenType::EndOfFile)
+  {
+    const Token first = ctx.lxr.current();
+    auto ranges = scan_toplevel_(ctx.lxr);
+    if (ranges.has_value() && ranges->size() > 1) {
+      return parse_parallel_(ctx, *ranges);
+    }
+
+    /// The file couldn't be split up (or there's nothing
+    /// to split), rewind and parse it in one go.
+    ctx.lxr.seek(first.pos_, first.line_);
+  }
+
+  /// One parser, but the lexing can still be handed
+  /// off to a second thread that stays ahead of it.
+  if (workers > 1 && ctx.lxr.src_.size() >= ctx.pipeline_min_bytes_) {
+    ctx.lxr.start_pipeline();
+  }
+
+  DEFER({ ctx.lxr.stop_pipeline(); });
+  return parse_sequential_(ctx);
+}
+
+auto parse_sequential_(ParseContext& ctx) -> bool {
+  while (true) {
+    auto toplevel_decl = detail_::parse_begin_(ctx, false, false);
+
+    /// An error has occurred, or EOF was reached. We're done.
+    if (!toplevel_decl.has_value()) {
+      if (ctx.lxr.current() != TokenType::EndOfFile) {
+        ErrorCollector::display_error(
+          toplevel_decl.error().msg,
+          ctx.lxr, 
+          ctx.errstream);
+      }
+      break;
+    }
+
+    /// Note: a returned value of nullptr indicates that the
+    /// parser has encountered a valid sequence of tokens, but those tokens
+    /// do not produce an AST node. An example would be certain
+    /// "@" directives, or type declarations.
+    if (*toplevel_decl == nullptr) {
+      continue;
+    }
+
+    /// Verify that the returned node is valid at the toplevel
+    /// (i.e. can exist at the global scope).
+    if (!detail_::is_node_toplevel_valid_(*toplevel_decl)) {
+      ErrorCollector::display_error(
+        "Expression is invalid at the toplevel.",
+        ctx.lxr.file_name_,
+        ctx.lxr.src_,
+        ctx.errstream,
+        (*toplevel_decl)->pos_,
+        (*toplevel_decl)->line_);
+      return false;
+    }
+
+    /// Store the toplevel node within the parsing context.
+    toplevel_decls_.add();
+    ctx.toplevel_decls_.emplace_back(std::move(*toplevel_decl));
+  }
+
+  /// We expect the final token to be an EOF. If this isn't the case,
+  /// an error has occurred and parsing has failed.
+  return ctx.lxr.current() == TokenType::EndOfFile;
+}
+
+auto scan_toplevel_(Lexer& lxr) -> Maybe<std::vector<DeclRange>> {
+  std::vector<DeclRange> ranges;
+
+  ///
+  /// Procedures and namespaces end with the brace that closes
+  /// their body, everything else with a semicolon. The lexer already
+  /// drops comments and hands us strings as single tokens, so
+  /// braces and parens inside of those never show up here.
+  while (lxr.current() != TokenType::EndOfFile) {
+    DeclRange range{ .first_ = lxr.current() };
+    const bool braced = range.first_ == TokenType::Proc
+      || range.first_ == TokenType::Namespace;
+
+    uint32_t depth = 0;
     while (true) {
-      auto toplevel_decl = detail_::parse_begin_(ctx, false, false);
-
-      /// An error has occurred, or EOF was reached. We're done.
-      if (!toplevel_decl.has_value()) {
-        if (ctx.lxr.current() != TokenType::EndOfFile) {
-          ErrorCollector::display_error(
-            toplevel_decl.error().msg,
-            ctx.lxr, 
-            ctx.errstream);
-        }
+      const Token tok = lxr.current();
+      switch (tok.type_.value) {
+      case TokenType::EndOfFile:      FALLTHROUGH_;
+      case TokenType::Illegal:        return Nothing;
+      case TokenType::Identifier:     ++range.idents_; break;
+      case TokenType::LeftBrace:      FALLTHROUGH_;
+      case TokenType::LeftParen:      FALLTHROUGH_;
+      case TokenType::LeftSqBracket:  ++depth; break;
+      case TokenType::RightBrace:     FALLTHROUGH_;
+      case TokenType::RightParen:     FALLTHROUGH_;
+      case TokenType::RightSqBracket:
+        if (depth == 0) return Nothing;
+        --depth;
         break;
+      default: break;
       }
 
-      /// Note: a returned value of nullptr indicates that the
-      /// parser has encountered a valid sequence of tokens, but those tokens
-      /// do not produce an AST node. An example would be certain
-      /// "@" directives, or type declarations.
-      if (*toplevel_decl == nullptr) {
-        continue;
+      lxr.consume(1);
+      if (depth == 0 && (tok == TokenType::Semicolon
+        || (braced && tok == TokenType::RightBrace))) {
+        break;
       }
+    }
 
-      /// Verify that the returned node is valid at the toplevel
-      /// (i.e. can exist at the global scope).
-      if (!detail_::is_node_toplevel_valid_(*toplevel_decl)) {
-        ErrorCollector::display_error(
-          "Expression is invalid at the toplevel.",
-          ctx.lxr.file_name_,
-          ctx.lxr.src_,
-          ctx.errstream,
-          (*toplevel_decl)->pos_,
-          (*toplevel_decl)->line_);
-        return false;
-      }
+    range.end_ = lxr.current() == TokenType::EndOfFile
+      ? static_cast<uint32_t>(lxr.src_.size())
+      : lxr.current().pos_;
+    ranges.emplace_back(range);
+  }
+
+  return ranges;
+}
 
-      /// Store the toplevel node within the parsing context.
-      ctx.toplevel_decls_.emplace_back(std::move(*toplevel_decl));
+auto parse_range_(
+  ParseContext& parent,
+  Lexer& lxr,
+  const DeclRange& range,
+  RangeResult& out ) -> void
+{
+  ///
+  /// The lexer is cut off where the next declaration begins,
+  /// if the parser disagrees with the pre-scan about where this
+  /// one ends it runs into EOF rather than into its neighbour.
+  ParseContext ctx(parent.errstream, out.errors_, lxr, parent.entities);
+  ctx.lazy_bodies_ = parent.lazy_bodies_;
+  ctx.packed_min_elems_ = parent.packed_min_elems_;
+  ctx.embed_max_bytes_  = parent.embed_max_bytes_;
+  ctx.deferred_types_   = &out.types_;
+  lxr.limit_ = range.end_;
+  lxr.seek(range.first_.pos_, range.first_.line_);
+
+  while (lxr.current() != TokenType::EndOfFile) {
+    auto decl = parse_begin_(ctx, false, false);
+    if (!decl.has_value()) {
+      out.failure_.emplace(decl.error().msg, lxr.current().pos_, lxr.current().line_, false);
+      break;
     }
 
-    /// We expect the final token to be an EOF. If this isn't the case,
-    /// an error has occurred and parsing has failed.
-    if (ctx.lxr.current() != TokenType::EndOfFile) {
-      return false;
+    if (*decl == nullptr) {
+      continue;
     }
 
-  } while (detail_::get_next_include_(ctx));
+    if (!is_node_toplevel_valid_(*decl)) {
+      out.failure_.emplace("Expression is invalid at the toplevel.", (*decl)->pos_, (*decl)->line_, false);
+      break;
+    }
+
+    toplevel_decls_.add();
+    ctx.toplevel_decls_.emplace_back(std::move(*decl));
+  }
+
+  out.decls_    = std::move(ctx.toplevel_decls_);
+  out.includes_ = std::move(ctx.includes_);
+}
+
+auto parse_parallel_(ParseContext& ctx, const std::vector<DeclRange>& ranges) -> bool {
+  const size_t hardware = std::max<size_t>(1, sys::CpuTopology::the().size());
+  const size_t workers  = std::clamp<size_t>(ctx.threads_ ? ctx.threads_ : hardware, 1, ranges.size());
+
+  ///
+  /// Every declaration gets a block of entity IDs before anybody
+  /// starts, handed out in source order. Which worker parses a
+  /// declaration, and when, doesn't change the IDs it ends up with.
+  std::vector<EntityTable::IdRange> ids;
+  ids.reserve(ranges.size());
+  for (const auto& range : ranges) {
+    ids.emplace_back(ctx.entities.reserve_ids(range.idents_ + 1));
+  }
+
+  std::vector<RangeResult> results(ranges.size());
+  std::atomic<size_t> next = 0;
+
+  /// Every worker lexes the file's one immutable buffer,
+  /// only their position in it is their own.
+  const auto cpus = ctx.pin_workers_ ? sys::CpuTopology::the().pinning(workers) : std::vector<uint32_t>{};
+  const auto work = [&](const size_t worker) {
+    sys::AffinityScope pin(cpus.empty() ? sys::AffinityScope::none : cpus[worker % cpus.size()]);
+    Lexer lxr;
+    lxr.set_source(ctx.lxr.buf_);
+    lxr.file_name_ = ctx.lxr.file_name_;
+
+    for (size_t i = next++; i < ranges.size(); i = next++) {
+      EntityTable::IdScope scope(ctx.entities, ids[i]);
+      parse_range_(ctx, lxr, ranges[i], results[i]);
+    }
+  };
+
+  ctx.entities.set_concurrent(true);
+  std::vector<std::thread> pool;
+  for (size_t w = 1; w < workers; w++) {
+    pool.emplace_back(work, w);
+  }
+
+  work(0);
+  for (auto& thread : pool) thread.join();
+  ctx.entities.set_concurrent(false);
+
+  ///
+  /// Splice everything back in source order. Like the sequential
+  /// parser, stop at the first declaration that failed and keep
+  /// whatever came before it. Type names are looked up here, now
+  /// that no worker can still be declaring anything.
+  for (auto& result : results) {
+    ctx.errors.merge(result.errors_);
+    std::ranges::move(result.includes_, std::back_inserter(ctx.includes_));
+    std::ranges::move(result.decls_, std::back_inserter(ctx.toplevel_decls_));
+    resolve_deferred_types_(ctx, result.types_);
+
+    if (result.failure_.has_value()) {
+      ErrorCollector::display_error(
+        result.failure_->message,
+        ctx.lxr.file_name_,
+        ctx.lxr.src_,
+        ctx.errstream,
+        result.failure_->file_pos,
+        result.failure_->line);
+      return false;
+    }
+  }
 
   return true;
 }
@@ -291,8 +497,161 @@ auto parse_scalar_lit_(ParseContext &ctx) -> Result<AstNode::Ptr<>> {
   return Result<AstNode::Ptr<>>::create(std::move(node));
 }
 
+///
+/// Walks the raw bytes after the opening brace without lexing
+/// them. Says no as soon as it finds the closing brace before
+/// packed_min_elems_ elements, or a byte that can't be part of a
+/// literal list, so most aggregates that won't be packed are never
+/// lexed twice. Yes only means it's worth trying.
+static auto worth_packing_(const ParseContext& ctx, const Token& open) -> bool {
+  const auto& src = ctx.lxr.src_;
+  const size_t end = std::min<size_t>(src.size(), ctx.lxr.limit_);
+  size_t elems  = 0;
+  bool in_elem  = false;
+
+  for(size_t i = open.pos_ + 1; i < end; i++) {
+    const char8_t ch = src[i];
+    if(ch == u8'#') {
+      while(i + 1 < end && src[i + 1] != u8'\n') ++i;
+      continue;
+    }
+
+    if(ch == u8',') {
+      in_elem = false;
+      continue;
+    }
+
+    if(ch == u8'}') return false;
+    if(CH_IS_SPACE(ch)) continue;
+    if(!std::isalnum(static_cast<uint8_t>(ch))
+      && ch != u8'.' && ch != u8'-' && ch != u8'+' && ch != u8'_') {
+      return false;
+    }
+
+    if(!in_elem) {
+      in_elem = true;
+      if(++elems >= ctx.packed_min_elems_) return true;
+    }
+  }
+
+  return false;
+}
+
+///
+/// Fast path for aggregates that are nothing but numeric literals
+/// of one kind, optionally negated: the values are converted right
+/// out of the source buffer into an AstAggregateLiteral::Packed.
+/// Anything else, including a literal the conversion doesn't take
+/// whole, puts the lexer back on the opening brace and returns null
+/// so that the general path can parse it (and report any errors).
+auto parse_packed_lit_(ParseContext& ctx) -> AstNode::Ptr<AstAggregateLiteral> {
+  const auto open = ctx.lxr.current();
+  ASSERT(open == TokenType::LeftBrace);
+  if(!worth_packing_(ctx, open)) {
+    return nullptr;
+  }
+
+  auto packed = std::make_unique<AstAggregateLiteral::Packed>();
+  const auto* src = reinterpret_cast<const char*>(ctx.lxr.src_.data());
+
+  auto convert = [&](const Token& tok, const bool negative) -> bool {
+    const char* first = src + tok.pos_;
+    const char* last  = first + tok.len_;
+
+    auto kind = AstScalarLiteral::IntLit;
+    int base  = 10;
+    switch(tok.type_.value) {
+    case TokenType::IntLiteral:     break;
+    case TokenType::OctalLiteral:   base = 8;  break;
+    case TokenType::HexLiteral:     base = 16; first += 2; break;
+    case TokenType::FloatLiteral:   kind = AstScalarLiteral::FloatLit; break;
+    case TokenType::BooleanLiteral: kind = AstScalarLiteral::BoolLit;  break;
+    default: return false;
+    }
+
+    if(packed->size() == 0) packed->kind_ = kind;
+    if(packed->kind_ != kind) return false;
+
+    if(kind == AstScalarLiteral::FloatLit) {
+      double value = 0.0;
+      const auto [ptr, ec] = std::from_chars(first, last, value);
+      if(ec != std::errc{} || ptr != last) return false;
+      packed->floats_.push_back(negative ? -value : value);
+      return true;
+    }
+
+    if(kind == AstScalarLiteral::BoolLit) {
+      if(negative) return false;
+      packed->ints_.push_back(std::string_view(first, last) == "true");
+      return true;
+    }
+
+    uint64_t value = 0;
+    const auto [ptr, ec] = std::from_chars(first, last, value, base);
+    if(ec != std::errc{} || ptr != last) return false;
+    if(negative) {
+      if(value > static_cast<uint64_t>(INT64_MAX) + 1) return false;
+      packed->has_negatives_ = true;
+      value = ~value + 1;
+    }
+
+    packed->ints_.push_back(value);
+    return true;
+  };
+
+  auto curr = ctx.lxr.consume(1);
+  while(curr != TokenType::RightBrace) {
+    const auto first = curr;
+    const bool negative = curr == TokenType::Sub;
+    if(negative) curr = ctx.lxr.consume(1);
+
+    if(!convert(curr, negative)) {
+      ctx.lxr.seek(open.pos_, open.line_);
+      return nullptr;
+    }
+
+    const auto index = static_cast<uint32_t>(packed->pos_.size());
+    if(packed->lines_.empty() || packed->lines_.back().line_ != first.line_) {
+      packed->lines_.push_back({index, first.line_});
+    }
+
+    packed->pos_.push_back(first.pos_);
+    curr = ctx.lxr.consume(1);
+    if(curr == TokenType::Comma) {
+      curr = ctx.lxr.consume(1);
+    } else if(curr != TokenType::RightBrace) {
+      ctx.lxr.seek(open.pos_, open.line_);
+      return nullptr;
+    }
+  }
+
+  if(packed->size() == 0 || packed->size() < ctx.packed_min_elems_) {
+    ctx.lxr.seek(open.pos_, open.line_);
+    return nullptr;
+  }
+
+  auto node = AstNode::create<AstAggregateLiteral>(
+    open.pos_,
+    open.line_,
+    nullptr,
+    ctx.lxr.file_name_
+  );
+
+  packed->ints_.shrink_to_fit();
+  packed->floats_.shrink_to_fit();
+  packed->pos_.shrink_to_fit();
+  packed->lines_.shrink_to_fit();
+
+  node->packed_ = std::move(packed);
+  ctx.lxr.consume(1);
+  return node;
+}
+
 auto parse_aggregate_lit_(ParseContext &ctx) -> Result<AstNode::Ptr<>> {
   ASSERT(ctx.lxr.current() == TokenType::LeftBrace);
+  if(auto packed = parse_packed_lit_(ctx)) {
+    return Result<AstNode::Ptr<>>::create(std::move(packed));
+  }
 
   auto node = AstNode::create<AstAggregateLiteral>(
     ctx.lxr.current().pos_,
@@ -307,12 +666,13 @@ auto parse_aggregate_lit_(ParseContext &ctx) -> Result<AstNode::Ptr<>> {
     auto child      = TRY(parse_begin_(ctx, true, false));
     child->parent_  = node.get();
 
-    node->children_.emplace_back(std::move(child));
     if(!is_valid_subexpression_(child)) {
       ctx.lxr.revert_before(curr);
       return Error{ErrC::BadExpr, "Invalid subexpression within aggregate literal."};
     }
 
+    node->children_.emplace_back(std::move(child));
+
     if(ctx.lxr.current() == TokenType::Comma)
       ctx.lxr.consume(1);
   }
@@ -351,14 +711,298 @@ auto parse_punctuator_(ParseContext& ctx) -> Result<AstNode::Ptr<>> {
 }
 
 auto parse_directive_(ParseContext& ctx) -> Result<AstNode::Ptr<>>{
-  return Error{ErrC::NotImplimented};
+  const auto at = ctx.lxr.current();
+  ASSERT(at == TokenType::At);
+
+  const auto name = ctx.lxr.consume(1);
+  ERROR_IF(name != TokenType::Identifier, ErrC::BadToken, "Expected a directive name after \"@\".");
+
+  const auto value = name.value(ctx.lxr);
+  if(value.has_value() && *value == "embed") {
+    return parse_embed_(ctx, at);
+  }
+
+  return Error{ErrC::NotImplimented, fmt("Unknown directive \"@{}\".", value.value_or(""))};
+}
+
+///
+/// @embed("path"). The path is relative to the file doing the
+/// embedding. The file is mapped rather than read, and the node
+/// only keeps a reference to the mapping. Its size is checked
+/// first, so oversized files are never mapped at all.
+auto parse_embed_(ParseContext& ctx, const Token& at) -> Result<AstNode::Ptr<>> {
+  ctx.lxr.consume(1);
+  TRY(ctx.lxr.expect_type(TokenType::LeftParen));
+  ERROR_IF(!ctx.on_type(TokenType::StringLiteral), ErrC::BadToken, "Expected a file path for @embed.");
+
+  const auto quoted = ctx.lxr.current().value(ctx.lxr);
+  ASSERT(quoted.has_value());
+  const auto name = TRY(unescape_quoted_string(*quoted));
+
+  std::filesystem::path path(name);
+  if(path.is_relative()) {
+    path = std::filesystem::path(ctx.lxr.file_name_).parent_path() / path;
+  }
+
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  if(!ec && size > ctx.embed_max_bytes_) {
+    return Error{ErrC::Overflow, fmt("Embedded file \"{}\" is larger than {} bytes.", name, ctx.embed_max_bytes_)};
+  }
+
+#ifdef N19_WIN32
+  auto mapping = sys::MappedFile::open(path.wstring());
+#else /// POSIX
+  auto mapping = sys::MappedFile::open(path.string());
+#endif
+
+  if(!mapping.has_value()) {
+    return Error{ErrC::FileIO, fmt("Could not embed \"{}\": {}", name, mapping.error().msg)};
+  } if(mapping->size() > ctx.embed_max_bytes_) { /// Grew since.
+    return Error{ErrC::Overflow, fmt("Embedded file \"{}\" is larger than {} bytes.", name, ctx.embed_max_bytes_)};
+  }
+
+  ctx.lxr.consume(1);
+  TRY(ctx.lxr.expect_type(TokenType::RightParen));
+
+  /// Embedded files are dependencies like any included file,
+  /// they just never get parsed.
+  const auto dependency = path.lexically_normal().string();
+  const bool seen = std::ranges::any_of(ctx.includes_, [&](const IncludedFile& f) {
+    return f.name_ == dependency;
+  });
+
+  if(!seen) {
+    ctx.includes_.emplace_back(IncludedFile{dependency, IncludeState::Embedded});
+  }
+
+  auto node = AstNode::create<AstEmbed>(
+    at.pos_,
+    at.line_,
+    nullptr,
+    ctx.lxr.file_name_);
+
+  node->mapping_ = std::make_shared<const sys::MappedFile>(mapping.release_value());
+  return Result<AstNode::Ptr<>>::create(std::move(node));
 }
 
 auto parse_keyword_(ParseContext& ctx) -> Result<AstNode::Ptr<>> {
-  /// TODO: keywords
+  switch(ctx.lxr.current().type_.value) {
+  case TokenType::Proc:   return parse_proc_decl_(ctx);
+  case TokenType::Return: return parse_return_(ctx);
+  default: break;
+  }
+
+  /// TODO: remaining keywords
   return Error{ErrC::NotImplimented};
 }
 
+auto parse_proc_decl_(ParseContext& ctx) -> Result<AstNode::Ptr<>> {
+  const auto begin = ctx.lxr.current();
+  ASSERT(begin == TokenType::Proc);
+  ctx.lxr.consume(1);
+  ERROR_IF(!ctx.on_type(TokenType::Identifier), ErrC::BadToken, "Expected a procedure name.");
+
+  auto node = AstNode::create<AstProcDecl>(
+    begin.pos_,
+    begin.line_,
+    nullptr,
+    ctx.lxr.file_name_);
+
+  node->name_ = TRY(parse_identifier_(ctx));
+  node->name_->parent_ = node.get();
+
+  const auto& name = static_cast<const AstEntityRefThunk&>(*node->name_).name_;
+  auto proc = ctx.entities.insert<Proc>(
+    ctx.curr_namespace,
+    begin.pos_,
+    begin.line_,
+    ctx.lxr.file_name_,
+    name);
+
+  ///
+  /// Parameters: a name, optionally followed by ": type".
+  ERROR_IF(!ctx.on_type(TokenType::LeftParen), ErrC::BadToken, "Expected \"(\" after the procedure name.");
+  ctx.lxr.consume(1);
+
+  while(!ctx.on_type(TokenType::RightParen)) {
+    const auto curr = ctx.lxr.current();
+    ERROR_IF(curr != TokenType::Identifier, ErrC::BadToken, "Expected a parameter name.");
+
+    auto param = AstNode::create<AstVardecl>(
+      curr.pos_,
+      curr.line_,
+      node.get(),
+      ctx.lxr.file_name_);
+
+    param->name_ = TRY(parse_identifier_(ctx));
+    param->name_->parent_ = param.get();
+
+    auto var = ctx.entities.insert<Variable>(
+      proc->id_,
+      curr.pos_,
+      curr.line_,
+      ctx.lxr.file_name_,
+      static_cast<const AstEntityRefThunk&>(*param->name_).name_);
+
+    if(ctx.on_type(TokenType::TypeAssignment)) {
+      ctx.lxr.consume(1);
+      var->type_ = TRY(parse_type_name_(ctx, var->id_));
+    }
+
+    proc->parameters_.emplace_back(var->id_);
+    node->arg_decls_.emplace_back(std::move(param));
+
+    if(ctx.on_type(TokenType::Comma)) {
+      ctx.lxr.consume(1);
+      continue;
+    }
+
+    ERROR_IF(!ctx.on_type(TokenType::RightParen), ErrC::BadToken, "Expected \",\" or \")\".");
+  }
+
+  ctx.lxr.consume(1);
+  if(ctx.on_type(TokenType::SkinnyArrow)) {
+    ctx.lxr.consume(1);
+    proc->return_type_ = TRY(parse_type_name_(ctx, proc->id_));
+  }
+
+  ERROR_IF(!ctx.on_type(TokenType::LeftBrace), ErrC::BadToken, "Expected a procedure body.");
+  if(ctx.lazy_bodies_) {
+    TRY(skip_proc_body_(ctx, *node));
+  } else {
+    TRY(parse_proc_body_(ctx, *node));
+  }
+
+  return Result<AstNode::Ptr<>>::create(std::move(node));
+}
+
+auto parse_proc_body_(ParseContext& ctx, AstProcDecl& proc) -> Result<void> {
+  ASSERT(ctx.on_type(TokenType::LeftBrace));
+  ctx.lxr.consume(1);
+
+  while(!ctx.on_type(TokenType::RightBrace)) {
+    ERROR_IF(ctx.on_type(TokenType::EndOfFile), ErrC::BadToken, "Unterminated procedure body.");
+    auto stmt = TRY(parse_begin_(ctx, false, false));
+    if(stmt == nullptr) continue;
+
+    stmt->parent_ = &proc;
+    proc.body_.emplace_back(std::move(stmt));
+  }
+
+  ctx.lxr.consume(1);
+  return Result<void>::create();
+}
+
+auto skip_proc_body_(ParseContext& ctx, AstProcDecl& proc) -> Result<void> {
+  ASSERT(ctx.on_type(TokenType::LeftBrace));
+  ASSERT(ctx.lxr.buf_ != nullptr);
+
+  auto lazy        = std::make_unique<AstProcDecl::LazyBody>();
+  lazy->src_       = ctx.lxr.buf_;
+  lazy->begin_     = ctx.lxr.current().pos_;
+  lazy->line_      = ctx.lxr.current().line_;
+  lazy->namespace_ = ctx.curr_namespace;
+
+  TRY(ctx.lxr.skip_block());
+  bodies_deferred_.add();
+  lazy->end_ = ctx.lxr.current() == TokenType::EndOfFile
+    ? static_cast<uint32_t>(ctx.lxr.src_.size())
+    : ctx.lxr.current().pos_;
+
+  proc.lazy_body_ = std::move(lazy);
+  return Result<void>::create();
+}
+
+auto parse_type_name_(ParseContext& ctx, const Entity::ID user) -> Result<Entity::ID> {
+  const auto curr = ctx.lxr.current();
+  ERROR_IF(curr != TokenType::Identifier, ErrC::BadToken, "Expected a type name.");
+
+  ///
+  /// Types that aren't declared yet are left unresolved,
+  /// resolving them is up to a later phase.
+  auto name = curr.value(ctx.lxr);
+  ASSERT(name.has_value());
+  ctx.lxr.consume(1);
+
+  if(ctx.deferred_types_ != nullptr) {
+    ctx.deferred_types_->emplace_back(user, std::string(*name), curr.pos_);
+    return Entity::ID{N19_INVALID_ENTITY_ID};
+  }
+
+  const auto ent = ctx.entities.lookup(fmt("::{}", *name));
+  return ent ? ent->id_ : Entity::ID{N19_INVALID_ENTITY_ID};
+}
+
+auto resolve_deferred_types_(ParseContext& ctx, const std::vector<DeferredType>& types) -> void {
+  for(const auto& type : types) {
+    ///
+    /// Every declaration in the file exists by now. Only the
+    /// ones the sequential parser would have seen count: those
+    /// from other files, and those from earlier in this one.
+    const auto ent = ctx.entities.lookup(fmt("::{}", type.name_));
+    const bool seen = ent && (ent->file_ != ctx.lxr.file_name_ || ent->pos_ < type.pos_);
+    const auto id = seen ? ent->id_ : Entity::ID{N19_INVALID_ENTITY_ID};
+
+    const auto user = ctx.entities.find_direct(type.user_);
+    if(auto var = Entity::try_cast<Variable>(user)) {
+      var->type_ = id;
+    } else if(auto proc = Entity::try_cast<Proc>(user)) {
+      proc->return_type_ = id;
+    }
+  }
+}
+
+auto parse_return_(ParseContext& ctx) -> Result<AstNode::Ptr<>> {
+  const auto begin = ctx.lxr.current();
+  ASSERT(begin == TokenType::Return);
+  ctx.lxr.consume(1);
+
+  auto node = AstNode::create<AstReturn>(
+    begin.pos_,
+    begin.line_,
+    nullptr,
+    ctx.lxr.file_name_);
+
+  if(ctx.lxr.current().is_terminator()) {
+    return Result<AstNode::Ptr<>>::create(std::move(node));
+  }
+
+  const auto curr = ctx.lxr.current();
+  node->value_ = TRY(parse_begin_(ctx, true, false));
+  node->value_->parent_ = node.get();
+
+  if(!is_valid_subexpression_(node->value_)) {
+    ctx.lxr.revert_before(curr);
+    return Error{ErrC::BadExpr, "Invalid expression following return."};
+  }
+
+  return Result<AstNode::Ptr<>>::create(std::move(node));
+}
+
+auto parse_lazy_body_(ParseContext& ctx, Lexer& lxr, AstProcDecl& proc) -> bool {
+  ASSERT(proc.lazy_body_ != nullptr);
+  ASSERT(lxr.buf_ == proc.lazy_body_->src_);
+  const auto& lazy = *proc.lazy_body_;
+
+  lxr.limit_ = lazy.end_;
+  lxr.seek(lazy.begin_, lazy.line_);
+
+  ParseContext local(ctx.errstream, ctx.errors, lxr, ctx.entities);
+  local.curr_namespace = lazy.namespace_;
+
+  auto body = parse_proc_body_(local, proc);
+  if(!body.has_value()) {
+    ErrorCollector::display_error(body.error().msg, lxr, ctx.errstream);
+    proc.body_.clear();
+    return false;
+  }
+
+  proc.lazy_body_.reset();
+  bodies_parsed_late_.add();
+  return true;
+}
+
 auto parse_unary_prefix_(ParseContext &ctx) -> Result<AstNode::Ptr<>> {
   ASSERT(ctx.on(TokenCategory::UnaryOp));
   const auto begin = ctx.lxr.current();
@@ -480,44 +1124,83 @@ auto parse_identifier_(ParseContext &ctx) -> Result<AstNode::Ptr<>> {
   return Result<AstNode::Ptr<>>::create(std::move(node));
 }
 
+auto try_import_interface_(ParseContext& ctx, const std::filesystem::path& path) -> bool {
+  const std::filesystem::path iface_path = ModuleInterface::path_for(path.native());
+
+  ///
+  /// Only use the interface if it's at least as new as the
+  /// source it was produced from, otherwise fall back to parsing.
+  std::error_code ec;
+  const auto iface_time = std::filesystem::last_write_time(iface_path, ec);
+  if(ec) return false;
+  const auto src_time = std::filesystem::last_write_time(path, ec);
+  if(ec || iface_time < src_time) return false;
+
+  auto iface = ModuleInterface::open(iface_path.native(), path.native());
+  if(!iface.has_value()) {
+    return false;
+  }
+
+  ///
+  /// Everything it declares goes into the table right away, the
+  /// same as parsing would. One that turns out to be corrupt is
+  /// taken back out again, and the source gets parsed instead.
+  if(!(*iface)->materialize_all(ctx.entities).has_value()) {
+    ctx.entities.remove_file(path.native());
+    return false;
+  }
+
+  ctx.entities.imports_.emplace_back(iface.release_value());
+  return true;
+}
+
 auto get_next_include_(ParseContext& ctx) -> bool {
   if (ctx.includes_.empty()) {
     return false;
   }
-  
-  auto next = std::ranges::find_if(ctx.includes_, [](const IncludedFile& f) {
-    return f.state_ == IncludeState::Pending;
-  });
 
-  if(next == ctx.includes_.end())
-    return false;
+  while(true) {
+    auto next = std::ranges::find_if(ctx.includes_, [](const IncludedFile& f) {
+      return f.state_ == IncludeState::Pending;
+    });
+
+    if(next == ctx.includes_.end())
+      return false;
+
+    /// ts is so fucking retarded 🥀💔
+    std::filesystem::path path(next->name_);
 
-  /// ts is so fucking retarded 🥀💔
-  std::filesystem::path path(next->name_);
+    /// A precompiled interface means we don't have to parse
+    /// the file at all: its entities are loaded from it instead.
+    if(try_import_interface_(ctx, path)) {
+      next->state_ = IncludeState::Finished;
+      continue;
+    }
 
 #ifdef N19_WIN32
-  auto file = sys::File::open(path.wstring());
+    auto file = sys::File::open(path.wstring());
 #else /// POSIX
-  auto file = sys::File::open(path.string());
+    auto file = sys::File::open(path.string());
 #endif
 
-  if(!file.has_value()) {
-    ctx.errstream
-      << Con::RedFG
-      << "\nError:"
-      << Con::Reset
-      << " could not open included file "
-      << next->name_
-      << ".\n\n";
-    return false;
-  }
+    if(!file.has_value()) {
+      ctx.errstream
+        << Con::RedFG
+        << "\nError:"
+        << Con::Reset
+        << " could not open included file "
+        << next->name_
+        << ".\n\n";
+      return false;
+    }
 
-  next->state_       = IncludeState::Finished;
-  ctx.curr_namespace = N19_ROOT_ENTITY_ID;
-  ctx.paren_level    = 0;
+    next->state_       = IncludeState::Finished;
+    ctx.curr_namespace = N19_ROOT_ENTITY_ID;
+    ctx.paren_level    = 0;
 
-  ASSERT(ctx.lxr.reset(*file));
-  return true;
+    ASSERT(ctx.lxr.reset(*file));
+    return true;
+  }
 }
 
 END_NAMESPACE(n19::detail_);
@@ -527,4 +1210,50 @@ auto parse(ParseContext& ctx) -> bool {
   return detail_::parse_impl_(ctx);
 }
 
+auto parse_body(AstProcDecl& proc, ParseContext& ctx) -> bool {
+  if(proc.lazy_body_ == nullptr) {
+    return true;
+  }
+
+  Lexer lxr;
+  lxr.set_source(proc.lazy_body_->src_);
+  lxr.file_name_ = proc.file_;
+  return detail_::parse_lazy_body_(ctx, lxr, proc);
+}
+
+auto parse_bodies(AstNode::Children<>& decls, ParseContext& ctx) -> bool {
+  Lexer lxr;
+  std::vector<AstNode::Children<>*> pending = { &decls };
+  bool ok = true;
+
+  ///
+  /// One lexer for all of them, pointed at whichever file's
+  /// buffer the next body lives in. Nothing is copied.
+  while(!pending.empty()) {
+    auto& list = *pending.back();
+    pending.pop_back();
+
+    for(auto& decl : list) {
+      if(decl == nullptr) continue;
+      if(decl->type_ == AstNode::Type::Namespace) {
+        pending.emplace_back(&static_cast<AstNamespace&>(*decl).body_);
+        continue;
+      }
+
+      if(decl->type_ != AstNode::Type::ProcDecl) continue;
+      auto& proc = static_cast<AstProcDecl&>(*decl);
+      if(proc.lazy_body_ == nullptr) continue;
+
+      if(lxr.buf_ != proc.lazy_body_->src_) {
+        lxr.set_source(proc.lazy_body_->src_);
+        lxr.file_name_ = proc.file_;
+      }
+
+      ok = detail_::parse_lazy_body_(ctx, lxr, proc) && ok;
+    }
+  }
+
+  return ok;
+}
+
 END_NAMESPACE(n19);
@@ -7,13 +7,18 @@
 #define N19_HIR_PARSER_HPP
 #include <Core/Result.hpp>
 #include <Core/Try.hpp>
+#include <Core/Maybe.hpp>
 #include <Frontend/ParseContext.hpp>
 #include <Frontend/AstNodes.hpp>
+#include <filesystem>
+#include <vector>
 
 ///
 /// Public parsing functions
 BEGIN_NAMESPACE(n19);
 auto parse(ParseContext& ctx) -> bool;
+auto parse_body(AstProcDecl& proc, ParseContext& ctx) -> bool;
+auto parse_bodies(AstNode::Children<>& decls, ParseContext& ctx) -> bool;
 END_NAMESPACE(n19);
 
 ///
@@ -28,21 +33,41 @@ auto parse_begin_(
 
 /// Utility
 auto get_next_include_(ParseContext&) -> bool;
+auto try_import_interface_(ParseContext&, const std::filesystem::path&) -> bool;
 auto is_node_toplevel_valid_(const AstNode::Ptr<>&)   -> bool;
 auto node_never_needs_terminal_(const AstNode::Ptr<>&) -> bool;
 auto is_valid_subexpression_(const AstNode::Ptr<>&)   -> bool;
 bool parse_impl_(ParseContext&);
 
+/// Parsing a single file, on one thread or split up
+/// into toplevel declarations parsed on several.
+auto parse_file_(ParseContext&)       -> bool;
+auto parse_sequential_(ParseContext&) -> bool;
+auto scan_toplevel_(Lexer&)           -> Maybe<std::vector<DeclRange>>;
+auto parse_parallel_(ParseContext&, const std::vector<DeclRange>&) -> bool;
+auto parse_range_(ParseContext&, Lexer&, const DeclRange&, RangeResult&) -> void;
+auto resolve_deferred_types_(ParseContext&, const std::vector<DeferredType>&) -> void;
+
+/// Procedures, and their bodies, which may be left for later.
+auto parse_proc_body_(ParseContext&, AstProcDecl&) -> Result<void>;
+auto skip_proc_body_(ParseContext&, AstProcDecl&)  -> Result<void>;
+auto parse_lazy_body_(ParseContext&, Lexer&, AstProcDecl&) -> bool;
+auto parse_type_name_(ParseContext&, Entity::ID) -> Result<Entity::ID>;
+
 ///
 /// Node producers
 auto parse_punctuator_(ParseContext&)    -> Result<AstNode::Ptr<>>;
 auto parse_scalar_lit_(ParseContext&)    -> Result<AstNode::Ptr<>>;
 auto parse_aggregate_lit_(ParseContext&) -> Result<AstNode::Ptr<>>;
+auto parse_packed_lit_(ParseContext&)    -> AstNode::Ptr<AstAggregateLiteral>;
 auto parse_keyword_(ParseContext&)       -> Result<AstNode::Ptr<>>;
 auto parse_unary_prefix_(ParseContext&)  -> Result<AstNode::Ptr<>>;
 auto parse_parens_(ParseContext&)        -> Result<AstNode::Ptr<>>;
 auto parse_directive_(ParseContext&)     -> Result<AstNode::Ptr<>>;
+auto parse_embed_(ParseContext&, const Token&) -> Result<AstNode::Ptr<>>;
 auto parse_identifier_(ParseContext&)    -> Result<AstNode::Ptr<>>;
+auto parse_proc_decl_(ParseContext&)     -> Result<AstNode::Ptr<>>;
+auto parse_return_(ParseContext&)        -> Result<AstNode::Ptr<>>;
 
 auto parse_postfix_(ParseContext&, AstNode::Ptr<>&&)    -> Result<AstNode::Ptr<>>;
 auto parse_subscript_(ParseContext&, AstNode::Ptr<> &&) -> Result<AstNode::Ptr<>>;
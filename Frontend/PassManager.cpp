@@ -0,0 +1,213 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/PassManager.hpp>
+#include <Frontend/Passes.hpp>
+#include <Frontend/FlightRecorder.hpp>
+#include <Sys/Time.hpp>
+#include <Sys/Topology.hpp>
+#include <IO/Console.hpp>
+#include <IO/Fmt.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+BEGIN_NAMESPACE(n19);
+
+auto AnalysisCache::scopes() -> const ScopeInfo& {
+  if(!scopes_) {
+    scopes_ = std::make_unique<ScopeInfo>(ScopeInfo::compute(*proc_));
+    ++computed_;
+  }
+
+  return *scopes_;
+}
+
+auto AnalysisCache::use_def() -> const UseDefInfo& {
+  if(!use_def_) {
+    use_def_ = std::make_unique<UseDefInfo>(UseDefInfo::compute(*proc_));
+    ++computed_;
+  }
+
+  return *use_def_;
+}
+
+auto AnalysisCache::control_flow() -> const ControlFlowGraph& {
+  if(!control_flow_) {
+    control_flow_ = std::make_unique<ControlFlowGraph>(ControlFlowGraph::compute(*proc_));
+    ++computed_;
+  }
+
+  return *control_flow_;
+}
+
+auto AnalysisCache::exprs() -> const ExprDag& {
+  if(!exprs_) {
+    exprs_ = std::make_unique<ExprDag>(ExprDag::compute(*proc_));
+    ++computed_;
+  }
+
+  return *exprs_;
+}
+
+auto AnalysisCache::invalidate(const uint8_t preserved) -> void {
+  if(!(preserved & Scopes))      scopes_.reset();
+  if(!(preserved & UseDef))      use_def_.reset();
+  if(!(preserved & ControlFlow)) control_flow_.reset();
+  if(!(preserved & Exprs))       exprs_.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static auto collect_procs_(AstNode::Children<>& decls, std::vector<AnalysisCache>& out) -> void {
+  for(auto& decl : decls) {
+    if(!decl) continue;
+    if(decl->type_ == AstNode::Type::Namespace) {
+      collect_procs_(static_cast<AstNamespace&>(*decl).body_, out);
+    } else if(decl->type_ == AstNode::Type::ProcDecl) {
+      out.emplace_back(static_cast<AstProcDecl&>(*decl));
+    }
+  }
+}
+
+auto PassManager::for_level(const int64_t level, OStream* remarks) -> PassManager {
+  PassManager manager;
+  if(level >= 1) {
+    manager
+      .add<SimplifyCfgPass>()
+      .add<DeadCodePass>();
+  }
+
+  if(level >= 2) {
+    manager
+      .add<InlinePass>(remarks)
+      .add<SimplifyCfgPass>()
+      .add<DeadCodePass>();
+  }
+
+  return manager;
+}
+
+auto PassManager::run(AstNode::Children<>& decls) -> void {
+  std::vector<AnalysisCache> caches;
+  collect_procs_(decls, caches);
+
+  for(size_t i = 0; i < passes_.size();) {
+    if(passes_[i]->kind() == Pass::Function) {
+      size_t end = i;                /// Gather the whole group of
+      while(end < passes_.size()     /// consecutive function passes.
+        && passes_[end]->kind() == Pass::Function) {
+        ++end;
+      }
+
+      run_functions_(i, end, caches);
+      i = end;
+      continue;
+    }
+
+    flight::note(passes_[i]->name());
+    sys::Stopwatch watch;
+    const auto preserved = static_cast<ModulePass&>(*passes_[i]).run(decls);
+    timings_[i].total_ += watch.elapsed();
+    timings_[i].runs_++;
+
+    if(preserved != AnalysisCache::All) {
+      timings_[i].changed_++;
+      for(auto& cache : caches) cache.invalidate(preserved);
+    }
+
+    if(!(preserved & AnalysisCache::Decls)) {
+      caches.clear();
+      collect_procs_(decls, caches);
+    }
+
+    ++i;
+  }
+}
+
+auto PassManager::run_functions_(
+  const size_t begin,
+  const size_t end,
+  std::vector<AnalysisCache>& caches ) -> void
+{
+  const size_t hardware = std::max<size_t>(1, sys::CpuTopology::the().size());
+  const size_t workers  = std::clamp<size_t>(threads_ ? threads_ : hardware, 1, std::max<size_t>(1, caches.size()));
+
+  ///
+  /// Procedures are handed out one at a time, and each one goes
+  /// through the whole group before the next is picked up: passes
+  /// within a group keep their order, procedures don't need one.
+  /// Timings are kept per worker and merged once everybody's done,
+  /// each worker allocating its own once it's been pinned.
+  std::atomic<size_t> next = 0;
+  std::vector<std::vector<Timing>> local(workers);
+
+  const auto cpus = pin_workers_ ? sys::CpuTopology::the().pinning(workers) : std::vector<uint32_t>{};
+  const auto work = [&](const size_t worker) {
+    sys::AffinityScope pin(cpus.empty() ? sys::AffinityScope::none : cpus[worker % cpus.size()]);
+    auto& out = local[worker];
+    out.resize(end - begin);
+    for(size_t proc = next++; proc < caches.size(); proc = next++) {
+      auto& cache = caches[proc];
+      for(size_t pass = begin; pass < end; pass++) {
+        const auto& fp = static_cast<const FunctionPass&>(*passes_[pass]);
+        flight::note(fp.name());
+        sys::Stopwatch watch;
+        const auto preserved = fp.run(*cache.proc_, cache);
+        cache.invalidate(preserved);
+
+        auto& timing = out[pass - begin];
+        timing.total_ += watch.elapsed();
+        timing.runs_++;
+        if(preserved != AnalysisCache::All) timing.changed_++;
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for(size_t w = 1; w < workers; w++) {
+    pool.emplace_back(work, w);
+  }
+
+  work(0);
+  for(auto& thread : pool) thread.join();
+
+  for(const auto& timings : local) {
+    for(size_t pass = begin; pass < end; pass++) {
+      timings_[pass].total_   += timings[pass - begin].total_;
+      timings_[pass].runs_    += timings[pass - begin].runs_;
+      timings_[pass].changed_ += timings[pass - begin].changed_;
+    }
+  }
+}
+
+auto PassManager::dump_timings(OStream& stream) const -> void {
+  const auto as_ms = [](const std::chrono::nanoseconds ns) {
+    return std::chrono::duration<double, std::milli>(ns).count();
+  };
+
+  std::chrono::nanoseconds total{0};
+  for(const auto& timing : timings_) total += timing.total_;
+
+  stream
+    << Con::Bold
+    << "---- Pass Timings\n"
+    << Con::Reset
+    << fmt("  {:<16}{:>12}{:>8}{:>8}{:>10}\n", "Pass", "ms", "%", "runs", "changed");
+
+  for(size_t i = 0; i < passes_.size(); i++) {
+    const auto& timing = timings_[i];
+    const double share = total.count() ? 100.0 * timing.total_.count() / total.count() : 0.0;
+    stream << fmt("  {:<16}{:>12.3f}{:>8.1f}{:>8}{:>10}\n",
+      passes_[i]->name(),
+      as_ms(timing.total_),
+      share,
+      timing.runs_,
+      timing.changed_);
+  }
+
+  stream << fmt("  {:<16}{:>12.3f}\n", "Total", as_ms(total));
+}
+
+END_NAMESPACE(n19);
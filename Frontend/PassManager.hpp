@@ -0,0 +1,148 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_PASSMANAGER_HPP
+#define N19_PASSMANAGER_HPP
+#include <Frontend/AstNodes.hpp>
+#include <Frontend/Analyses.hpp>
+#include <Core/ClassTraits.hpp>
+#include <IO/Stream.hpp>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+
+///
+/// Lazily computes and caches the analyses of one procedure.
+/// After a pass runs, every analysis it didn't preserve is dropped
+/// and recomputed the next time somebody asks for it.
+class AnalysisCache {
+  N19_MAKE_NONCOPYABLE(AnalysisCache);
+  N19_MAKE_DEFAULT_MOVE_CONSTRUCTIBLE(AnalysisCache);
+public:
+  enum Preserved : uint8_t {
+    None        = 0x00,       /// The pass changed the procedure.
+    Scopes      = 0x01,       /// ScopeInfo is still valid.
+    UseDef      = 0x01 << 1,  /// UseDefInfo is still valid.
+    ControlFlow = 0x01 << 2,  /// ControlFlowGraph is still valid.
+    Exprs       = 0x01 << 3,  /// ExprDag is still valid.
+    Decls       = 0x01 << 4,  /// Module passes: no procedure was added or removed.
+    All         = 0x1F,       /// The pass didn't change anything.
+  };
+
+  auto scopes()       -> const ScopeInfo&;
+  auto use_def()      -> const UseDefInfo&;
+  auto control_flow() -> const ControlFlowGraph&;
+  auto exprs()        -> const ExprDag&;
+  auto invalidate(uint8_t preserved) -> void;
+
+  NODISCARD_ auto num_computed() const -> size_t;
+  AstProcDecl* proc_ = nullptr;
+
+ ~AnalysisCache() = default;
+  explicit AnalysisCache(AstProcDecl& proc) : proc_(&proc) {}
+private:
+  std::unique_ptr<ScopeInfo> scopes_;
+  std::unique_ptr<UseDefInfo> use_def_;
+  std::unique_ptr<ControlFlowGraph> control_flow_;
+  std::unique_ptr<ExprDag> exprs_;
+  size_t computed_ = 0;       /// How many times an analysis was (re)computed.
+};
+
+class Pass {
+public:
+  enum Kind : uint8_t {
+    Function,                 /// Runs on one procedure at a time.
+    Module,                   /// Runs on all toplevel declarations at once.
+  };
+
+  NODISCARD_ virtual auto name() const -> std::string_view = 0;
+  NODISCARD_ virtual auto kind() const -> Kind = 0;
+  virtual ~Pass() = default;
+};
+
+///
+/// Function passes may only look at and change the procedure
+/// they're given. That's what allows the pass manager to run them
+/// on several procedures at once, so run() must be thread safe.
+class FunctionPass : public Pass {
+public:
+  NODISCARD_ auto kind() const -> Kind override { return Function; }
+  virtual auto run(AstProcDecl& proc, AnalysisCache& analyses) const -> uint8_t = 0;
+};
+
+///
+/// A module pass that adds or removes procedures must not report
+/// AnalysisCache::Decls: the pass manager then rebuilds its caches,
+/// which point straight at the procedures.
+class ModulePass : public Pass {
+public:
+  NODISCARD_ auto kind() const -> Kind override { return Module; }
+  virtual auto run(AstNode::Children<>& decls) -> uint8_t = 0;
+};
+
+///
+/// Runs a pipeline of passes over the toplevel declarations of
+/// a module. Consecutive function passes are grouped, and each group
+/// runs over all procedures in parallel; module passes act as barriers.
+class PassManager {
+  N19_MAKE_NONCOPYABLE(PassManager);
+  N19_MAKE_DEFAULT_MOVE_CONSTRUCTIBLE(PassManager);
+public:
+  struct Timing {
+    std::chrono::nanoseconds total_{0};  /// Summed over all procedures.
+    size_t runs_    = 0;                 /// Amount of procedures (or modules) visited.
+    size_t changed_ = 0;                 /// How many of those runs changed something.
+  };
+
+  /// The standard pipelines: -O0 does nothing, -O1 removes dead
+  /// code and simplifies control flow, -O2 adds inlining and
+  /// cleans up after it.
+  static auto for_level(int64_t level, OStream* remarks = nullptr) -> PassManager;
+
+  template<typename T, typename ...Args>
+  auto add(Args&&... args) -> PassManager&;
+
+  auto run(AstNode::Children<>& decls) -> void;
+  auto dump_timings(OStream& stream) const -> void;
+
+  NODISCARD_ auto num_passes() const -> size_t;
+  NODISCARD_ auto timing(size_t pass) const -> const Timing&;
+
+  size_t threads_ = 0;        /// Zero: one per hardware thread.
+  bool pin_workers_ = true;   /// Pin them, when there's more than one NUMA node.
+
+ ~PassManager() = default;
+  PassManager() = default;
+private:
+  auto run_functions_(size_t begin, size_t end, std::vector<AnalysisCache>& caches) -> void;
+
+  std::vector<std::unique_ptr<Pass>> passes_;
+  std::vector<Timing> timings_;
+};
+
+template<typename T, typename ...Args>
+auto PassManager::add(Args&&... args) -> PassManager& {
+  passes_.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
+  timings_.emplace_back();
+  return *this;
+}
+
+FORCEINLINE_ auto PassManager::num_passes() const -> size_t {
+  return passes_.size();
+}
+
+FORCEINLINE_ auto PassManager::timing(const size_t pass) const -> const Timing& {
+  return timings_.at(pass);
+}
+
+FORCEINLINE_ auto AnalysisCache::num_computed() const -> size_t {
+  return computed_;
+}
+
+END_NAMESPACE(n19);
+#endif //N19_PASSMANAGER_HPP
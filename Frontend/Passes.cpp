@@ -0,0 +1,234 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/Passes.hpp>
+#include <Frontend/AstUtil.hpp>
+#include <Frontend/CallGraph.hpp>
+#include <unordered_set>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+///
+/// Calls cb(list, owner) for every statement list in a subtree,
+/// outermost first. Statements removed from a list by the callback
+/// aren't visited.
+template<typename F>
+static auto visit_lists_(AstNode& node, F& cb) -> void {
+  bool owns_lists = false;
+  ast_for_each_list(node, [&](AstNode::Children<>& list) {
+    owns_lists = true;
+    cb(list, node);
+    for(auto& stmt : list) if(stmt) visit_lists_(*stmt, cb);
+  });
+
+  if(owns_lists) return;
+  ast_for_each_child(node, [&](AstNode* child, AstNode::Ptr<>*) {
+    visit_lists_(*child, cb);
+  });
+}
+
+static auto bool_value_(const AstNode* cond) -> Maybe<bool> {
+  if(!cond || cond->type_ != AstNode::Type::ScalarLiteral) return Nothing;
+  const auto& lit = static_cast<const AstScalarLiteral&>(*cond);
+  if(lit.scalar_type_ != AstScalarLiteral::BoolLit) return Nothing;
+  if(lit.value_ == "true")  return true;
+  if(lit.value_ == "false") return false;
+  return Nothing;
+}
+
+static auto declares_(const AstNode::Children<>& stmts) -> bool {
+  return std::ranges::any_of(stmts, [](const AstNode::Ptr<>& stmt) {
+    return stmt && stmt->type_ == AstNode::Type::Vardecl;
+  });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///
+/// The statements that replace a folded one. If they declare
+/// anything they keep a scope of their own, so names can't leak
+/// into the enclosing list.
+static auto unwrap_(AstNode::Children<>&& body, const AstNode& old) -> AstNode::Children<> {
+  if(!declares_(body)) return std::move(body);
+
+  auto block = AstNode::create<AstScopeBlock>(old.pos_, old.line_, nullptr, old.file_);
+  for(auto& stmt : body) if(stmt) stmt->parent_ = block.get();
+  block->children_ = std::move(body);
+
+  AstNode::Children<> out;
+  out.emplace_back(std::move(block));
+  return out;
+}
+
+///
+/// Returns the statements that should replace "stmt", or
+/// Nothing if it has to stay. Smaller edits that don't replace
+/// the statement itself only set "changed".
+static auto fold_(AstNode& stmt, bool& changed) -> Maybe<AstNode::Children<>> {
+  switch(stmt.type_) {
+  case AstNode::Type::Branch: {
+    auto& branch = static_cast<AstBranch&>(stmt);
+    if(!branch.if_) break;
+
+    if(const auto cond = bool_value_(branch.if_->condition_.get()); cond.has_value()) {
+      if(*cond) return unwrap_(std::move(branch.if_->body_), stmt);
+      if(branch.else_) return unwrap_(std::move(branch.else_->body_), stmt);
+      return AstNode::Children<>{};
+    }
+
+    if(branch.else_ && branch.else_->body_.empty()) {
+      branch.else_.reset();
+      changed = true;
+    }
+
+    if(!branch.else_ && branch.if_->body_.empty()
+      && branch.if_->condition_ && ast_is_pure(*branch.if_->condition_)) {
+      return AstNode::Children<>{};
+    }
+
+    break;
+  }
+
+  case AstNode::Type::While: {
+    auto& loop = static_cast<AstWhile&>(stmt);
+    const auto cond = bool_value_(loop.cond_.get());
+    if(!loop.is_dowhile && cond.has_value() && !*cond) {
+      return AstNode::Children<>{};
+    }
+
+    break;
+  }
+
+  case AstNode::Type::For: {
+    auto& loop = static_cast<AstFor&>(stmt);
+    const auto cond = bool_value_(loop.cond_.get());
+    if(!cond.has_value() || *cond) break;
+
+    AstNode::Children<> out;         /// The initializer still runs once.
+    if(loop.init_) out.emplace_back(std::move(loop.init_));
+    return unwrap_(std::move(out), stmt);
+  }
+
+  case AstNode::Type::ScopeBlock: {
+    auto& block = static_cast<AstScopeBlock&>(stmt);
+    if(declares_(block.children_)) break;
+    return std::move(block.children_);
+  }
+
+  default: break;
+  }
+
+  return Nothing;
+}
+
+auto SimplifyCfgPass::run(AstProcDecl& proc, AnalysisCache&) const -> uint8_t {
+  bool changed = false;
+  auto simplify = [&](AstNode::Children<>& list, AstNode& owner) {
+    for(size_t i = 0; i < list.size();) {
+      if(!list[i]) { ++i; continue; }
+
+      auto replacement = fold_(*list[i], changed);
+      if(!replacement.has_value()) { ++i; continue; }
+
+      auto& stmts = *replacement;    /// Don't advance: the spliced
+      for(auto& s : stmts) {         /// statements may fold further.
+        if(s) s->parent_ = &owner;
+      }
+
+      changed = true;
+      list.erase(list.begin() + static_cast<ptrdiff_t>(i));
+      list.insert(list.begin() + static_cast<ptrdiff_t>(i),
+        std::make_move_iterator(stmts.begin()),
+        std::make_move_iterator(stmts.end()));
+    }
+  };
+
+  visit_lists_(proc, simplify);
+  return changed ? AnalysisCache::None : AnalysisCache::All;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///
+/// Local variables that are never read, declared at the top
+/// of the procedure body, and only ever assigned side effect free
+/// values. Returns the declarations and assignments to remove.
+static auto dead_stores_(
+  AnalysisCache& analyses,
+  const std::unordered_set<const AstNode*>& stmts ) -> std::unordered_set<const AstNode*>
+{
+  std::unordered_set<const AstNode*> out;
+  const auto& scopes  = analyses.scopes();
+  const auto& use_def = analyses.use_def();
+
+  for(const AstVardecl* var : scopes.scopes_[0].decls_) {
+    if(!stmts.contains(var)) {
+      continue;                      /// Parameters live in the
+    }                                /// root scope as well.
+
+    const auto key = var->name_ ? callee_key(*var->name_) : Maybe<std::string>{Nothing};
+    const auto* chain = key.has_value() ? use_def.find(*key) : nullptr;
+    if(!chain || !chain->uses_.empty()) continue;
+
+    const bool removable = std::ranges::all_of(chain->defs_, [&](AstNode* def) {
+      if(def == var) return true;
+      if(!stmts.contains(def) || def->type_ != AstNode::Type::BinExpr) return false;
+      const auto& bin = static_cast<AstBinExpr&>(*def);
+      return bin.op_type_ == TokenType::ValueAssignment && bin.right_ && ast_is_pure(*bin.right_);
+    });
+
+    if(removable) out.insert(chain->defs_.begin(), chain->defs_.end());
+  }
+
+  return out;
+}
+
+auto DeadCodePass::run(AstProcDecl& proc, AnalysisCache& analyses) const -> uint8_t {
+  bool changed = false;
+  const auto erase_if = [&](AstNode::Children<>& list, auto&& pred) {
+    const auto erased = std::erase_if(list, [&](const AstNode::Ptr<>& stmt) {
+      return stmt && pred(*stmt);
+    });
+    changed = changed || erased > 0;
+  };
+
+  ///
+  /// Statements the control flow graph can't reach.
+  const auto& cfg = analyses.control_flow();
+  auto unreachable = [&](AstNode::Children<>& list, AstNode&) {
+    erase_if(list, [&](const AstNode& stmt) { return !cfg.is_reachable(&stmt); });
+  };
+
+  visit_lists_(proc, unreachable);
+  if(changed) analyses.invalidate(AnalysisCache::None);
+
+  ///
+  /// Dead stores and expression statements that don't do anything.
+  std::unordered_set<const AstNode*> stmts;
+  auto collect = [&](AstNode::Children<>& list, AstNode&) {
+    for(const auto& stmt : list) if(stmt) stmts.insert(stmt.get());
+  };
+
+  visit_lists_(proc, collect);
+  const auto doomed = dead_stores_(analyses, stmts);
+
+  auto useless = [&](AstNode::Children<>& list, AstNode&) {
+    erase_if(list, [&](AstNode& stmt) { return doomed.contains(&stmt) || ast_is_pure(stmt); });
+  };
+
+  visit_lists_(proc, useless);
+  return changed ? AnalysisCache::None : AnalysisCache::All;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto InlinePass::run(AstNode::Children<>& decls) -> uint8_t {
+  const auto stats = inline_procedures(decls, remarks_, params_);
+  return stats.inlined_ ? AnalysisCache::Decls : AnalysisCache::All;
+}
+
+END_NAMESPACE(n19);
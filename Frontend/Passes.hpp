@@ -0,0 +1,48 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_PASSES_HPP
+#define N19_PASSES_HPP
+#include <Frontend/PassManager.hpp>
+#include <Frontend/Inliner.hpp>
+#include <IO/Stream.hpp>
+BEGIN_NAMESPACE(n19);
+
+///
+/// Folds branches and loops whose condition is a boolean
+/// literal, drops empty branch arms and flattens blocks that
+/// don't declare anything.
+class SimplifyCfgPass final : public FunctionPass {
+public:
+  NODISCARD_ auto name() const -> std::string_view override { return "simplify-cfg"; }
+  auto run(AstProcDecl& proc, AnalysisCache& analyses) const -> uint8_t override;
+};
+
+///
+/// Removes statements that can never execute, expression
+/// statements without side effects, and local variables that
+/// are never read (along with the assignments to them).
+class DeadCodePass final : public FunctionPass {
+public:
+  NODISCARD_ auto name() const -> std::string_view override { return "dce"; }
+  auto run(AstProcDecl& proc, AnalysisCache& analyses) const -> uint8_t override;
+};
+
+///
+/// Wraps inline_procedures(), see Inliner.hpp.
+class InlinePass final : public ModulePass {
+public:
+  NODISCARD_ auto name() const -> std::string_view override { return "inline"; }
+  auto run(AstNode::Children<>& decls) -> uint8_t override;
+
+  explicit InlinePass(OStream* remarks = nullptr, const InlineParams& params = {})
+    : remarks_(remarks), params_(params) {}
+private:
+  OStream* remarks_ = nullptr;
+  InlineParams params_;
+};
+
+END_NAMESPACE(n19);
+#endif //N19_PASSES_HPP
@@ -0,0 +1,255 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/QueryEngine.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Core/Try.hpp>
+#include <IO/Fmt.hpp>
+#include <IO/Console.hpp>
+#include <unordered_set>
+#include <limits>
+BEGIN_NAMESPACE(n19);
+
+/// Plain SymLinks chained further than this are a cycle.
+static constexpr size_t max_link_hops_ = 64;
+
+static constexpr std::string_view query_names_[] = {
+#define X(UNUSED, NAME) NAME,
+  N19_QUERY_LIST
+#undef X
+};
+
+QueryEngine::QueryEngine(const EntityTable& entities, TypeTable& types)
+  : entities_(entities), types_(types) {}
+
+auto QueryEngine::ResolveHash_::operator()(const ResolveKey_& key) const -> size_t {
+  return std::hash<std::string>{}(key.name_) ^ (size_t{key.scope_} * 0x9E3779B97F4A7C15ULL);
+}
+
+auto QueryEngine::type_of(const Entity::ID decl) -> Result<TypeTable::ID> {
+  return fetch_(type_of_, TypeOf, decl, [this](const Entity::ID id) {
+    return compute_type_of_(id);
+  });
+}
+
+auto QueryEngine::members_of(const Entity::ID type) -> Result<std::vector<Member>> {
+  return fetch_(members_of_, MembersOf, type, [this](const Entity::ID id) {
+    return compute_members_of_(id);
+  });
+}
+
+auto QueryEngine::resolve(const Entity::ID scope, const std::string_view name) -> Result<Entity::ID> {
+  return fetch_(resolve_, Resolve, ResolveKey_{scope, std::string(name)}, [this](const ResolveKey_& key) {
+    return compute_resolve_(key);
+  });
+}
+
+auto QueryEngine::touch(const sys::String& file) -> void {
+  ++revision_;
+  file_changed_[file_index_(file)] = revision_;
+
+  /// Whatever the file declares now may shadow a name in its
+  /// scope. Anything it used to declare and doesn't anymore
+  /// was depended on through the file itself.
+  for(const Entity::ID id : entities_.entities_of(file)) {
+    if(const auto entity = entities_.find_direct(id)) {
+      scope_changed_[entity->parent_] = revision_;
+    }
+  }
+
+  ///
+  /// Types laid out from the file are dropped from the TypeTable,
+  /// along with anything still holding one of their IDs. Those
+  /// don't necessarily depend on the file themselves: a variable
+  /// elsewhere of a struct type whose member's type changed.
+  const auto dropped = types_.invalidate(file);
+  if(dropped.empty()) return;
+
+  const std::unordered_set<TypeTable::ID> stale(dropped.begin(), dropped.end());
+  for(auto& memo : type_of_.memos_) {
+    if(stale.contains(memo.value_)) memo.valid_ = false;
+  }
+
+  for(auto& memo : members_of_.memos_) {
+    const auto is_stale = [&](const Member& member) { return stale.contains(member.type_); };
+    if(std::ranges::any_of(memo.value_, is_stale)) memo.valid_ = false;
+  }
+}
+
+auto QueryEngine::compute_type_of_(const Entity::ID decl) -> Result<TypeTable::ID> {
+  const auto entity = read_(decl);
+  ERROR_IF(entity == nullptr, ErrC::NotFound, fmt("No entity with ID {}.", decl));
+
+  switch(entity->type_) {
+  case EntityType::Variable: {
+    const auto var = Entity::cast<Variable>(entity);
+    return intern_(var->type_, var->quals_);
+  }
+  case EntityType::AliasType: {
+    /// Only for the dependencies, and to catch aliases of
+    /// themselves: the table resolves the whole chain anyway.
+    TRY(intern_(Entity::cast<AliasType>(entity)->link_, {}));
+    return types_.intern(decl, {});
+  }
+  case EntityType::Proc: {
+    const auto proc = Entity::cast<Proc>(entity);
+    if(proc->return_type_ == N19_INVALID_ENTITY_ID) return TypeTable::invalid_;
+    return intern_(proc->return_type_, {});
+  }
+  case EntityType::Type:
+  case EntityType::Struct:
+  case EntityType::BuiltinType:
+  case EntityType::PlaceHolder:
+    return types_.intern(decl, {});
+  default:
+    return Error{ErrC::InvalidArg, fmt("\"{}\" does not have a type.", entity->name_)};
+  }
+}
+
+auto QueryEngine::compute_members_of_(const Entity::ID type) -> Result<std::vector<Member>> {
+  const auto entity = read_(type);
+  ERROR_IF(entity == nullptr, ErrC::NotFound, fmt("No entity with ID {}.", type));
+
+  const auto structure = Entity::try_cast<Struct>(entity);
+  ERROR_IF(structure == nullptr, ErrC::InvalidArg, fmt("\"{}\" is not a struct.", entity->name_));
+
+  std::vector<Member> out;
+  out.reserve(structure->members_.size());
+  for(const auto& member : structure->members_) {
+    const TypeTable::ID id = TRY(intern_(member.type_id_, member.quals_));
+    out.emplace_back(Member{member.name_, id});
+  }
+
+  return out;
+}
+
+auto QueryEngine::compute_resolve_(const ResolveKey_& key) -> Result<Entity::ID> {
+  const auto scope = read_(key.scope_);
+  ERROR_IF(scope == nullptr, ErrC::NotFound, fmt("No scope with ID {}.", key.scope_));
+
+  /// A child's name can only change along with its file,
+  /// which touch() reports as a change to this scope too.
+  depend_(Dep_{Dep_::Scope, Count, key.scope_});
+  for(const Entity::ID child : scope->chldrn_) {
+    const auto entity = entities_.find_direct(child);
+    if(entity != nullptr && entity->lname_ == key.name_) {
+      read_(child);
+      return child;
+    }
+  }
+
+  if(scope->id_ == N19_ROOT_ENTITY_ID || scope->parent_ == N19_INVALID_ENTITY_ID) {
+    return N19_INVALID_ENTITY_ID;
+  }
+
+  return resolve(scope->parent_, key.name_);
+}
+
+auto QueryEngine::intern_(const Entity::ID base, const EntityQualifierBase& quals) -> Result<TypeTable::ID> {
+  auto curr = read_(base);
+  for(size_t hops = 0; curr != nullptr && curr->type_ == EntityType::SymLink; hops++) {
+    ERROR_IF(hops == max_link_hops_, ErrC::InvalidArg, fmt("\"{}\" links to itself.", curr->name_));
+    curr = read_(Entity::cast<SymLink>(curr)->link_);
+  }
+
+  ERROR_IF(curr == nullptr, ErrC::NotFound, fmt("Type with ID {} does not exist.", base));
+  if(curr->type_ == EntityType::AliasType) {
+    TRY(type_of(curr->id_));
+  }
+
+  return types_.intern(base, quals);
+}
+
+auto QueryEngine::read_(const Entity::ID id) -> Entity::Ptr<> {
+  auto entity = entities_.find_direct(id);
+  if(entity != nullptr) depend_(Dep_{Dep_::File, Count, file_index_(entity->file_)});
+  return entity;
+}
+
+auto QueryEngine::depend_(const Dep_ dep) -> void {
+  if(!frames_.empty() && frames_.back() != nullptr) {
+    frames_.back()->emplace_back(dep);
+  }
+}
+
+auto QueryEngine::verify_(const std::vector<Dep_>& deps, const uint64_t verified_at) -> bool {
+  frames_.push_back(nullptr);
+  bool unchanged = true;
+  for(const Dep_& dep : deps) {
+    uint64_t changed_at = 0;
+    switch(dep.what_) {
+    case Dep_::File:
+      changed_at = file_changed_[dep.index_];
+      break;
+    case Dep_::Scope:
+      if(const auto it = scope_changed_.find(dep.index_); it != scope_changed_.end()) changed_at = it->second;
+      break;
+    case Dep_::Query:
+      changed_at = refresh_(dep);
+      break;
+    default: UNREACHABLE_ASSERTION;
+    }
+
+    if(changed_at > verified_at) {
+      unchanged = false;
+      break;
+    }
+  }
+
+  frames_.pop_back();
+  return unchanged;
+}
+
+auto QueryEngine::refresh_(const Dep_ dep) -> uint64_t {
+  /// Brings the query up to date, and says when its
+  /// value last changed. A query that now fails has.
+  constexpr uint64_t failed = std::numeric_limits<uint64_t>::max();
+  switch(dep.kind_) {
+  case TypeOf: {
+    const auto& memo = type_of_.memos_[dep.index_];
+    return type_of(memo.key_).has_value() ? memo.changed_at_ : failed;
+  }
+  case MembersOf: {
+    const auto& memo = members_of_.memos_[dep.index_];
+    return members_of(memo.key_).has_value() ? memo.changed_at_ : failed;
+  }
+  case Resolve: {
+    const auto& memo = resolve_.memos_[dep.index_];
+    return resolve(memo.key_.scope_, memo.key_.name_).has_value() ? memo.changed_at_ : failed;
+  }
+  default: UNREACHABLE_ASSERTION;
+  }
+}
+
+auto QueryEngine::file_index_(const sys::String& file) -> uint32_t {
+  const auto [it, added] = files_.try_emplace(file, static_cast<uint32_t>(file_changed_.size()));
+  if(added) file_changed_.emplace_back(0);
+  return it->second;
+}
+
+auto QueryEngine::dump_stats(OStream& stream) const -> void {
+  stream
+    << Con::Bold
+    << "---- Queries\n"
+    << Con::Reset
+    << fmt("  {:<16}{:>10}{:>11}{:>10}{:>10}{:>8}\n", "Query", "hits", "validated", "computed", "cutoffs", "%hit");
+
+  for(size_t i = 0; i < Count; i++) {
+    const auto& counts = counts_[i];
+    const uint64_t reused = counts.hits_ + counts.validated_;
+    const uint64_t total  = reused + counts.computed_;
+    stream << fmt("  {:<16}{:>10}{:>11}{:>10}{:>10}{:>8.1f}\n",
+      query_names_[i],
+      counts.hits_,
+      counts.validated_,
+      counts.computed_,
+      counts.cutoffs_,
+      total ? 100.0 * reused / total : 0.0);
+  }
+
+  stream << fmt("  {:<16}{:>10}\n", "Revision", revision_);
+}
+
+END_NAMESPACE(n19);
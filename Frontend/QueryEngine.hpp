@@ -0,0 +1,232 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_QUERYENGINE_HPP
+#define N19_QUERYENGINE_HPP
+#include <Frontend/Entity.hpp>
+#include <Frontend/TypeTable.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Result.hpp>
+#include <IO/Stream.hpp>
+#include <unordered_map>
+#include <string_view>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+
+#define N19_QUERY_LIST                     \
+  X(TypeOf,    "type_of")                  \
+  X(MembersOf, "members_of")               \
+  X(Resolve,   "resolve")                  \
+
+BEGIN_NAMESPACE(n19);
+class EntityTable;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Demand-driven, memoized queries over an EntityTable. Each query
+// records what it read while computing: the files owning the entities
+// it looked at, the scopes whose children it searched, and the other
+// queries it asked. Those are its dependencies.
+//
+// When files change, touch() them and bump the revision. Nothing is
+// recomputed until it's asked for again: a memo is then checked
+// against its dependencies, and only recomputed if one of them changed
+// since it was last verified. If a recomputed query comes out equal
+// to its old value, queries depending on it are left alone (early
+// cutoff), so editing a function body doesn't redo resolution of
+// every name that merely passes through its file's scope.
+//
+// Errors (cycles, missing entities) are never memoized.
+// The engine is not thread safe.
+
+class QueryEngine {
+  N19_MAKE_NONCOPYABLE(QueryEngine);
+  N19_MAKE_NONMOVABLE(QueryEngine);
+public:
+  enum Kind : uint8_t {
+  #define X(NAME, UNUSED) NAME,
+    N19_QUERY_LIST
+  #undef X
+    Count
+  };
+
+  struct Member {
+    std::string name_;
+    TypeTable::ID type_ = TypeTable::invalid_;
+    auto operator==(const Member&) const -> bool = default;
+  };
+
+  struct Counts {
+    uint64_t hits_      = 0;   /// Verified in the current revision already.
+    uint64_t validated_ = 0;   /// Older, but none of its dependencies changed.
+    uint64_t computed_  = 0;   /// Computed from scratch.
+    uint64_t cutoffs_   = 0;   /// Recomputed, and came out the same.
+  };
+
+  ///
+  /// The type of a variable, alias, or type, interned into
+  /// the TypeTable. For procedures, the return type,
+  /// TypeTable::invalid_ meaning void.
+  auto type_of(Entity::ID decl) -> Result<TypeTable::ID>;
+
+  /// Every member of a struct, in declaration order.
+  auto members_of(Entity::ID type) -> Result<std::vector<Member>>;
+
+  ///
+  /// What an unqualified name refers to from within scope,
+  /// searching outwards to the root. N19_INVALID_ENTITY_ID
+  /// if nothing by that name is visible. Links aren't followed.
+  auto resolve(Entity::ID scope, std::string_view name) -> Result<Entity::ID>;
+
+  ///
+  /// Tell the engine a file changed. Call it after the table has
+  /// been updated, i.e. after remove_file() and re-inserting the
+  /// file's entities, so the scopes it now declares in are known.
+  /// Struct layouts computed from the file are redone too.
+  auto touch(const sys::String& file) -> void;
+
+  auto counts(Kind kind) const -> const Counts&;
+  auto dump_stats(OStream& stream) const -> void;
+
+  NODISCARD_ auto revision() const -> uint64_t;
+
+ ~QueryEngine() = default;
+  QueryEngine(const EntityTable& entities, TypeTable& types);
+private:
+  struct Dep_ {
+    enum What : uint8_t { File, Scope, Query } what_ = File;
+    Kind kind_ = Count;
+    uint32_t index_ = 0;      /// File index, scope ID, or memo index.
+    auto operator<=>(const Dep_&) const = default;
+  };
+
+  struct ResolveKey_ {
+    Entity::ID scope_ = N19_INVALID_ENTITY_ID;
+    std::string name_;
+    auto operator==(const ResolveKey_&) const -> bool = default;
+  };
+
+  struct ResolveHash_ {
+    auto operator()(const ResolveKey_& key) const -> size_t;
+  };
+
+  template<typename K, typename V, typename H = std::hash<K>>
+  struct Table_ {
+    using Key   = K;
+    using Value = V;
+
+    struct Memo {
+      K key_;
+      V value_{};
+      uint64_t verified_at_ = 0;
+      uint64_t changed_at_  = 0;
+      std::vector<Dep_> deps_;
+      bool valid_  = false;
+      bool active_ = false;   /// Being computed or verified: asking again is a cycle.
+    };
+
+    std::unordered_map<K, uint32_t, H> index_;
+    std::deque<Memo> memos_;  /// Doesn't move memos while queries recurse.
+  };
+
+  template<typename T, typename F>
+  auto fetch_(T& table, Kind kind, const typename T::Key& key, F&& compute) -> Result<typename T::Value>;
+
+  auto compute_type_of_(Entity::ID decl) -> Result<TypeTable::ID>;
+  auto compute_members_of_(Entity::ID type) -> Result<std::vector<Member>>;
+  auto compute_resolve_(const ResolveKey_& key) -> Result<Entity::ID>;
+
+  auto intern_(Entity::ID base, const EntityQualifierBase& quals) -> Result<TypeTable::ID>;
+  auto read_(Entity::ID id) -> Entity::Ptr<>;
+  auto depend_(Dep_ dep) -> void;
+  auto verify_(const std::vector<Dep_>& deps, uint64_t verified_at) -> bool;
+  auto refresh_(Dep_ dep) -> uint64_t;
+  auto file_index_(const sys::String& file) -> uint32_t;
+
+  const EntityTable& entities_;
+  TypeTable& types_;
+  uint64_t revision_ = 1;
+
+  Table_<Entity::ID, TypeTable::ID> type_of_;
+  Table_<Entity::ID, std::vector<Member>> members_of_;
+  Table_<ResolveKey_, Entity::ID, ResolveHash_> resolve_;
+
+  std::unordered_map<sys::String, uint32_t> files_;
+  std::vector<uint64_t> file_changed_;                     /// Revision each file last changed in.
+  std::unordered_map<Entity::ID, uint64_t> scope_changed_; /// Same, for a scope's children.
+
+  /// Dependencies of each query being computed, innermost last.
+  /// Null while verifying, where nothing new is being learned.
+  std::vector<std::vector<Dep_>*> frames_;
+  std::array<Counts, Count> counts_{};
+};
+
+template<typename T, typename F>
+auto QueryEngine::fetch_(T& table, const Kind kind, const typename T::Key& key, F&& compute)
+-> Result<typename T::Value> {
+  auto& counts = counts_[kind];
+  const auto [it, added] = table.index_.try_emplace(key, static_cast<uint32_t>(table.memos_.size()));
+  const uint32_t index = it->second;
+  if(added) table.memos_.emplace_back().key_ = key;
+
+  auto& memo = table.memos_[index];
+  if(memo.active_) {
+    return Error{ErrC::InvalidArg, "Cycle detected while evaluating a query."};
+  }
+
+  depend_(Dep_{Dep_::Query, kind, index});
+  if(memo.valid_ && memo.verified_at_ == revision_) {
+    ++counts.hits_;
+    return memo.value_;
+  }
+
+  memo.active_ = true;
+  if(memo.valid_ && verify_(memo.deps_, memo.verified_at_)) {
+    memo.active_ = false;
+    memo.verified_at_ = revision_;
+    ++counts.validated_;
+    return memo.value_;
+  }
+
+  std::vector<Dep_> deps;
+  frames_.push_back(&deps);
+  auto result = compute(key);
+  frames_.pop_back();
+  memo.active_ = false;
+  ++counts.computed_;
+
+  if(!result.has_value()) {
+    memo.valid_ = false;
+    return result;
+  }
+
+  if(memo.valid_ && memo.value_ == result.value()) ++counts.cutoffs_;
+  else memo.changed_at_ = revision_;
+
+  std::ranges::sort(deps);
+  const auto [first, last] = std::ranges::unique(deps);
+  deps.erase(first, last);
+
+  memo.value_       = result.value();
+  memo.deps_        = std::move(deps);
+  memo.verified_at_ = revision_;
+  memo.valid_       = true;
+  return result;
+}
+
+FORCEINLINE_ auto QueryEngine::counts(const Kind kind) const -> const Counts& {
+  return counts_.at(kind);
+}
+
+FORCEINLINE_ auto QueryEngine::revision() const -> uint64_t {
+  return revision_;
+}
+
+END_NAMESPACE(n19);
+#endif //N19_QUERYENGINE_HPP
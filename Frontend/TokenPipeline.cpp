@@ -0,0 +1,126 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/TokenPipeline.hpp>
+#include <Frontend/Lexer.hpp>
+#include <algorithm>
+#include <iterator>
+BEGIN_NAMESPACE(n19);
+
+TokenPipeline::TokenPipeline(Lexer& lxr) : lxr_(lxr) {
+  queue_ = std::make_unique<RingQueue<Batch, queue_size_>>();
+  window_.reserve(retain_ * 2 + batch_size_);
+  thread_ = std::thread([this] { produce_(); });
+}
+
+TokenPipeline::~TokenPipeline() {
+  stop();
+}
+
+auto TokenPipeline::produce_() -> void {
+  ///
+  /// Stops after an EOF like Lexer::consume() does, and after an
+  /// illegal token because the lexer may not move past one. If the
+  /// parser wants more than that it continues on its own.
+  Batch batch;
+  while(!batch.last_) {
+    batch.count_ = 0;
+    while(batch.count_ < batch_size_) {
+      const Token tok = lxr_.produce_impl_();
+      batch.toks_[batch.count_++] = tok;
+      if(tok == TokenType::EndOfFile || tok == TokenType::Illegal) {
+        batch.last_ = true;
+        break;
+      }
+    }
+
+    if(stop_.load(std::memory_order::relaxed)) batch.last_ = true;
+    queue_->enqueue(batch);
+  }
+}
+
+auto TokenPipeline::receive_() -> void {
+  /// Tokens are dropped a few thousand at a time, so
+  /// moving the ones that stay is cheap on average.
+  if(next_ - base_ > retain_ * 2) {
+    const size_t drop = next_ - base_ - retain_;
+    window_.erase(window_.begin(), window_.begin() + static_cast<ptrdiff_t>(drop));
+    base_ += drop;
+  }
+
+  const Batch batch = queue_->dequeue();
+  window_.insert(window_.end(), batch.toks_.begin(), batch.toks_.begin() + batch.count_);
+  ended_ = batch.last_;
+}
+
+auto TokenPipeline::at_(const size_t seq) -> const Token* {
+  while(seq >= base_ + window_.size()) {
+    if(ended_) return nullptr;
+    receive_();
+  }
+
+  return seq < base_ ? nullptr : &window_[seq - base_];
+}
+
+auto TokenPipeline::next() -> const Token* {
+  const Token* tok = at_(next_);
+  if(tok != nullptr) ++next_;
+  return tok;
+}
+
+auto TokenPipeline::peek(const size_t amnt) -> const Token* {
+  ASSERT(amnt > 0);
+  for(size_t seq = next_;; seq++) {
+    const Token* tok = at_(seq);
+    if(tok == nullptr || seq == next_ + amnt - 1 || *tok == TokenType::EndOfFile) {
+      return tok;
+    }
+  }
+}
+
+auto TokenPipeline::rewind(const Token& tok) -> bool {
+  const auto first = std::ranges::lower_bound(window_, tok.pos_, {}, &Token::pos_);
+  for(auto it = first; it != window_.end() && it->pos_ == tok.pos_; ++it) {
+    if(*it == tok && it->line_ == tok.line_) {
+      next_ = base_ + static_cast<size_t>(it - window_.begin());
+      return true;
+    }
+  }
+
+  return false;
+}
+
+auto TokenPipeline::seek(const uint32_t pos, const uint32_t line) -> const Token* {
+  ///
+  /// pos may point at whitespace in front of a token. The first
+  /// token at or after it is the one the lexer would produce from
+  /// there, provided the token before it doesn't run past pos.
+  const auto it = std::ranges::lower_bound(window_, pos, {}, &Token::pos_);
+  if(it == window_.begin() || it == window_.end() || it->line_ != line) {
+    return nullptr;
+  }
+
+  const auto prev = std::prev(it);
+  if(prev->pos_ + prev->len_ > pos) {
+    return nullptr;
+  }
+
+  next_ = base_ + static_cast<size_t>(it - window_.begin()) + 1;
+  return &*it;
+}
+
+auto TokenPipeline::stop() -> const Token* {
+  if(thread_.joinable()) {
+    /// The lexer thread may be waiting for room in
+    /// the queue, keep taking batches until its last.
+    stop_.store(true, std::memory_order::relaxed);
+    while(!ended_) receive_();
+    thread_.join();
+  }
+
+  return at_(next_);
+}
+
+END_NAMESPACE(n19);
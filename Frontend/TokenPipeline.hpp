@@ -0,0 +1,75 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_TOKENPIPELINE_HPP
+#define N19_TOKENPIPELINE_HPP
+#include <Core/ClassTraits.hpp>
+#include <Core/RingQueue.hpp>
+#include <Frontend/Token.hpp>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+class Lexer;
+
+///
+/// Lexes a file on a thread of its own, a batch of tokens at a
+/// time, while the parser consumes them on another. The lexer
+/// thread gets at most queue_size_ batches ahead before it has to
+/// wait, and the parser keeps the last retain_ tokens it went past
+/// so that it can still back up a little.
+///
+/// While a pipeline runs, the lexer's index_ and line_ belong to
+/// the lexer thread. Anything that can't be served from the
+/// retained tokens goes through Lexer::stop_pipeline() first,
+/// which hands them back.
+class TokenPipeline {
+  N19_MAKE_NONCOPYABLE(TokenPipeline);
+  N19_MAKE_NONMOVABLE(TokenPipeline);
+public:
+  static constexpr size_t batch_size_ = 256;
+  static constexpr size_t queue_size_ = 32;    /// Batches in flight, a power of 2.
+  static constexpr size_t retain_     = 4096;  /// Tokens kept behind the parser.
+
+  /// These return null when the token isn't there to be had:
+  /// the lexer thread stopped short of it (on an illegal token),
+  /// or it fell out of the retained window.
+  auto next() -> const Token*;
+  auto peek(size_t amnt) -> const Token*;
+  auto seek(uint32_t pos, uint32_t line) -> const Token*;
+  auto rewind(const Token& tok) -> bool;
+
+  /// Joins the lexer thread. Returns the token
+  /// next() would have handed out, if it has one.
+  auto stop() -> const Token*;
+
+  explicit TokenPipeline(Lexer& lxr);
+ ~TokenPipeline();
+private:
+  struct Batch {
+    std::array<Token, batch_size_> toks_{};
+    uint32_t count_ = 0;
+    bool last_      = false;  /// Nothing comes after this one.
+  };
+
+  auto produce_() -> void;
+  auto receive_() -> void;
+  auto at_(size_t seq) -> const Token*;
+
+  Lexer& lxr_;
+  std::unique_ptr<RingQueue<Batch, queue_size_>> queue_;
+  std::vector<Token> window_;
+  size_t base_  = 0;      /// Sequence number of window_[0].
+  size_t next_  = 0;      /// Sequence number of what next() returns.
+  bool   ended_ = false;  /// The last batch has been received.
+  std::atomic<bool> stop_ = false;
+  std::thread thread_;
+};
+
+END_NAMESPACE(n19);
+#endif //N19_TOKENPIPELINE_HPP
@@ -0,0 +1,247 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Frontend/TypeTable.hpp>
+#include <Frontend/EntityTable.hpp>
+#include <Core/Murmur3.hpp>
+#include <algorithm>
+#include <utility>
+BEGIN_NAMESPACE(n19);
+
+/// Structs containing themselves by value, or absurdly
+/// deep nesting, stop here and are left incomplete.
+static constexpr uint32_t max_layout_depth_ = 64;
+
+static auto hash_mix_(const uint64_t hash, const uint64_t value) -> uint64_t {
+  return murmur3_fmix64(hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+}
+
+static auto builtin_size_(const Entity::ID id) -> uint32_t {
+  switch(id) {
+  case BuiltinType::I8:   FALLTHROUGH_;
+  case BuiltinType::U8:   FALLTHROUGH_;
+  case BuiltinType::Bool: return 1;
+  case BuiltinType::I16:  FALLTHROUGH_;
+  case BuiltinType::U16:  return 2;
+  case BuiltinType::I32:  FALLTHROUGH_;
+  case BuiltinType::U32:  FALLTHROUGH_;
+  case BuiltinType::F32:  return 4;
+  case BuiltinType::I64:  FALLTHROUGH_;
+  case BuiltinType::U64:  FALLTHROUGH_;
+  case BuiltinType::F64:  return 8;
+  case BuiltinType::Ptr:  return TypeTable::pointer_size_;
+  default:                return 0;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto TypeTable::hash_(const Descriptor& desc) -> uint64_t {
+  uint64_t hash = murmur3_fmix64(desc.base_);
+  hash = hash_mix_(hash, desc.ptr_depth_);
+  hash = hash_mix_(hash, desc.flags_);
+  hash = hash_mix_(hash, desc.arr_lengths_.size());
+  for(const uint32_t length : desc.arr_lengths_) {
+    hash = hash_mix_(hash, length);
+  }
+
+  return hash;
+}
+
+auto TypeTable::find_(const Shard_& shard, const Descriptor& desc, const uint64_t hash) const -> ID {
+  const auto [begin, end] = shard.ids_.equal_range(hash);
+  for(auto it = begin; it != end; ++it) {
+    const Descriptor& other = get(it->second);
+    if(other.base_ == desc.base_
+      && other.ptr_depth_ == desc.ptr_depth_
+      && other.flags_ == desc.flags_
+      && other.arr_lengths_ == desc.arr_lengths_) {
+      return it->second;
+    }
+  }
+
+  return invalid_;
+}
+
+///
+/// Replaces a link or alias base with whatever it ends up
+/// naming, folding any alias' own qualifiers in. Use-site array
+/// lengths come first: given "type A = i32[4]", "A[2]"
+/// has lengths {2, 4}. Every link followed goes in reads_.
+auto TypeTable::canonicalize_(Descriptor& desc) -> void {
+  if(entities_ == nullptr || desc.base_ == N19_INVALID_ENTITY_ID) return;
+  for(size_t hops = 0; hops < max_layout_depth_; hops++) {
+    const auto link = Entity::try_cast<SymLink>(entities_->find_direct(desc.base_));
+    if(!link || link->link_ == N19_INVALID_ENTITY_ID) return;
+    desc.reads_.emplace_back(file_index_(link->file_));
+
+    desc.base_ = link->link_;
+    const auto alias = Entity::try_cast<AliasType>(link);
+    if(!alias) continue;
+
+    desc.ptr_depth_ += alias->quals_.ptr_depth_;
+    desc.flags_     |= alias->quals_.flags_;
+    desc.arr_lengths_.insert(
+      desc.arr_lengths_.end(),
+      alias->quals_.arr_lengths_.begin(),
+      alias->quals_.arr_lengths_.end());
+  }
+}
+
+auto TypeTable::compute_(Descriptor& desc, const uint32_t depth) -> void {
+  desc.is_pointer_ = desc.ptr_depth_ > 0;
+
+  uint64_t size  = 0;
+  uint32_t align = 0;
+  if(desc.is_pointer_ || (desc.flags_ & EntityQualifierBase::Reference)) {
+    size  = pointer_size_;
+    align = pointer_size_;
+  } else if(const uint32_t builtin = builtin_size_(desc.base_); builtin != 0) {
+    size  = builtin;
+    align = builtin;
+  } else if(entities_ != nullptr && depth < max_layout_depth_) {
+    const auto entity    = entities_->find_direct(desc.base_);
+    const auto structure = Entity::try_cast<Struct>(entity);
+    desc.reads_.emplace_back(entity != nullptr ? file_index_(entity->file_) : missing_);
+    if(structure) {
+      align = 1;
+      for(const auto& member : structure->members_) {
+        Descriptor field;
+        field.base_        = member.type_id_;
+        field.ptr_depth_   = member.quals_.ptr_depth_;
+        field.flags_       = member.quals_.flags_;
+        field.arr_lengths_ = member.quals_.arr_lengths_;
+
+        const Descriptor& layout = get(intern_(std::move(field), depth + 1, &desc.reads_));
+        if(layout.size_ == 0) {
+          size = 0;
+          break;
+        }
+
+        size  = (size + layout.align_ - 1) / layout.align_ * layout.align_;
+        size += layout.size_;
+        align = std::max(align, layout.align_);
+      }
+
+      if(size != 0) size = (size + align - 1) / align * align;
+    }
+  }
+
+  for(const uint32_t length : desc.arr_lengths_) {
+    size *= length;
+  }
+
+  desc.size_  = size;
+  desc.align_ = size != 0 ? align : 0;
+
+  std::ranges::sort(desc.reads_);
+  const auto [first, last] = std::ranges::unique(desc.reads_);
+  desc.reads_.erase(first, last);
+}
+
+auto TypeTable::slot_(const ID id) -> Descriptor& {
+  const size_t index = id >> chunk_bits_;
+  if(index >= max_chunks_) PANIC("TypeTable: too many distinct types.");
+
+  Descriptor* chunk = chunks_[index].load(std::memory_order_acquire);
+  if(chunk == nullptr) {
+    auto* fresh = new Descriptor[chunk_size_];
+    if(chunks_[index].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+      chunk = fresh;
+    } else {
+      delete[] fresh;
+    }
+  }
+
+  return chunk[id & (chunk_size_ - 1)];
+}
+
+///
+/// reads, if given, gets what the type was read from: the links
+/// canonicalizing it followed, and its layout's reads_. A struct
+/// passes its own, so it's dropped along with any of its members.
+auto TypeTable::intern_(Descriptor desc, const uint32_t depth, std::vector<uint32_t>* reads) -> ID {
+  canonicalize_(desc);
+  const uint64_t hash = hash_(desc);
+  Shard_& shard = shards_[hash % shard_count_];
+
+  const auto links = desc.reads_;
+  const auto done  = [&](const ID id) {
+    if(reads != nullptr) {
+      reads->insert(reads->end(), links.begin(), links.end());
+      reads->insert(reads->end(), get(id).reads_.begin(), get(id).reads_.end());
+    }
+    return id;
+  };
+
+  {
+    std::lock_guard guard(shard.lock_);
+    if(const ID found = find_(shard, desc, hash); found != invalid_) {
+      return done(found);
+    }
+  }
+
+  /// Struct layout interns the member types, which can
+  /// land in this same shard: do it without the lock held,
+  /// and check again before publishing.
+  compute_(desc, depth);
+
+  std::lock_guard guard(shard.lock_);
+  if(const ID found = find_(shard, desc, hash); found != invalid_) {
+    return done(found);
+  }
+
+  const ID id = next_.fetch_add(1, std::memory_order_acq_rel);
+  slot_(id) = std::move(desc);
+  shard.ids_.emplace(hash, id);
+  return done(id);
+}
+
+auto TypeTable::file_index_(const sys::String& file) -> uint32_t {
+  std::lock_guard guard(files_lock_);
+  const auto [it, added] = files_.try_emplace(file, static_cast<uint32_t>(files_.size() + 1));
+  return it->second;
+}
+
+auto TypeTable::invalidate(const sys::String& file) -> std::vector<ID> {
+  uint32_t index = missing_;
+  {
+    std::lock_guard guard(files_lock_);
+    if(const auto it = files_.find(file); it != files_.end()) index = it->second;
+  }
+
+  std::vector<ID> dropped;
+  for(Shard_& shard : shards_) {
+    std::lock_guard guard(shard.lock_);
+    std::erase_if(shard.ids_, [&](const auto& entry) {
+      const auto& reads = get(entry.second).reads_;
+      const bool stale = std::ranges::binary_search(reads, missing_)
+        || (index != missing_ && std::ranges::binary_search(reads, index));
+      if(stale) dropped.emplace_back(entry.second);
+      return stale;
+    });
+  }
+
+  return dropped;
+}
+
+auto TypeTable::intern(const Entity::ID base, const EntityQualifierBase& quals) -> ID {
+  Descriptor desc;
+  desc.base_        = base;
+  desc.ptr_depth_   = quals.ptr_depth_;
+  desc.flags_       = quals.flags_;
+  desc.arr_lengths_ = quals.arr_lengths_;
+  return intern_(std::move(desc), 0);
+}
+
+TypeTable::TypeTable(const EntityTable* entities) : entities_(entities) {}
+
+TypeTable::~TypeTable() {
+  for(auto& chunk : chunks_) {
+    delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+END_NAMESPACE(n19);
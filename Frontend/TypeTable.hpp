@@ -0,0 +1,124 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_TYPETABLE_HPP
+#define N19_TYPETABLE_HPP
+#include <Frontend/Entity.hpp>
+#include <Core/ClassTraits.hpp>
+#include <Core/Panic.hpp>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+BEGIN_NAMESPACE(n19);
+class EntityTable;
+
+///
+/// Interns (base entity, flags, pointer depth, array lengths)
+/// into a 32-bit TypeTable::ID, so two qualified types are the
+/// same type exactly when their IDs are equal. Aliases are
+/// resolved when interning: an alias of "i32*" and "i32*"
+/// itself get the same ID.
+///
+/// Interning takes one of a few sharded locks. get() takes
+/// none: descriptors live in chunks that never move once
+/// allocated, and are never modified after being published.
+///
+/// A struct's layout is only as current as the entities it
+/// was computed from. When their file changes, invalidate() it:
+/// the types laid out from it are dropped, and interning them
+/// again publishes fresh descriptors under new IDs.
+class TypeTable {
+  N19_MAKE_NONCOPYABLE(TypeTable);
+  N19_MAKE_NONMOVABLE(TypeTable);
+public:
+  using ID = uint32_t;
+  static constexpr ID invalid_ = 0;
+  static constexpr uint32_t pointer_size_ = 8;
+
+  struct Descriptor {
+    Entity::ID base_ = N19_INVALID_ENTITY_ID;
+    uint32_t ptr_depth_ = 0;
+    uint8_t flags_ = 0;
+    std::vector<uint32_t> arr_lengths_;
+
+    /// Computed once, when the type is first interned.
+    /// A size of 0 means the type is incomplete or unknown
+    /// (a placeholder, or a struct containing one).
+    uint64_t size_  = 0;
+    uint32_t align_ = 0;
+    bool is_pointer_ = false;
+
+    /// Files of the entities the layout was read from, sorted.
+    /// missing_ if it needed one that didn't exist (yet).
+    std::vector<uint32_t> reads_;
+  };
+
+  auto intern(Entity::ID base, const EntityQualifierBase& quals) -> ID;
+  auto intern(const EntityQualifier& qual) -> ID;
+  auto get(ID id) const -> const Descriptor&;
+  auto size() const -> size_t;
+
+  ///
+  /// Drops every type laid out from an entity in the file, or
+  /// from one that was missing, and returns their IDs. Those
+  /// stay readable through get(), but aren't interned anymore.
+  /// Not to be called while other threads are interning.
+  auto invalidate(const sys::String& file) -> std::vector<ID>;
+
+  /// The table is used to resolve aliases and lay out
+  /// structs. Without one, only builtins and pointers
+  /// get a size.
+  explicit TypeTable(const EntityTable* entities = nullptr);
+ ~TypeTable();
+private:
+  static constexpr size_t chunk_bits_ = 12;
+  static constexpr size_t chunk_size_ = size_t{1} << chunk_bits_;
+  static constexpr size_t max_chunks_ = 4096;
+  static constexpr size_t shard_count_ = 16;
+  static constexpr uint32_t missing_ = 0;
+
+  struct Shard_ {
+    std::mutex lock_;
+    std::unordered_multimap<uint64_t, ID> ids_;
+  };
+
+  auto canonicalize_(Descriptor& desc) -> void;
+  auto compute_(Descriptor& desc, uint32_t depth) -> void;
+  auto find_(const Shard_& shard, const Descriptor& desc, uint64_t hash) const -> ID;
+  auto intern_(Descriptor desc, uint32_t depth, std::vector<uint32_t>* reads = nullptr) -> ID;
+  auto slot_(ID id) -> Descriptor&;
+  auto file_index_(const sys::String& file) -> uint32_t;
+
+  static auto hash_(const Descriptor& desc) -> uint64_t;
+
+  const EntityTable* entities_ = nullptr;
+  std::array<std::atomic<Descriptor*>, max_chunks_> chunks_{};
+  std::array<Shard_, shard_count_> shards_;
+  std::atomic<ID> next_{invalid_ + 1};
+
+  std::mutex files_lock_;
+  std::unordered_map<sys::String, uint32_t> files_;
+};
+
+inline auto TypeTable::intern(const EntityQualifier& qual) -> ID {
+  return intern(qual.id_, qual);
+}
+
+inline auto TypeTable::get(const ID id) const -> const Descriptor& {
+  ASSERT(id != invalid_ && id < next_.load(std::memory_order_acquire));
+  const Descriptor* chunk = chunks_[id >> chunk_bits_].load(std::memory_order_acquire);
+  ASSERT(chunk != nullptr);
+  return chunk[id & (chunk_size_ - 1)];
+}
+
+inline auto TypeTable::size() const -> size_t {
+  return next_.load(std::memory_order_acquire) - 1;
+}
+
+END_NAMESPACE(n19);
+#endif //N19_TYPETABLE_HPP
@@ -270,6 +270,25 @@ public:
   NullOStream() = default;
 };
 
+///
+/// Collects everything written to it in str_. Used where output
+/// has to be held back, e.g. to keep concurrent jobs from
+/// interleaving on the console.
+class StringOStream final : public OStream {
+public:
+  auto write(const Span_& buff) -> OStream& override {
+    str_.append(reinterpret_cast<const char*>(buff.data()), buff.size_bytes());
+    return *this;
+  }
+
+  auto flush() -> OStream& override { return *this; }
+
+ ~StringOStream() override = default;
+  StringOStream() = default;
+
+  std::string str_;
+};
+
 class IStream {
 public:
   static auto from_stdin() -> IStream;
@@ -0,0 +1,87 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Core/ArgParse.hpp>
+#include <IO/Console.hpp>
+#include <Bench/Bench.hpp>
+#include <cstdlib>
+#include <chrono>
+using namespace n19;
+
+struct BenchArgParser : argp::Parser {
+  argp::PackType& groups = arg<argp::PackType>(
+    _nstr("--run"),
+    _nstr("-run"),
+    _nstr("Run only these benchmark groups (optional)"));
+
+  int64_t& min_time = arg<int64_t>(
+    _nstr("--min-time"),
+    _nstr("-min-time"),
+    _nstr("Minimum time per measured batch, in milliseconds."), 200);
+
+  bool& show_help = arg<bool>(
+    _nstr("--help"),
+    _nstr("-h"),
+    _nstr("print this help message and exit."));
+};
+
+static auto run(BenchArgParser& parser) -> int {
+  auto stream = OStream::from_stdout();
+  if(parser.show_help) {
+    parser.help(stream);
+    return EXIT_SUCCESS;
+  }
+
+  if(parser.min_time <= 0) {
+    errs() << "--min-time must be positive." << Endl;
+    return EXIT_FAILURE;
+  }
+
+  bench::run_all(outs(), parser.groups, std::chrono::milliseconds(parser.min_time));
+  outs().flush();
+  return EXIT_SUCCESS;
+}
+
+#ifdef N19_WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <windows.h>
+
+int main() {
+  win32_init_console();
+
+  BenchArgParser parser;
+  int arg_count = 0;
+  LPWSTR* args = ::CommandLineToArgvW(::GetCommandLineW(), &arg_count);
+  if(args == nullptr) {
+    outs() << "Could not retrieve win32 argv. Error code=" << ::GetLastError() << Endl;
+    return EXIT_FAILURE;
+  }
+
+  auto stream = OStream::from_stdout();
+  if(arg_count > 1 && !parser.take_argv(arg_count, args).parse(stream)) {
+    ::LocalFree(args);
+    return EXIT_FAILURE;
+  }
+
+  ::LocalFree(args);
+  return run(parser);
+}
+
+#else //POSIX
+
+int main(int argc, char** argv) {
+  BenchArgParser parser;
+  auto stream = OStream::from_stdout();
+  if(argc > 1 && argv && !parser.take_argv(argc, argv).parse(stream)) {
+    return EXIT_FAILURE;
+  }
+
+  return run(parser);
+}
+
+#endif
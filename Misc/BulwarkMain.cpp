@@ -48,8 +48,53 @@ struct BulwarkArgParser : argp::Parser {
     _nstr("--run"),
     _nstr("-run"),
     _nstr("Run only these test suites (optional)"));
+
+  int64_t& report_slowest = arg<int64_t>(
+    _nstr("--report-slowest"),
+    _nstr("-slowest"),
+    _nstr("List the N slowest test cases after the summary (optional)"));
+
+  int64_t& timeout = arg<int64_t>(
+    _nstr("--timeout"),
+    _nstr("-timeout"),
+    _nstr("Per-case timeout in milliseconds, cases exceeding it fail (optional)"));
+
+  sys::String& junit = arg<sys::String>(
+    _nstr("--junit"),
+    _nstr("-junit"),
+    _nstr("Stream a JUnit XML report to this file (optional)"));
+
+  sys::String& json = arg<sys::String>(
+    _nstr("--json"),
+    _nstr("-json"),
+    _nstr("Stream a JSON report to this file (optional)"));
 };
 
+static auto setup_reports(BulwarkArgParser& parser, test::Context& ctx) -> bool {
+  if(parser.report_slowest < 0 || parser.timeout < 0) {
+    errs() << "--report-slowest and --timeout cannot be negative." << Endl;
+    return false;
+  }
+
+  ctx.report_slowest_ = static_cast<size_t>(parser.report_slowest);
+  ctx.timeout_ = std::chrono::milliseconds{ parser.timeout };
+
+  const auto add_writer = [&](const sys::String& path, auto&& create) -> bool {
+    if(path.empty()) return true;
+    auto writer = create(path);
+    if(!writer.has_value()) {
+      errs() << "Could not open report file: " << writer.error().msg << Endl;
+      return false;
+    }
+
+    ctx.writers_.emplace_back(writer.release_value());
+    return true;
+  };
+
+  return add_writer(parser.junit, test::JUnitWriter::create)
+    && add_writer(parser.json, test::JsonWriter::create);
+}
+
 #ifdef N19_WIN32
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -103,6 +148,8 @@ int main() {
     ctx.suites_to_skip_ = std::move(parser.to_skip);
   } if (!parser.to_run.empty()) {
     ctx.suites_to_run_ = std::move(parser.to_run);
+  } if (!setup_reports(parser, ctx)) {
+    return EXIT_FAILURE;
   }
 
   test::g_registry.run_all();
@@ -143,6 +190,8 @@ int main(int argc, char** argv) {
     ctx.suites_to_skip_ = std::move(parser.to_skip);
   } if(!parser.to_run.empty()) {
     ctx.suites_to_run_  = std::move(parser.to_run);
+  } if(!setup_reports(parser, ctx)) {
+    return EXIT_FAILURE;
   }
 
   test::g_registry.run_all();
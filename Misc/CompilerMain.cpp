@@ -17,9 +17,21 @@
 #include <Core/Try.hpp>
 #include <Core/StringUtil.hpp>
 #include <Core/Defer.hpp>
+#include <Core/FastExit.hpp>
+#include <Core/Stats.hpp>
+#include <Sys/DirWalk.hpp>
+#include <Sys/File.hpp>
 #include <iostream>
 
-#define ARGNUM_HARD_LIMIT 40
+/// Large projects should use --input-dir rather
+/// than hundreds of --input/--output pairs.
+#define ARGNUM_HARD_LIMIT 1024
+
+#ifdef N19_WIN32
+#define N19_DERIVED_OUTPUT_EXT _nstr(".obj")
+#else
+#define N19_DERIVED_OUTPUT_EXT _nstr(".o")
+#endif
 
 using namespace n19;
 
@@ -34,6 +46,21 @@ struct MainArgParser : argp::Parser {
     _nstr("-o"),
     _nstr("Output file(s)."));
 
+  argp::PackType& input_dirs = arg<argp::PackType>(
+    _nstr("--input-dir"),
+    _nstr("-input-dir"),
+    _nstr("Compile every matching file below these directories."));
+
+  argp::PackType& input_globs = arg<argp::PackType>(
+    _nstr("--input-glob"),
+    _nstr("-input-glob"),
+    _nstr("File name patterns taken from --input-dir (default: *.n19)."));
+
+  sys::String& output_dir = arg<sys::String>(
+    _nstr("--output-dir"),
+    _nstr("-output-dir"),
+    _nstr("Where outputs for --input-dir go (default: next to each input)."));
+
   bool& verbose = arg<bool>(
     _nstr("--verbose"),
     _nstr("-v"),
@@ -54,6 +81,56 @@ struct MainArgParser : argp::Parser {
     _nstr("-dump-ir"),
     _nstr("Dump the program's lowered IR."));
 
+  bool& emit_interface = arg<bool>(
+    _nstr("--emit-interface"),
+    _nstr("-emit-interface"),
+    _nstr("Write a precompiled module interface next to each input."));
+
+  bool& opt_remarks = arg<bool>(
+    _nstr("--opt-remarks"),
+    _nstr("-opt-remarks"),
+    _nstr("Report which calls were inlined, and why others weren't."));
+
+  int64_t& opt_level = arg<int64_t>(
+    _nstr("--opt-level"),
+    _nstr("-O"),
+    _nstr("Optimization level, 0 to 2 (default 0). Give it as -O 2 or --opt-level=2."), 0);
+
+  bool& time_passes = arg<bool>(
+    _nstr("--time-passes"),
+    _nstr("-time-passes"),
+    _nstr("Report the time spent in each optimization pass."));
+
+  bool& decls_only = arg<bool>(
+    _nstr("--decls-only"),
+    _nstr("-decls-only"),
+    _nstr("Only parse declarations, skipping procedure bodies."));
+
+  bool& no_pin = arg<bool>(
+    _nstr("--no-pin-threads"),
+    _nstr("-no-pin-threads"),
+    _nstr("Never pin parser or pass workers to CPUs."));
+
+  sys::String& schedule_stats = arg<sys::String>(
+    _nstr("--schedule-stats"),
+    _nstr("-schedule-stats"),
+    _nstr("Keep each input's compile time in this file, to schedule the slowest first next time."));
+
+  bool& stats = arg<bool>(
+    _nstr("--stats"),
+    _nstr("-stats"),
+    _nstr("Print compiler statistics counters after the build."));
+
+  sys::String& stats_json = arg<sys::String>(
+    _nstr("--stats-json"),
+    _nstr("-stats-json"),
+    _nstr("Also write the statistics counters to this file, as JSON."));
+
+  bool& fast_exit = arg<bool>(
+    _nstr("--fast-exit"),
+    _nstr("-fast-exit"),
+    _nstr("Exit without freeing compiler data structures."), true);
+
   bool& show_help = arg<bool>(
     _nstr("--help"),
     _nstr("-h"),
@@ -65,6 +142,73 @@ struct MainArgParser : argp::Parser {
     _nstr("Display the n19 compiler version and exit."));
 };
 
+///
+/// Prints --stats and writes --stats-json, whether or not
+/// the build succeeded: failed builds are worth explaining too.
+static auto report_stats(const MainArgParser& parser) -> void {
+  if (parser.stats) {
+    stats::print(outs());
+  }
+
+  if (parser.stats_json.empty()) {
+    return;
+  }
+
+  auto file = sys::File::create_trunc(parser.stats_json);
+  if (!file.has_value()) {
+    errs() << "Could not write statistics: " << file.error().msg << "\n";
+    return;
+  }
+
+  auto stream = BufferedOStream<>::from(*file);
+  stats::print_json(stream);
+  stream.flush();
+  file->close();
+}
+
+static auto finish(const int status) -> int {
+  if (FastExit::get().enabled_) {
+    FastExit::get().exit(status);
+  }
+
+  return status;
+}
+
+///
+/// Appends everything found under --input-dir to the inputs,
+/// each paired with an output at the same relative path below
+/// --output-dir. The files found below each directory are sorted
+/// together by path, and the directories are taken in command line
+/// order, so the order only depends on the command line and the
+/// file names.
+static auto discover_inputs(MainArgParser& parser) -> bool {
+  if (parser.input_globs.empty()) {
+    parser.input_globs.emplace_back(_nstr("*.n19"));
+  }
+
+  for (const auto& dir : parser.input_dirs) {
+    auto found = sys::walk_directory(dir, parser.input_globs);
+    if (!found.has_value()) {
+      outs()
+        << Con::RedFG
+        << "Error:"
+        << Con::Reset
+        << " Could not search input directory: "
+        << found.error().msg
+        << "\n";
+      return false;
+    }
+
+    for (auto& input : *found) {
+      parser.outputs.emplace_back(sys::derive_output_path(
+        input, dir, parser.output_dir, N19_DERIVED_OUTPUT_EXT));
+      parser.inputs.emplace_back(std::move(input));
+    }
+  }
+
+  return true;
+}
+
 static auto verify_args(MainArgParser& parser) -> bool {
   auto stream = OStream::from_stdout();
   if (parser.show_help) {
@@ -83,6 +227,10 @@ static auto verify_args(MainArgParser& parser) -> bool {
     return false;
   }
 
+  if (!discover_inputs(parser)) {
+    return false;
+  }
+
   if (parser.inputs.empty()) {
     outs() 
       << Con::RedFG 
@@ -114,11 +262,33 @@ static auto verify_args(MainArgParser& parser) -> bool {
     return false;
   }
 
+  if (parser.opt_level < 0 || parser.opt_level > 2) {
+    outs()
+      << Con::RedFG
+      << "Error:"
+      << Con::Reset
+      << " Invalid optimization level "
+      << parser.opt_level
+      << ", expected 0, 1 or 2."
+      << "\n";
+    return false;
+  }
+
   auto& context = Context::the();
   if (parser.dump_ast)  context.flags_ |= Context::DumpAST;
   if (parser.dump_ents) context.flags_ |= Context::DumpEnts;
   if (parser.dump_ir)   context.flags_ |= Context::DumpIR;
   if (parser.verbose)   context.flags_ |= Context::Verbose;
+  if (parser.emit_interface) context.flags_ |= Context::EmitIntf;
+  if (parser.opt_remarks)    context.flags_ |= Context::OptRmrks;
+  if (parser.time_passes)    context.flags_ |= Context::TimePass;
+  if (parser.decls_only)     context.flags_ |= Context::DeclOnly;
+  if (parser.no_pin)         context.flags_ |= Context::NoPin;
+  context.opt_level_ = parser.opt_level;
+  context.schedule_stats_ = std::move(parser.schedule_stats);
+
+  FastExit::get().enabled_ = parser.fast_exit;
+  FastExit::get().verbose_ = parser.verbose;
 
   Context::the().inputs_ = std::move(parser.inputs);
   Context::the().outputs_ = std::move(parser.outputs);
@@ -176,11 +346,13 @@ int main() {
 
   if (!begin_global_compilation_cycles()) {
     errs() << "Build failed.\n";
-    return EXIT_FAILURE;
+    report_stats(parser);
+    return finish(EXIT_FAILURE);
   }
 
   outs() << "Build complete.\n";
-  return EXIT_SUCCESS;
+  report_stats(parser);
+  return finish(EXIT_SUCCESS);
 }
 
 #else /// POSIX
@@ -209,11 +381,13 @@ int main(int argc, char** argv){
 
   if (!begin_global_compilation_cycles()) {
     errs() << "Build failed.\n";
-    return EXIT_FAILURE;
+    report_stats(parser);
+    return finish(EXIT_FAILURE);
   }
 
   outs() << "Build complete.\n";
-  return EXIT_SUCCESS;
+  report_stats(parser);
+  return finish(EXIT_SUCCESS);
 }
 
 #endif
@@ -0,0 +1,276 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Sys/DirWalk.hpp>
+#include <Sys/Error.hpp>
+#include <Core/ClassTraits.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+#if defined(N19_LINUX)
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#endif
+
+BEGIN_NAMESPACE(n19::sys);
+
+auto glob_match(const StringView pattern, const StringView name) -> bool {
+  size_t p = 0, n = 0;
+  size_t star = StringView::npos, resume = 0;
+
+  while(n < name.size()) {
+    if(p < pattern.size() && (pattern[p] == _nchr('?') || pattern[p] == name[n])) {
+      ++p, ++n;
+    } else if(p < pattern.size() && pattern[p] == _nchr('*')) {
+      star   = p++;
+      resume = n;
+    } else if(star != StringView::npos) {
+      p = star + 1;         /// Let the last '*' swallow one more character.
+      n = ++resume;
+    } else {
+      return false;
+    }
+  }
+
+  while(p < pattern.size() && pattern[p] == _nchr('*')) ++p;
+  return p == pattern.size();
+}
+
+auto derive_output_path(
+  const String& input,
+  const String& in_root,
+  const String& out_root,
+  const StringView extension ) -> String
+{
+  namespace fs = std::filesystem;
+  auto relative = fs::path(input).lexically_relative(in_root);
+  if(relative.empty() || *relative.begin() == "..") {
+    relative = fs::path(input).filename();
+  }
+
+  auto output = fs::path(out_root.empty() ? in_root : out_root) / relative;
+  output.replace_extension(fs::path(String(extension)));
+  return output.native();
+}
+
+static auto matches_any(const std::vector<String>& globs, const StringView name) -> bool {
+  return std::ranges::any_of(globs, [&](const String& glob) {
+    return glob_match(glob, name);
+  });
+}
+
+#if defined(N19_LINUX)
+namespace {
+/// glibc only gained a getdents64() wrapper in 2.30,
+/// so this goes through syscall() with its own record.
+struct Dirent64_ {
+  uint64_t d_ino;
+  int64_t  d_off;
+  unsigned short d_reclen;
+  unsigned char  d_type;
+  char d_name[];
+};
+
+class DirFd_ {
+  N19_MAKE_NONCOPYABLE(DirFd_);
+  N19_MAKE_NONMOVABLE(DirFd_);
+public:
+  explicit DirFd_(const int fd) : fd_(fd) {}
+ ~DirFd_() { ::close(fd_); }
+  const int fd_;
+};
+
+///
+/// A directory waiting to be read. It's opened by its full path
+/// once a worker gets to it, so each worker only ever has one
+/// directory open however wide or deep the tree is.
+struct PendingDir_ {
+  String path_;
+  bool root_ = false;     /// The root itself may be a link.
+};
+
+class Walker_ {
+public:
+  auto run(size_t threads) -> Result<std::vector<String>>;
+  Walker_(const String& root, const std::vector<String>& globs) : globs_(globs) {
+    queue_.push_back(PendingDir_{root, true});
+  }
+private:
+  auto work_() -> void;
+  auto scan_(PendingDir_& dir, std::vector<String>& found) -> Result<void>;
+
+  const std::vector<String>& globs_;
+  std::mutex lock_;
+  std::condition_variable ready_;
+  std::deque<PendingDir_> queue_;
+  std::vector<String> found_;
+  size_t busy_ = 0;
+  bool failed_ = false;
+  Error error_;
+};
+
+auto Walker_::run(const size_t threads) -> Result<std::vector<String>> {
+  std::vector<std::thread> helpers;
+  helpers.reserve(threads - 1);
+  for(size_t i = 1; i < threads; i++) {
+    helpers.emplace_back([this] { work_(); });
+  }
+
+  work_();
+  for(auto& helper : helpers) helper.join();
+  if(failed_) return std::move(error_);
+
+  /// Workers finish in any order: sort everything found
+  /// below the root together, by its full path.
+  std::ranges::sort(found_);
+  return std::move(found_);
+}
+
+auto Walker_::work_() -> void {
+  std::vector<String> found;
+  while(true) {
+    PendingDir_ dir;
+    {
+      std::unique_lock lock(lock_);
+      ready_.wait(lock, [this] { return failed_ || !queue_.empty() || busy_ == 0; });
+      if(failed_ || queue_.empty()) break;   /// Failed, or nothing left anywhere.
+      dir = std::move(queue_.front());
+      queue_.pop_front();
+      ++busy_;
+    }
+
+    auto result = scan_(dir, found);
+    std::scoped_lock lock(lock_);
+    --busy_;
+    if(!result.has_value() && !failed_) {
+      failed_ = true;
+      error_  = result.error();
+    }
+
+    if(failed_ || (busy_ == 0 && queue_.empty())) {
+      ready_.notify_all();
+    }
+  }
+
+  std::scoped_lock lock(lock_);
+  found_.insert(found_.end(),
+    std::make_move_iterator(found.begin()),
+    std::make_move_iterator(found.end()));
+}
+
+auto Walker_::scan_(PendingDir_& dir, std::vector<String>& found) -> Result<void> {
+  constexpr int flags = O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+  const int fd = ::open(dir.path_.c_str(), dir.root_ ? flags & ~O_NOFOLLOW : flags);
+  if(fd == -1) {
+    return Error{ErrC::Native, dir.path_ + ": " + last_error()};
+  }
+
+  const DirFd_ closer{fd};
+
+  const bool slash = !dir.path_.empty() && dir.path_.back() == '/';
+  std::vector<PendingDir_> children;
+  alignas(Dirent64_) char buffer[32 * 1024];
+
+  while(true) {
+    const long count = ::syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+    if(count == -1 && errno == EINTR) continue;
+    if(count == -1) return Error{ErrC::Native, dir.path_ + ": " + last_error()};
+    if(count == 0)  break;
+
+    for(long offset = 0; offset < count;) {
+      const auto* entry = reinterpret_cast<const Dirent64_*>(buffer + offset);
+      offset += entry->d_reclen;
+
+      const StringView name = entry->d_name;
+      if(name == "." || name == "..") continue;
+
+      /// Some file systems don't fill in d_type. Links are
+      /// looked through, but only to find regular files.
+      unsigned char type = entry->d_type;
+      if(type == DT_UNKNOWN || type == DT_LNK) {
+        struct ::stat info{};
+        const int at = type == DT_LNK ? 0 : AT_SYMLINK_NOFOLLOW;
+        if(::fstatat(fd, entry->d_name, &info, at) == -1) continue;
+        if(S_ISREG(info.st_mode))      type = DT_REG;
+        else if(type == DT_UNKNOWN && S_ISDIR(info.st_mode)) type = DT_DIR;
+      }
+
+      String path = dir.path_;
+      if(!slash) path += '/';
+      path += name;
+
+      if(type == DT_DIR) {
+        children.push_back(PendingDir_{std::move(path)});
+      } else if(type == DT_REG && matches_any(globs_, name)) {
+        found.push_back(std::move(path));
+      }
+    }
+  }
+
+  if(!children.empty()) {
+    {
+      std::scoped_lock lock(lock_);
+      for(auto& child : children) queue_.push_back(std::move(child));
+    }
+
+    children.size() > 1 ? ready_.notify_all() : ready_.notify_one();
+  }
+
+  return Result<void>::create();
+}
+} // namespace
+
+auto walk_directory(
+  const String& root,
+  const std::vector<String>& globs,
+  const size_t max_threads ) -> Result<std::vector<String>>
+{
+  const size_t threads = max_threads == 0
+    ? std::max<size_t>(1, std::thread::hardware_concurrency())
+    : max_threads;
+
+  Walker_ walker(root, globs);
+  return walker.run(threads);
+}
+
+#else
+
+auto walk_directory(
+  const String& root,
+  const std::vector<String>& globs,
+  [[maybe_unused]] const size_t max_threads ) -> Result<std::vector<String>>
+{
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  std::vector<String> found;
+
+  fs::recursive_directory_iterator it(root, ec), end;
+  for(; !ec && it != end; it.increment(ec)) {
+    const auto& entry = *it;
+    if(!entry.is_regular_file(ec)) {
+      ec.clear();
+      continue;
+    }
+
+    if(matches_any(globs, entry.path().filename().native())) {
+      found.push_back(entry.path().native());
+    }
+  }
+
+  if(ec) return Error::from_error_code(static_cast<ErrorCode>(ec.value()));
+  std::ranges::sort(found);
+  return found;
+}
+
+#endif
+
+END_NAMESPACE(n19::sys);
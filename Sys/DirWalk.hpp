@@ -0,0 +1,47 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_SYS_DIRWALK_HPP
+#define N19_SYS_DIRWALK_HPP
+#include <Sys/String.hpp>
+#include <Core/Result.hpp>
+#include <Core/Platform.hpp>
+#include <vector>
+BEGIN_NAMESPACE(n19::sys);
+
+///
+/// Finds every regular file below root whose name matches at
+/// least one of the globs (see glob_match()), and returns their
+/// paths sorted, so the result doesn't depend on the directory
+/// order the file system happens to use or on thread timing.
+///
+/// On Linux the tree is read with getdents64(), spread over up to
+/// max_threads workers, each holding one directory open at a time.
+/// Symbolic links to directories are never followed, which keeps
+/// a cycle from walking forever.
+NODISCARD_ auto walk_directory(
+  const String& root,
+  const std::vector<String>& globs,
+  size_t max_threads = 0          /// 0: one per hardware thread.
+) -> Result<std::vector<String>>;
+
+///
+/// Shell-style matching of a file name: '*' is any run of
+/// characters, '?' any one character, everything else only
+/// matches itself. Separators have no special meaning.
+NODISCARD_ auto glob_match(StringView pattern, StringView name) -> bool;
+
+///
+/// The output path for an input found under in_root: the same
+/// relative path below out_root, with its extension replaced.
+NODISCARD_ auto derive_output_path(
+  const String& input,
+  const String& in_root,
+  const String& out_root,
+  StringView extension
+) -> String;
+
+END_NAMESPACE(n19::sys);
+#endif //N19_SYS_DIRWALK_HPP
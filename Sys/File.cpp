@@ -6,6 +6,8 @@
 #include <Sys/File.hpp>
 #include <Sys/Error.hpp>
 #include <Core/Try.hpp>
+#include <Core/Defer.hpp>
+#include <Core/Scheduler.hpp>
 #include <utility>
 
 namespace stdfs = std::filesystem;
@@ -238,3 +240,24 @@ NODISCARD_ auto File::path() const -> stdfs::path {
 
 END_NAMESPACE(n19::sys);
 #endif //N19_POSIX
+
+BEGIN_NAMESPACE(n19::sys);
+
+NODISCARD_ auto File::read_all(const String& name) -> Result<std::vector<char8_t>> {
+  auto file = TRY(File::open(name, false, Read));
+  DEFER({ file.close(); });
+
+  std::vector<char8_t> bytes(TRY(file.size()));
+  auto writable = as_writable_bytes(bytes);
+  TRY(file.read_into(writable));
+  return bytes;
+}
+
+NODISCARD_ auto File::read_all_async(String name) -> Task<Result<std::vector<char8_t>>> {
+  co_await Scheduler::io().schedule();
+  auto bytes = read_all(name);
+  co_await Scheduler::the().schedule();
+  co_return std::move(bytes);
+}
+
+END_NAMESPACE(n19::sys);
@@ -6,8 +6,10 @@
 #ifndef N19_SYS_FILE_HPP
 #define N19_SYS_FILE_HPP
 #include <Sys/IODevice.hpp>
+#include <Core/Task.hpp>
 #include <cstdint>
 #include <filesystem>
+#include <vector>
 BEGIN_NAMESPACE(n19::sys);
 
 #if defined(N19_WIN32)
@@ -46,6 +48,11 @@ public:
     const uint8_t perms = Read | Write
   ) -> Result<File>;
 
+  /// Reads the whole file. The async version does the read on
+  /// Scheduler::io() and continues on Scheduler::the() after.
+  NODISCARD_ static auto read_all(const String& name) -> Result<std::vector<char8_t>>;
+  NODISCARD_ static auto read_all_async(String name) -> Task<Result<std::vector<char8_t>>>;
+
   sys::String name_;
 };
 
@@ -28,12 +28,23 @@ auto IODevice::read_into(WritableBytes& bytes) -> Result<void> {
   return Result<void>::create();
 }
 
-auto IODevice::create_pipe() -> Result<std::array<IODevice, 2>> {
+auto IODevice::create_pipe(const bool cloexec) -> Result<std::array<IODevice, 2>> {
   int pipefds[ 2 ] = { 0 };
   std::array<IODevice, 2> arr = { };
+#if defined(N19_DARWIN)
+  /// No pipe2(): a fork on another thread can still
+  /// inherit these before the flag is set.
   if(::pipe(pipefds) == -1) {
     return Error(ErrC::Native, last_error());
+  } if(cloexec) {
+    ::fcntl(pipefds[ 0 ], F_SETFD, FD_CLOEXEC);
+    ::fcntl(pipefds[ 1 ], F_SETFD, FD_CLOEXEC);
   }
+#else
+  if(::pipe2(pipefds, cloexec ? O_CLOEXEC : 0) == -1) {
+    return Error(ErrC::Native, last_error());
+  }
+#endif
 
   arr[ 0 ].value_ = pipefds[ 0 ];
   arr[ 1 ].value_ = pipefds[ 1 ];
@@ -43,6 +54,20 @@ auto IODevice::create_pipe() -> Result<std::array<IODevice, 2>> {
   return Result<decltype(arr)>{ std::move(arr) };
 }
 
+auto IODevice::set_nonblocking(const bool nonblocking) -> Result<void> {
+  const int flags = ::fcntl(value_, F_GETFL);
+  if(flags == -1) {
+    return Error(ErrC::Native, last_error());
+  }
+
+  const int updated = nonblocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+  if(updated != flags && ::fcntl(value_, F_SETFL, updated) == -1) {
+    return Error(ErrC::Native, last_error());
+  }
+
+  return Result<void>::create();
+}
+
 auto IODevice::from_stderr() -> IODevice {
   IODevice device;
   device.value_ = STDERR_FILENO;
@@ -96,11 +121,11 @@ auto IODevice::read_into(WritableBytes& bytes) -> Result<void> {
   return Result<void>::create();
 }
 
-auto IODevice::create_pipe() -> Result<std::array<IODevice, 2>> {
+auto IODevice::create_pipe(const bool cloexec) -> Result<std::array<IODevice, 2>> {
   SECURITY_ATTRIBUTES sa  = { 0 };
   sa.nLength              = sizeof(sa);
   sa.lpSecurityDescriptor = nullptr;
-  sa.bInheritHandle       = TRUE;
+  sa.bInheritHandle       = cloexec ? FALSE : TRUE;
 
   std::array<IODevice, 2> arr{};
   if(!CreatePipe(&arr[0].value_, &arr[1].value_, &sa, 0)) {
@@ -112,6 +137,15 @@ auto IODevice::create_pipe() -> Result<std::array<IODevice, 2>> {
   return Result<decltype(arr)>{ std::move(arr) };
 }
 
+auto IODevice::set_nonblocking(const bool nonblocking) -> Result<void> {
+  DWORD mode = nonblocking ? PIPE_NOWAIT : PIPE_WAIT;
+  if(!::SetNamedPipeHandleState(value_, &mode, nullptr, nullptr)) {
+    return Error(ErrC::Native, last_error());
+  }
+
+  return Result<void>::create();
+}
+
 auto IODevice::from_stderr() -> IODevice {
   IODevice device;
   device.value_ = ::GetStdHandle(STD_ERROR_HANDLE);
@@ -47,6 +47,7 @@ public:
   auto write(const Bytes& bytes) -> Result<void>;
   auto read_into(WritableBytes& bytes) -> Result<void>;
   auto flush_handle() const -> void;
+  auto set_nonblocking(bool) -> Result<void>;
 
   template<typename T> auto operator<<(const T&) -> IODevice&;
   template<typename T> auto operator>>(T& val)   -> IODevice&;
@@ -54,7 +55,10 @@ public:
   static auto from_stdout() -> IODevice;
   static auto from_stderr() -> IODevice;
   static auto from_stdin()  -> IODevice;
-  static auto create_pipe() -> Result<std::array<IODevice, 2>>;
+
+  /// With cloexec, neither end is inherited by child processes.
+  /// On Linux both are created that way atomically (pipe2).
+  static auto create_pipe(bool cloexec = false) -> Result<std::array<IODevice, 2>>;
 
   IODevice() = default;
  ~IODevice() override = default;
@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Sys/MappedFile.hpp>
+#include <Sys/Error.hpp>
+#include <Core/Try.hpp>
+#include <utility>
+
+#if defined(N19_POSIX)
+#include <sys/mman.h>
+#endif
+
+BEGIN_NAMESPACE(n19::sys);
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+  if(&other == this) return *this;
+  close();
+
+  name_  = std::move(other.name_);
+  data_  = std::exchange(other.data_, nullptr);
+  size_  = std::exchange(other.size_, 0);
+#if defined(N19_WIN32)
+  mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+  return *this;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+#if defined(N19_POSIX)
+
+auto MappedFile::open(const String& name) -> Result<MappedFile> {
+  auto file = TRY(File::open(name, false, File::Read));
+  auto size = file.size();
+  if(!size.has_value()) {
+    file.close();
+    return size.release_error();
+  }
+
+  MappedFile the_mapping;
+  the_mapping.name_ = name;
+  the_mapping.size_ = *size;
+
+  if(the_mapping.size_ == 0) {  /// mmap() rejects zero length mappings,
+    file.close();               /// an empty file is just an empty view.
+    return the_mapping;
+  }
+
+  void* addr = ::mmap(nullptr, the_mapping.size_, PROT_READ, MAP_PRIVATE, file.value(), 0);
+  file.close();                 /// The mapping outlives the descriptor.
+  if(addr == MAP_FAILED) {
+    return Error::from_native();
+  }
+
+  the_mapping.data_ = static_cast<const Byte*>(addr);
+  return the_mapping;
+}
+
+auto MappedFile::close() -> void {
+  if(data_ != nullptr) {
+    ::munmap(const_cast<Byte*>(data_), size_);
+  }
+
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#else // IF WINDOWS
+
+auto MappedFile::open(const String& name) -> Result<MappedFile> {
+  auto file = TRY(File::open(name, false, File::Read));
+  auto size = file.size();
+  if(!size.has_value()) {
+    file.close();
+    return size.release_error();
+  }
+
+  MappedFile the_mapping;
+  the_mapping.name_ = name;
+  the_mapping.size_ = *size;
+
+  if(the_mapping.size_ == 0) {
+    file.close();
+    return the_mapping;
+  }
+
+  the_mapping.mapping_ = ::CreateFileMappingW(
+    file.value(), nullptr,
+    PAGE_READONLY, 0, 0,
+    nullptr
+  );
+
+  file.close();
+  if(the_mapping.mapping_ == nullptr) {
+    return Error::from_native();
+  }
+
+  void* addr = ::MapViewOfFile(the_mapping.mapping_, FILE_MAP_READ, 0, 0, 0);
+  if(addr == nullptr) {
+    return Error::from_native();
+  }
+
+  the_mapping.data_ = static_cast<const Byte*>(addr);
+  return the_mapping;
+}
+
+auto MappedFile::close() -> void {
+  if(data_ != nullptr) {
+    ::UnmapViewOfFile(data_);
+  } if(mapping_ != nullptr) {
+    ::CloseHandle(mapping_);
+  }
+
+  data_    = nullptr;
+  mapping_ = nullptr;
+  size_    = 0;
+}
+
+#endif //IF defined(N19_POSIX)
+END_NAMESPACE(n19::sys);
@@ -0,0 +1,61 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_SYS_MAPPEDFILE_HPP
+#define N19_SYS_MAPPEDFILE_HPP
+#include <Sys/File.hpp>
+#include <Sys/String.hpp>
+#include <Core/Bytes.hpp>
+#include <Core/Result.hpp>
+#include <Core/ClassTraits.hpp>
+#include <cstdint>
+BEGIN_NAMESPACE(n19::sys);
+
+///
+/// A read-only view of a file's contents, mapped into memory.
+/// Pages are only faulted in when they're touched, so mapping a
+/// large file that's only partially read is cheap.
+class MappedFile final {
+  N19_MAKE_NONCOPYABLE(MappedFile);
+public:
+  NODISCARD_ static auto open(const String& name) -> Result<MappedFile>;
+  NODISCARD_ auto bytes() const -> Bytes;
+  NODISCARD_ auto size()  const -> size_t;
+  NODISCARD_ auto data()  const -> const Byte*;
+  NODISCARD_ auto empty() const -> bool;
+  auto close() -> void;
+
+  auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile() = default;
+ ~MappedFile();
+
+  String name_;
+private:
+  const Byte* data_ = nullptr;
+  size_t size_      = 0;
+#if defined(N19_WIN32)
+  ::HANDLE mapping_ = nullptr;
+#endif
+};
+
+FORCEINLINE_ auto MappedFile::bytes() const -> Bytes {
+  return Bytes{data_, size_};
+}
+
+FORCEINLINE_ auto MappedFile::size() const -> size_t {
+  return size_;
+}
+
+FORCEINLINE_ auto MappedFile::data() const -> const Byte* {
+  return data_;
+}
+
+FORCEINLINE_ auto MappedFile::empty() const -> bool {
+  return size_ == 0;
+}
+
+END_NAMESPACE(n19::sys);
+#endif //N19_SYS_MAPPEDFILE_HPP
@@ -0,0 +1,480 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Sys/Process.hpp>
+#include <Sys/Error.hpp>
+#include <Core/Defer.hpp>
+#include <Core/Try.hpp>
+#include <algorithm>
+#include <string_view>
+#include <utility>
+#include <array>
+
+#if defined(N19_POSIX)
+#include <spawn.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#else
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
+
+#if defined(N19_DARWIN)
+#include <crt_externs.h>
+#define environ (*::_NSGetEnviron())
+#elif defined(N19_POSIX)
+extern char** environ;
+#endif
+
+BEGIN_NAMESPACE(n19::sys);
+
+static constexpr size_t pipe_chunk_ = 64 * 1024;
+
+auto Process::operator=(Process&& other) noexcept -> Process& {
+  if(&other == this) return *this;
+  release_();
+
+  stdin_  = other.stdin_;
+  stdout_ = other.stdout_;
+  stderr_ = other.stderr_;
+  other.stdin_.invalidate();
+  other.stdout_.invalidate();
+  other.stderr_.invalidate();
+#if defined(N19_POSIX)
+  pid_ = std::exchange(other.pid_, -1);
+#else
+  process_ = std::exchange(other.process_, nullptr);
+#endif
+  return *this;
+}
+
+Process::Process(Process&& other) noexcept : Process() {
+  *this = std::move(other);
+}
+
+Process::Process() {
+  stdin_.invalidate();   /// A default IODevice would
+  stdout_.invalidate();  /// refer to descriptor 0.
+  stderr_.invalidate();
+}
+
+Process::~Process() {
+  release_();
+}
+
+auto Process::release_() -> void {
+  for(IODevice* device : {&stdin_, &stdout_, &stderr_}) {
+    if(!device->is_invalid()) device->close();
+  }
+
+  /// With its pipes gone the child can't block on
+  /// us anymore, reap it so it doesn't linger.
+  if(running()) (void)wait();
+}
+
+#if defined(N19_POSIX)
+
+static auto close_pipes_(std::span<std::array<IODevice, 2>> pipes) -> void {
+  for(auto& pipe : pipes) {
+    for(auto& end : pipe) {
+      if(!end.is_invalid()) end.close();
+    }
+  }
+}
+
+auto Process::spawn(const std::vector<String>& argv) -> Result<Process> {
+  ERROR_IF(argv.empty(), ErrC::InvalidArg, "No program to run.");
+
+  /// Every end is close-on-exec: the child only gets the
+  /// three it's handed below, renumbered to 0, 1 and 2.
+  std::array<std::array<IODevice, 2>, 3> pipes{};
+  for(auto& pipe : pipes) {
+    pipe[0].invalidate();
+    pipe[1].invalidate();
+  }
+
+  for(auto& pipe : pipes) {
+    auto made = IODevice::create_pipe(true);
+    if(!made.has_value()) {
+      close_pipes_(pipes);
+      return made.release_error();
+    }
+
+    pipe = made.release_value();
+  }
+
+  ::posix_spawn_file_actions_t actions;
+  ::posix_spawn_file_actions_init(&actions);
+  ::posix_spawn_file_actions_adddup2(&actions, pipes[0][0].value(), STDIN_FILENO);
+  ::posix_spawn_file_actions_adddup2(&actions, pipes[1][1].value(), STDOUT_FILENO);
+  ::posix_spawn_file_actions_adddup2(&actions, pipes[2][1].value(), STDERR_FILENO);
+
+  std::vector<char*> args;
+  args.reserve(argv.size() + 1);
+  for(const auto& arg : argv) {
+    args.push_back(const_cast<char*>(arg.c_str()));
+  }
+
+  args.push_back(nullptr);
+  ::pid_t pid = -1;
+  const int rc = ::posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), environ);
+  ::posix_spawn_file_actions_destroy(&actions);
+
+  pipes[0][0].close();
+  pipes[1][1].close();
+  pipes[2][1].close();
+  if(rc != 0) {
+    close_pipes_(pipes);
+    return Error::from_error_code(rc);
+  }
+
+  Process proc;
+  proc.pid_    = pid;
+  proc.stdin_  = pipes[0][1];
+  proc.stdout_ = pipes[1][0];
+  proc.stderr_ = pipes[2][0];
+
+  TRY(proc.stdin_.set_nonblocking(true));
+  TRY(proc.stdout_.set_nonblocking(true));
+  TRY(proc.stderr_.set_nonblocking(true));
+  return proc;
+}
+
+auto Process::wait() -> Result<int> {
+  ERROR_IF(!running(), ErrC::InvalidArg, "The process has already been waited for.");
+
+  int status = 0;
+  while(::waitpid(pid_, &status, 0) == -1) {
+    if(errno != EINTR) return Error::from_native();
+  }
+
+  pid_ = -1;
+  if(WIFEXITED(status))   return WEXITSTATUS(status);
+  if(WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+  return -1;
+}
+
+auto Process::kill() -> void {
+  if(running()) ::kill(pid_, SIGKILL);
+}
+
+auto Process::running() const -> bool {
+  return pid_ != -1;
+}
+
+auto Process::run_all(const std::span<const Spec> specs, const size_t max_jobs) -> std::vector<Result<Output>> {
+  std::vector<Result<Output>> results(specs.size(), Result<Output>(Error{ErrC::Internal, "Never ran."}));
+
+  ///
+  /// A child that exits before reading all of its input would
+  /// kill us with SIGPIPE. Block it on this thread for the
+  /// duration, and eat the one that might be left pending.
+  ::sigset_t pipe_set, old_set;
+  ::sigemptyset(&pipe_set);
+  ::sigaddset(&pipe_set, SIGPIPE);
+  ::pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+
+  DEFER({
+    ::sigset_t pending;
+    ::sigpending(&pending);
+    if(::sigismember(&pending, SIGPIPE) && !::sigismember(&old_set, SIGPIPE)) {
+      int sig = 0;
+      ::sigwait(&pipe_set, &sig);
+    }
+    ::pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+  });
+
+  struct Running_ {
+    size_t index_ = 0;
+    Process proc_;
+    Output output_;
+    size_t written_ = 0;
+  };
+
+  enum Stream_ : uint8_t { In, Out, Err };
+  struct Owner_ {
+    size_t job_;
+    Stream_ stream_;
+  };
+
+  const size_t slots = std::max<size_t>(max_jobs, 1);
+  size_t next = 0;
+  std::vector<Running_> running;
+  std::vector<::pollfd> fds;
+  std::vector<Owner_> owners;
+  std::vector<char> buffer(pipe_chunk_);
+
+  while(next < specs.size() || !running.empty()) {
+    /// Fill any free job slots.
+    while(running.size() < slots && next < specs.size()) {
+      const size_t index = next++;
+      auto proc = spawn(specs[index].argv_);
+      if(!proc.has_value()) {
+        results[index] = proc.release_error();
+        continue;
+      }
+
+      auto& job  = running.emplace_back();
+      job.index_ = index;
+      job.proc_  = proc.release_value();
+      if(specs[index].input_.empty()) {
+        job.proc_.stdin_.close();
+      }
+    }
+
+    fds.clear();
+    owners.clear();
+    for(size_t i = 0; i < running.size(); i++) {
+      auto& proc = running[i].proc_;
+      if(!proc.stdin_.is_invalid()) {
+        fds.push_back({proc.stdin_.value(), POLLOUT, 0});
+        owners.push_back({i, In});
+      } if(!proc.stdout_.is_invalid()) {
+        fds.push_back({proc.stdout_.value(), POLLIN, 0});
+        owners.push_back({i, Out});
+      } if(!proc.stderr_.is_invalid()) {
+        fds.push_back({proc.stderr_.value(), POLLIN, 0});
+        owners.push_back({i, Err});
+      }
+    }
+
+    if(!fds.empty() && ::poll(fds.data(), fds.size(), -1) == -1) {
+      if(errno == EINTR) continue;
+      const auto error = Error::from_native();
+      for(auto& job : running) {
+        job.proc_.kill();
+        results[job.index_] = error;
+      }
+
+      running.clear();
+      continue;
+    }
+
+    for(size_t i = 0; i < fds.size(); i++) {
+      if(fds[i].revents == 0) continue;
+      auto& job = running[owners[i].job_];
+
+      if(owners[i].stream_ == In) {
+        const std::string_view rest = std::string_view(specs[job.index_].input_).substr(job.written_);
+        const auto count = ::write(fds[i].fd, rest.data(), std::min(rest.size(), pipe_chunk_));
+        if(count > 0) job.written_ += static_cast<size_t>(count);
+
+        /// EPIPE: the child doesn't want the rest.
+        const bool failed = count == -1 && errno != EAGAIN && errno != EINTR;
+        if(failed || job.written_ == specs[job.index_].input_.size()) {
+          job.proc_.stdin_.close();
+        }
+        continue;
+      }
+
+      auto& device = owners[i].stream_ == Out ? job.proc_.stdout_ : job.proc_.stderr_;
+      auto& sink   = owners[i].stream_ == Out ? job.output_.out_ : job.output_.err_;
+      const auto count = ::read(fds[i].fd, buffer.data(), buffer.size());
+      if(count > 0) {
+        sink.append(buffer.data(), static_cast<size_t>(count));
+      } else if(count == 0 || (errno != EAGAIN && errno != EINTR)) {
+        device.close();
+      }
+    }
+
+    /// A child with all of its pipes closed has
+    /// finished, or is about to: reap it.
+    std::erase_if(running, [&](Running_& job) {
+      auto& proc = job.proc_;
+      if(!proc.stdin_.is_invalid() || !proc.stdout_.is_invalid() || !proc.stderr_.is_invalid()) {
+        return false;
+      }
+
+      auto status = proc.wait();
+      if(status.has_value()) {
+        job.output_.status_ = status.value();
+        results[job.index_] = std::move(job.output_);
+      } else {
+        results[job.index_] = status.release_error();
+      }
+
+      return true;
+    });
+  }
+
+  return results;
+}
+
+#else // IF WINDOWS
+
+static auto quote_arg_(const String& arg, String& out) -> void {
+  const bool needs_quotes = arg.empty() || arg.find_first_of(L" \t\n\v\"") != String::npos;
+  if(!needs_quotes) {
+    out += arg;
+    return;
+  }
+
+  /// Backslashes are only special in front of a quote,
+  /// where they have to be doubled up.
+  out += L'"';
+  size_t slashes = 0;
+  for(const wchar_t ch : arg) {
+    if(ch == L'\\') {
+      ++slashes;
+      continue;
+    }
+
+    out.append(ch == L'"' ? slashes * 2 + 1 : slashes, L'\\');
+    out += ch;
+    slashes = 0;
+  }
+
+  out.append(slashes * 2, L'\\');
+  out += L'"';
+}
+
+static auto drain_(IODevice& device, std::string& sink) -> void {
+  char buffer[pipe_chunk_];
+  DWORD count = 0;
+  while(::ReadFile(device.value(), buffer, sizeof(buffer), &count, nullptr) && count != 0) {
+    sink.append(buffer, count);
+  }
+}
+
+auto Process::spawn(const std::vector<String>& argv) -> Result<Process> {
+  ERROR_IF(argv.empty(), ErrC::InvalidArg, "No program to run.");
+
+  String command_line;
+  for(const auto& arg : argv) {
+    if(!command_line.empty()) command_line += L' ';
+    quote_arg_(arg, command_line);
+  }
+
+  /// The pipes are created inheritable, and CreateProcessW hands
+  /// every inheritable handle to the child. Serialize spawning so
+  /// a child never picks up the pipes meant for another one.
+  static std::mutex spawn_lock;
+  std::scoped_lock guard(spawn_lock);
+
+  auto in  = TRY(IODevice::create_pipe());
+  auto out = TRY(IODevice::create_pipe());
+  auto err = TRY(IODevice::create_pipe());
+  ::SetHandleInformation(in[1].value(),  HANDLE_FLAG_INHERIT, 0);
+  ::SetHandleInformation(out[0].value(), HANDLE_FLAG_INHERIT, 0);
+  ::SetHandleInformation(err[0].value(), HANDLE_FLAG_INHERIT, 0);
+
+  ::STARTUPINFOW startup{};
+  startup.cb         = sizeof(startup);
+  startup.dwFlags    = STARTF_USESTDHANDLES;
+  startup.hStdInput  = in[0].value();
+  startup.hStdOutput = out[1].value();
+  startup.hStdError  = err[1].value();
+
+  ::PROCESS_INFORMATION info{};
+  const BOOL created = ::CreateProcessW(
+    nullptr,              /// Search for argv[0] like a shell.
+    command_line.data(),  /// Must be writable.
+    nullptr, nullptr,     /// Default security attributes.
+    TRUE,                 /// Inherit the child ends.
+    CREATE_NO_WINDOW,
+    nullptr, nullptr,     /// Our environment and directory.
+    &startup,
+    &info
+  );
+
+  in[0].close();
+  out[1].close();
+  err[1].close();
+  if(!created) {
+    const auto error = Error::from_native();
+    in[1].close();
+    out[0].close();
+    err[0].close();
+    return error;
+  }
+
+  ::CloseHandle(info.hThread);
+  Process proc;
+  proc.process_ = info.hProcess;
+  proc.stdin_   = in[1];
+  proc.stdout_  = out[0];
+  proc.stderr_  = err[0];
+  return proc;
+}
+
+auto Process::wait() -> Result<int> {
+  ERROR_IF(!running(), ErrC::InvalidArg, "The process has already been waited for.");
+
+  DWORD code = 0;
+  ::WaitForSingleObject(process_, INFINITE);
+  const BOOL got = ::GetExitCodeProcess(process_, &code);
+  ::CloseHandle(process_);
+  process_ = nullptr;
+
+  if(!got) return Error::from_native();
+  return static_cast<int>(code);
+}
+
+auto Process::kill() -> void {
+  if(running()) ::TerminateProcess(process_, 1);
+}
+
+auto Process::running() const -> bool {
+  return process_ != nullptr;
+}
+
+///
+/// Anonymous pipes can't be waited on together here, so each
+/// job slot gets a thread that feeds its child's stdin while two
+/// more drain stdout and stderr.
+auto Process::run_all(const std::span<const Spec> specs, const size_t max_jobs) -> std::vector<Result<Output>> {
+  std::vector<Result<Output>> results(specs.size(), Result<Output>(Error{ErrC::Internal, "Never ran."}));
+  std::atomic<size_t> next{0};
+
+  auto slot = [&] {
+    for(size_t index = next++; index < specs.size(); index = next++) {
+      auto proc = spawn(specs[index].argv_);
+      if(!proc.has_value()) {
+        results[index] = proc.release_error();
+        continue;
+      }
+
+      Output output;
+      std::thread out_drain([&] { drain_(proc->stdout_, output.out_); });
+      std::thread err_drain([&] { drain_(proc->stderr_, output.err_); });
+
+      if(!specs[index].input_.empty()) {
+        (void)proc->stdin_.write(as_bytes(specs[index].input_));
+      }
+
+      proc->stdin_.close();
+      out_drain.join();
+      err_drain.join();
+      proc->stdout_.close();
+      proc->stderr_.close();
+
+      auto status = proc->wait();
+      if(status.has_value()) {
+        output.status_ = status.value();
+        results[index] = std::move(output);
+      } else {
+        results[index] = status.release_error();
+      }
+    }
+  };
+
+  const size_t slots = std::clamp<size_t>(max_jobs, 1, std::max<size_t>(specs.size(), 1));
+  std::vector<std::thread> workers;
+  for(size_t i = 1; i < slots; i++) {
+    workers.emplace_back(slot);
+  }
+
+  slot();
+  for(auto& worker : workers) {
+    worker.join();
+  }
+
+  return results;
+}
+
+#endif //IF defined(N19_POSIX)
+END_NAMESPACE(n19::sys);
@@ -0,0 +1,84 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_SYS_PROCESS_HPP
+#define N19_SYS_PROCESS_HPP
+#include <Sys/IODevice.hpp>
+#include <Sys/String.hpp>
+#include <Core/Result.hpp>
+#include <Core/ClassTraits.hpp>
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+#if defined(N19_POSIX)
+#include <sys/types.h>
+#endif
+
+BEGIN_NAMESPACE(n19::sys);
+
+///
+/// A child process, with its stdin, stdout and stderr connected
+/// to pipes owned by the parent. The parent ends are non-blocking,
+/// so the caller has to wait for them to become ready (run_all()
+/// does this for any number of children at once).
+class Process final {
+  N19_MAKE_NONCOPYABLE(Process);
+public:
+  /// What to run: argv_[0] is looked up in PATH
+  /// if it isn't a path already. input_ is written
+  /// to the child's stdin, which is then closed.
+  struct Spec {
+    std::vector<String> argv_;
+    std::string input_;
+  };
+
+  /// What a finished child left behind. status_ is the exit
+  /// code, or 128 plus the signal number if it was killed.
+  struct Output {
+    int status_ = -1;
+    std::string out_;
+    std::string err_;
+  };
+
+  NODISCARD_ static auto spawn(const std::vector<String>& argv) -> Result<Process>;
+
+  /// Runs every spec to completion, at most max_jobs at a time,
+  /// draining all of their pipes as they go so that no child ever
+  /// blocks on a full one. Results are in the same order as specs.
+  NODISCARD_ static auto run_all(std::span<const Spec> specs, size_t max_jobs) -> std::vector<Result<Output>>;
+  NODISCARD_ static auto run(const Spec& spec) -> Result<Output>;
+
+  /// Blocks until the child exits, returns its status.
+  /// The pipes aren't touched: close or drain them first.
+  auto wait() -> Result<int>;
+  auto kill() -> void;
+  NODISCARD_ auto running() const -> bool;
+
+  auto operator=(Process&& other) noexcept -> Process&;
+  Process(Process&& other) noexcept;
+  Process();
+ ~Process();
+
+  IODevice stdin_;   /// Write end of the child's stdin.
+  IODevice stdout_;  /// Read end of the child's stdout.
+  IODevice stderr_;  /// Read end of the child's stderr.
+private:
+  auto release_() -> void;
+#if defined(N19_POSIX)
+  ::pid_t pid_ = -1;
+#else
+  ::HANDLE process_ = nullptr;
+#endif
+};
+
+FORCEINLINE_ auto Process::run(const Spec& spec) -> Result<Output> {
+  auto results = run_all(std::span(&spec, 1), 1);
+  return std::move(results.front());
+}
+
+END_NAMESPACE(n19::sys);
+#endif //N19_SYS_PROCESS_HPP
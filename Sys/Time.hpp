@@ -9,6 +9,7 @@
 #include <Core/Result.hpp>
 #include <Core/ClassTraits.hpp>
 #include <string>
+#include <chrono>
 
 #ifdef N19_WIN32
 #ifndef NOMINMAX
@@ -59,5 +60,34 @@ public:
   SystemTime() = default;
 };
 
+///
+/// Monotonic stopwatch, used wherever we need to time something
+/// (test cases, compiler phases...). Never goes backwards, unlike
+/// SystemTime which follows the wall clock.
+class Stopwatch {
+N19_MAKE_DEFAULT_ASSIGNABLE(Stopwatch);
+N19_MAKE_DEFAULT_CONSTRUCTIBLE(Stopwatch);
+public:
+  using Clock_    = std::chrono::steady_clock;
+  using Duration_ = std::chrono::nanoseconds;
+
+  FORCEINLINE_ auto reset() -> void {
+    begin_ = Clock_::now();
+  }
+
+  NODISCARD_ FORCEINLINE_ auto elapsed() const -> Duration_ {
+    return std::chrono::duration_cast<Duration_>(Clock_::now() - begin_);
+  }
+
+  NODISCARD_ FORCEINLINE_ auto elapsed_ms() const -> double {
+    return std::chrono::duration<double, std::milli>(elapsed()).count();
+  }
+
+ ~Stopwatch() = default;
+  Stopwatch() : begin_(Clock_::now()) {}
+private:
+  Clock_::time_point begin_;
+};
+
 END_NAMESPACE(n19::sys);
 #endif //SYS_TIME_HPP
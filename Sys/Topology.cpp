@@ -0,0 +1,214 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <Sys/Topology.hpp>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <map>
+
+#if defined(N19_LINUX)
+#include <pthread.h>
+#endif
+
+BEGIN_NAMESPACE(n19::sys);
+
+auto CpuTopology::the() -> const CpuTopology& {
+  static const CpuTopology topology = discover();
+  return topology;
+}
+
+auto CpuTopology::num_nodes() const -> size_t {
+  uint32_t highest = 0;
+  for(const auto& cpu : cpus_) {
+    highest = std::max(highest, cpu.node_);
+  }
+
+  return cpus_.empty() ? 0 : highest + 1;
+}
+
+auto CpuTopology::pinning(const size_t workers) const -> std::vector<uint32_t> {
+  if(workers < 2 || num_nodes() < 2) return {};
+  return placement();
+}
+
+auto CpuTopology::placement() const -> std::vector<uint32_t> {
+  ///
+  /// SMT rank: 0 for the first CPU seen on a physical
+  /// core, 1 for its sibling, and so on.
+  std::map<std::pair<uint32_t, uint32_t>, uint32_t> seen;
+  std::vector<std::pair<const Cpu*, uint32_t>> ranked;
+  ranked.reserve(cpus_.size());
+  for(const auto& cpu : cpus_) {
+    ranked.emplace_back(&cpu, seen[{cpu.package_, cpu.core_}]++);
+  }
+
+  const auto here  = current_cpu();
+  const auto nodes = std::max<size_t>(num_nodes(), 1);
+  uint32_t first_node = 0;
+  for(const auto& cpu : cpus_) {
+    if(here.has_value() && cpu.id_ == *here) first_node = cpu.node_;
+  }
+
+  std::ranges::stable_sort(ranked, [&](const auto& lhs, const auto& rhs) {
+    const auto lnode = (lhs.first->node_ + nodes - first_node) % nodes;
+    const auto rnode = (rhs.first->node_ + nodes - first_node) % nodes;
+    if(lnode != rnode) return lnode < rnode;
+    if(lhs.second != rhs.second) return lhs.second < rhs.second;
+    return lhs.first->id_ < rhs.first->id_;
+  });
+
+  /// Start at the caller's own CPU, rotating only among its peers
+  /// (same node, same SMT rank), so that separate processes in a
+  /// parallel build don't all stack up on the same few cores.
+  const auto start = std::ranges::find_if(ranked, [&](const auto& entry) {
+    return here.has_value() && entry.first->id_ == *here;
+  });
+
+  if(start != ranked.end()) {
+    const auto peer = [&](const auto& entry) {
+      return entry.first->node_ == start->first->node_ && entry.second == start->second;
+    };
+
+    const auto block_begin = std::ranges::find_if(ranked, peer);
+    const auto block_end   = std::find_if_not(start, ranked.end(), peer);
+    std::rotate(block_begin, start, block_end);
+  }
+
+  std::vector<uint32_t> order;
+  order.reserve(ranked.size());
+  for(const auto& [cpu, rank] : ranked) {
+    order.push_back(cpu->id_);
+  }
+
+  return order;
+}
+
+static auto fallback_topology_() -> CpuTopology {
+  CpuTopology topology;
+  const auto count = std::max<uint32_t>(1, std::thread::hardware_concurrency());
+  for(uint32_t id = 0; id < count; id++) {
+    topology.cpus_.push_back({id, id, 0, 0});
+  }
+
+  return topology;
+}
+
+#if defined(N19_LINUX)
+
+static auto read_id_(const std::filesystem::path& path) -> Maybe<uint32_t> {
+  std::ifstream in(path);
+  uint32_t value = 0;
+  if(!(in >> value)) return Nothing;
+  return value;
+}
+
+auto CpuTopology::discover() -> CpuTopology {
+  ::cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if(::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return fallback_topology_();
+  }
+
+  const std::filesystem::path root = "/sys/devices/system/cpu";
+  CpuTopology topology;
+  for(uint32_t id = 0; id < CPU_SETSIZE; id++) {
+    if(!CPU_ISSET(id, &allowed)) continue;
+
+    const auto dir = root / ("cpu" + std::to_string(id));
+    Cpu cpu{id, id, 0, 0};
+    cpu.core_    = read_id_(dir / "topology" / "core_id").value_or(uint32_t{id});
+    cpu.package_ = read_id_(dir / "topology" / "physical_package_id").value_or(0u);
+
+    /// The node shows up as a "nodeN" link in the CPU's directory.
+    std::error_code ec;
+    for(const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+      const auto name = entry.path().filename().string();
+      if(name.starts_with("node") && name.size() > 4 && std::isdigit(name[4])) {
+        cpu.node_ = static_cast<uint32_t>(std::stoul(name.substr(4)));
+        break;
+      }
+    }
+
+    topology.cpus_.push_back(cpu);
+  }
+
+  return topology.cpus_.empty() ? fallback_topology_() : topology;
+}
+
+AffinityScope::AffinityScope(const uint32_t cpu) {
+  if(cpu == none || cpu >= CPU_SETSIZE) return;
+  if(::pthread_getaffinity_np(::pthread_self(), sizeof(previous_), &previous_) != 0) return;
+
+  ::cpu_set_t target;
+  CPU_ZERO(&target);
+  CPU_SET(cpu, &target);
+  pinned_ = ::pthread_setaffinity_np(::pthread_self(), sizeof(target), &target) == 0;
+}
+
+AffinityScope::~AffinityScope() {
+  if(pinned_) ::pthread_setaffinity_np(::pthread_self(), sizeof(previous_), &previous_);
+}
+
+auto current_cpu() -> Maybe<uint32_t> {
+  const int cpu = ::sched_getcpu();
+  if(cpu < 0) return Nothing;
+  return static_cast<uint32_t>(cpu);
+}
+
+#elif defined(N19_WIN32)
+
+auto CpuTopology::discover() -> CpuTopology {
+  ::DWORD_PTR process_mask = 0, system_mask = 0;
+  if(!::GetProcessAffinityMask(::GetCurrentProcess(), &process_mask, &system_mask)) {
+    return fallback_topology_();
+  }
+
+  CpuTopology topology;
+  for(uint32_t id = 0; id < sizeof(process_mask) * 8; id++) {
+    if(!(process_mask & (::DWORD_PTR{1} << id))) continue;
+
+    ::USHORT node = 0;
+    ::PROCESSOR_NUMBER number{};
+    number.Number = static_cast<::BYTE>(id);
+    ::GetNumaProcessorNodeEx(&number, &node);
+    topology.cpus_.push_back({id, id, 0, node == 0xFFFF ? 0u : node});
+  }
+
+  return topology.cpus_.empty() ? fallback_topology_() : topology;
+}
+
+AffinityScope::AffinityScope(const uint32_t cpu) {
+  if(cpu == none || cpu >= sizeof(::DWORD_PTR) * 8) return;
+  previous_ = ::SetThreadAffinityMask(::GetCurrentThread(), ::DWORD_PTR{1} << cpu);
+  pinned_   = previous_ != 0;
+}
+
+AffinityScope::~AffinityScope() {
+  if(pinned_) ::SetThreadAffinityMask(::GetCurrentThread(), previous_);
+}
+
+auto current_cpu() -> Maybe<uint32_t> {
+  return static_cast<uint32_t>(::GetCurrentProcessorNumber());
+}
+
+#else // Darwin: no affinity control, no NUMA.
+
+auto CpuTopology::discover() -> CpuTopology {
+  return fallback_topology_();
+}
+
+AffinityScope::AffinityScope(const uint32_t) {}
+AffinityScope::~AffinityScope() = default;
+
+auto current_cpu() -> Maybe<uint32_t> {
+  return Nothing;
+}
+
+#endif
+END_NAMESPACE(n19::sys);
@@ -0,0 +1,95 @@
+/*
+* Copyright (c) 2025 Diago Lima
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef N19_SYS_TOPOLOGY_HPP
+#define N19_SYS_TOPOLOGY_HPP
+#include <Core/ClassTraits.hpp>
+#include <Core/Platform.hpp>
+#include <Core/Maybe.hpp>
+#include <vector>
+#include <cstdint>
+
+#if defined(N19_LINUX)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <sched.h>
+#elif defined(N19_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+BEGIN_NAMESPACE(n19::sys);
+
+///
+/// The CPUs this process is allowed to run on, and where they
+/// sit: which NUMA node, which package, which physical core.
+/// CPUs outside of our affinity mask (a cpuset, taskset, a
+/// container's limits) are left out entirely.
+class CpuTopology {
+public:
+  struct Cpu {
+    uint32_t id_      = 0;
+    uint32_t core_    = 0;  /// Physical core, unique per package.
+    uint32_t package_ = 0;
+    uint32_t node_    = 0;  /// NUMA node.
+  };
+
+  /// Discovery never fails: anything that can't be read
+  /// is assumed to be one node, one package, no SMT.
+  NODISCARD_ static auto discover() -> CpuTopology;
+  NODISCARD_ static auto the() -> const CpuTopology&;
+
+  ///
+  /// The order worker threads should be placed in. Workers of one
+  /// pool share most of what they touch, so the order is compact:
+  /// every physical core of a node, then their SMT siblings, and
+  /// only then the next node. It starts on the node the caller runs
+  /// on, which is where the memory it already touched lives.
+  NODISCARD_ auto placement() const -> std::vector<uint32_t>;
+
+  ///
+  /// The CPUs a pool of workers should be pinned to, in
+  /// placement() order. Empty, meaning leave them alone, unless
+  /// there are several workers and several NUMA nodes: on one
+  /// node pinning only takes freedom away from the scheduler.
+  NODISCARD_ auto pinning(size_t workers) const -> std::vector<uint32_t>;
+  NODISCARD_ auto num_nodes() const -> size_t;
+  NODISCARD_ auto size() const -> size_t { return cpus_.size(); }
+
+  std::vector<Cpu> cpus_;
+};
+
+///
+/// Pins the calling thread to one CPU for as long as it lives,
+/// then puts back whatever affinity the thread had before. Under
+/// the usual first-touch policy, pages a pinned worker faults in
+/// itself come from its own node, so per-worker state is best
+/// allocated after the scope is opened. Memory malloc recycles
+/// may already live elsewhere; nothing here migrates it.
+class AffinityScope {
+  N19_MAKE_NONCOPYABLE(AffinityScope);
+  N19_MAKE_NONMOVABLE(AffinityScope);
+public:
+  static constexpr uint32_t none = UINT32_MAX;  /// Leaves the thread alone.
+
+  explicit AffinityScope(uint32_t cpu);
+ ~AffinityScope();
+private:
+  bool pinned_ = false;
+#if defined(N19_LINUX)
+  ::cpu_set_t previous_{};
+#elif defined(N19_WIN32)
+  ::DWORD_PTR previous_ = 0;
+#endif
+};
+
+/// The CPU the calling thread is running on right now.
+NODISCARD_ auto current_cpu() -> Maybe<uint32_t>;
+
+END_NAMESPACE(n19::sys);
+#endif //N19_SYS_TOPOLOGY_HPP